@@ -0,0 +1,38 @@
+/* _PDCLIB_addstreamstats( struct _PDCLIB_streamstats_t *, const struct _PDCLIB_streamstats_t * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#include <stdio.h>
+
+#ifndef REGTEST
+
+#ifdef _PDCLIB_STREAMSTATS
+
+void _PDCLIB_addstreamstats( struct _PDCLIB_streamstats_t * total, const struct _PDCLIB_streamstats_t * stats )
+{
+    total->bytes_read += stats->bytes_read;
+    total->bytes_written += stats->bytes_written;
+    total->fills += stats->fills;
+    total->flushes += stats->flushes;
+    total->seeks += stats->seeks;
+    total->contentions += stats->contentions;
+    total->syscall_ns += stats->syscall_ns;
+}
+
+#endif
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+    /* Testing covered by _PDCLIB_streamstats.c */
+    return TEST_RESULTS;
+}
+
+#endif
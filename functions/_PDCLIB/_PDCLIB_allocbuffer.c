@@ -0,0 +1,126 @@
+/* _PDCLIB_allocbuffer( struct _PDCLIB_file_t * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_glue.h"
+
+/* dlmalloc's memalign() (see functions/_dlmalloc/malloc.c), which is made
+   the public aligned_alloc() for C11, and internal to the library otherwise.
+*/
+#if __STDC_VERSION__ >= 201112L
+#define _PDCLIB_memalign aligned_alloc
+#else
+#define _PDCLIB_memalign dlmemalign
+#endif
+
+_PDCLIB_LOCAL void * _PDCLIB_memalign( size_t alignment, size_t size );
+
+int _PDCLIB_allocbuffer( struct _PDCLIB_file_t * stream )
+{
+    if ( ! ( stream->status & ( _IOFBF | _IOLBF | _IONBF ) ) )
+    {
+        /* Standard streams are not opened by fopen(), so this is the first
+           opportunity to determine their buffer mode.
+        */
+        stream->status |= _PDCLIB_isinteractive( stream->handle ) ? _IOLBF : _IOFBF;
+    }
+
+    if ( stream->buffer != NULL )
+    {
+        /* Already allocated, or provided by the user. */
+        return 0;
+    }
+
+    if ( stream->status & _PDCLIB_FMMAP )
+    {
+        if ( _PDCLIB_mapfile( stream ) == 0 )
+        {
+            /* The mapping is not to be free()d, and makes read-ahead
+               pointless.
+            */
+            stream->status &= ~( _PDCLIB_FREEBUFFER | _PDCLIB_FAHEAD );
+            return 0;
+        }
+
+        /* File cannot be mapped, fall back to regular buffering. */
+        stream->status &= ~_PDCLIB_FMMAP;
+    }
+
+    if ( stream->bufsize == 0 )
+    {
+        /* No size requested by setvbuf(), ask the system. */
+        stream->bufsize = _PDCLIB_bufsize( stream->handle );
+    }
+
+    if ( stream->status & _PDCLIB_FDIRECT )
+    {
+        /* Direct I/O requires buffer memory and size to be aligned. */
+        stream->bufsize = ( stream->bufsize + _PDCLIB_DIRECT_ALIGN - 1 ) & ~( _PDCLIB_size_t )( _PDCLIB_DIRECT_ALIGN - 1 );
+        stream->buffer = (char *)_PDCLIB_memalign( _PDCLIB_DIRECT_ALIGN, stream->bufsize );
+    }
+    else
+    {
+        stream->buffer = (char *)malloc( stream->bufsize );
+    }
+
+    if ( stream->buffer == NULL )
+    {
+        /* No memory */
+        *_PDCLIB_errno_func() = _PDCLIB_ENOMEM;
+        stream->status |= _PDCLIB_ERRORFLAG;
+        return EOF;
+    }
+
+    /* This buffer must be free()d on fclose() */
+    stream->status |= _PDCLIB_FREEBUFFER;
+    return 0;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+#ifndef REGTEST
+    FILE * fh;
+    char buffer[ 4 ];
+    /* Regular file: no buffer until first write, then a large one */
+    TESTCASE( ( fh = fopen( testfile, "wb+" ) ) != NULL );
+    TESTCASE( fh->buffer == NULL );
+    TESTCASE( fh->bufsize == 0 );
+    TESTCASE( fputc( 'x', fh ) == 'x' );
+    TESTCASE( fh->buffer != NULL );
+    TESTCASE( fh->bufsize >= _PDCLIB_FILE_BUFSIZ );
+    TESTCASE( fclose( fh ) == 0 );
+    /* Same on first read */
+    TESTCASE( ( fh = fopen( testfile, "rb" ) ) != NULL );
+    TESTCASE( fh->buffer == NULL );
+    TESTCASE( fgetc( fh ) == 'x' );
+    TESTCASE( fh->buffer != NULL );
+    TESTCASE( fh->bufsize >= _PDCLIB_FILE_BUFSIZ );
+    TESTCASE( fclose( fh ) == 0 );
+    /* Size requested by setvbuf() before first I/O is honored */
+    TESTCASE( ( fh = fopen( testfile, "rb" ) ) != NULL );
+    TESTCASE( setvbuf( fh, NULL, _IOFBF, 300 ) == 0 );
+    TESTCASE( fh->buffer == NULL );
+    TESTCASE( fh->bufsize == 300 );
+    TESTCASE( fread( buffer, 1, 1, fh ) == 1 );
+    TESTCASE( fh->buffer != NULL );
+    TESTCASE( fh->bufsize == 300 );
+    TESTCASE( fclose( fh ) == 0 );
+    TESTCASE( remove( testfile ) == 0 );
+#endif
+    return TEST_RESULTS;
+}
+
+#endif
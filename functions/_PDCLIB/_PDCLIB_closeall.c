@@ -5,6 +5,7 @@
 */
 
 #include <stdio.h>
+#include <stdlib.h>
 
 #ifndef REGTEST
 
@@ -12,12 +13,43 @@ extern struct _PDCLIB_file_t * _PDCLIB_filelist;
 
 void _PDCLIB_closeall( void )
 {
-    struct _PDCLIB_file_t * stream = _PDCLIB_filelist;
-    struct _PDCLIB_file_t * next;
+    struct _PDCLIB_file_t ** streams;
+    struct _PDCLIB_file_t * stream;
+    size_t count;
+    size_t i;
+
+#ifdef _PDCLIB_STREAMSTATS
+    if ( getenv( "PDCLIB_STREAMSTATS" ) != NULL )
+    {
+        /* Flushing first, so the statistics are complete */
+        fflush( NULL );
+        _PDCLIB_dumpstreamstats( stderr );
+    }
+#endif
+
+    if ( ( streams = _PDCLIB_refstreams( &count ) ) != NULL )
+    {
+        /* Streams closed by other threads meanwhile are skipped; fclose()
+           does not free streams while they are referenced.
+        */
+        for ( i = 0; i < count; ++i )
+        {
+            if ( _PDCLIB_isstream( streams[ i ] ) )
+            {
+                fclose( streams[ i ] );
+            }
+        }
+
+        _PDCLIB_unrefstreams( streams, count );
+        return;
+    }
+
+    /* Out of memory */
+    stream = _PDCLIB_filelist;
 
     while ( stream != NULL )
     {
-        next = stream->next;
+        struct _PDCLIB_file_t * next = stream->next;
         fclose( stream );
         stream = next;
     }
@@ -0,0 +1,143 @@
+/* _PDCLIB_compileformat( const char * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_print.h"
+
+struct _PDCLIB_format_t * _PDCLIB_compileformat( const char * format )
+{
+    struct _PDCLIB_printop_t op;
+    struct _PDCLIB_format_t * compiled;
+    struct _PDCLIB_printop_t * next;
+    char * text;
+    const char * p;
+    const char * rc;
+    size_t count = 0;
+    size_t length = 0;
+    int literal = 0;
+
+    /* First pass: Validating conversion specifiers, and counting the ops and
+       characters of literal text ("%%" being a literal '%').
+    */
+    for ( p = format; *p != '\0'; p = rc )
+    {
+        if ( ( *p == '%' ) && ( p[1] != '%' ) )
+        {
+            if ( ( rc = _PDCLIB_print_parse( p, &op ) ) == p )
+            {
+                /* No conversion specifier. Bad conversion. */
+                *_PDCLIB_errno_func() = _PDCLIB_EINVAL;
+                return NULL;
+            }
+
+            ++count;
+            literal = 0;
+        }
+        else
+        {
+            rc = p + ( ( *p == '%' ) ? 2 : 1 );
+            ++length;
+
+            if ( ! literal )
+            {
+                ++count;
+                literal = 1;
+            }
+        }
+    }
+
+    /* Ops and literal text go into the same allocation as the structure. */
+    if ( ( compiled = (struct _PDCLIB_format_t *)malloc( sizeof( struct _PDCLIB_format_t ) + count * sizeof( struct _PDCLIB_printop_t ) + length ) ) == NULL )
+    {
+        *_PDCLIB_errno_func() = _PDCLIB_ENOMEM;
+        return NULL;
+    }
+
+    compiled->count = count;
+    compiled->ops = (struct _PDCLIB_printop_t *)( compiled + 1 );
+    next = compiled->ops;
+    text = (char *)( compiled->ops + count );
+
+    /* Second pass: Filling in the ops, merging runs of literal text. */
+    for ( p = format; *p != '\0'; p = rc )
+    {
+        if ( ( *p == '%' ) && ( p[1] != '%' ) )
+        {
+            rc = _PDCLIB_print_parse( p, next++ );
+        }
+        else
+        {
+            if ( next == compiled->ops || next[-1].text == NULL )
+            {
+                next->text = text;
+                next->length = 0;
+                next->base = 0;
+                next->flags = 0;
+                next->width = 0;
+                next->prec = EOF;
+                next->conversion = '\0';
+                ++next;
+            }
+
+            rc = p + ( ( *p == '%' ) ? 2 : 1 );
+            *( text++ ) = *p;
+            ++next[-1].length;
+        }
+    }
+
+    return compiled;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+#include <errno.h>
+
+int main( void )
+{
+#ifndef REGTEST
+    struct _PDCLIB_format_t * format;
+
+    TESTCASE( ( format = _PDCLIB_compileformat( "" ) ) != NULL );
+    TESTCASE( format->count == 0 );
+    _PDCLIB_freeformat( format );
+
+    /* Literal text runs, "%%" included, are merged */
+    TESTCASE( ( format = _PDCLIB_compileformat( "100%% sure: %-5d of %s%%%%\n" ) ) != NULL );
+    TESTCASE( format->count == 5 );
+    TESTCASE( format->ops[0].length == 11 && memcmp( format->ops[0].text, "100% sure: ", 11 ) == 0 );
+    TESTCASE( format->ops[1].text == NULL && format->ops[1].conversion == 'd' && format->ops[1].width == 5 );
+    TESTCASE( format->ops[2].length == 4 && memcmp( format->ops[2].text, " of ", 4 ) == 0 );
+    TESTCASE( format->ops[3].text == NULL && format->ops[3].conversion == 's' );
+    TESTCASE( format->ops[4].length == 3 && memcmp( format->ops[4].text, "%%\n", 3 ) == 0 );
+    _PDCLIB_freeformat( format );
+
+    TESTCASE( ( format = _PDCLIB_compileformat( "%d%*.*f" ) ) != NULL );
+    TESTCASE( format->count == 2 );
+    _PDCLIB_freeformat( format );
+
+    /* Invalid conversion specifiers */
+    errno = 0;
+    TESTCASE( _PDCLIB_compileformat( "%y" ) == NULL );
+    TESTCASE( errno == EINVAL );
+    errno = 0;
+    TESTCASE( _PDCLIB_compileformat( "abc %" ) == NULL );
+    TESTCASE( errno == EINVAL );
+    errno = 0;
+    TESTCASE( _PDCLIB_compileformat( "%d %5%" ) == NULL );
+    TESTCASE( errno == EINVAL );
+#endif
+    return TEST_RESULTS;
+}
+
+#endif
@@ -0,0 +1,42 @@
+/* _PDCLIB_cookieclose( struct _PDCLIB_file_t * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_internal.h"
+
+int _PDCLIB_cookieclose( struct _PDCLIB_file_t * stream )
+{
+    struct _PDCLIB_cookie_t * cookie = stream->cookie;
+    int rc = 0;
+
+    if ( cookie->io.close != NULL && cookie->io.close( cookie->cookie ) != 0 )
+    {
+        /* errno set by close function */
+        rc = EOF;
+    }
+
+    free( cookie );
+    stream->cookie = NULL;
+    return rc;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+    /* Testing covered by fopencookie.c */
+    return TEST_RESULTS;
+}
+
+#endif
@@ -0,0 +1,55 @@
+/* _PDCLIB_cookieread( struct _PDCLIB_file_t *, char *, size_t )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#include <stdio.h>
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_internal.h"
+
+_PDCLIB_size_t _PDCLIB_cookieread( struct _PDCLIB_file_t * stream, char * buffer, _PDCLIB_size_t size )
+{
+    struct _PDCLIB_cookie_t * cookie = stream->cookie;
+    _PDCLIB_ptrdiff_t rc = 0;
+
+    /* Without read function, reading gives end-of-file. */
+    if ( cookie->io.read != NULL )
+    {
+        rc = cookie->io.read( cookie->cookie, buffer, size );
+    }
+
+    if ( rc > 0 )
+    {
+        /* Reading successful. */
+        stream->pos.offset += rc;
+        return ( _PDCLIB_size_t )rc;
+    }
+
+    if ( rc < 0 )
+    {
+        /* errno set by read function */
+        stream->status |= _PDCLIB_ERRORFLAG;
+        return 0;
+    }
+
+    /* End-of-File */
+    stream->status |= _PDCLIB_EOFFLAG;
+    return 0;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+    /* Testing covered by fopencookie.c */
+    return TEST_RESULTS;
+}
+
+#endif
@@ -0,0 +1,49 @@
+/* _PDCLIB_cookieseek( struct _PDCLIB_file_t *, int_least64_t, int )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#include <stdio.h>
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_internal.h"
+
+_PDCLIB_int_least64_t _PDCLIB_cookieseek( struct _PDCLIB_file_t * stream, _PDCLIB_int_least64_t offset, int whence )
+{
+    struct _PDCLIB_cookie_t * cookie = stream->cookie;
+
+    if ( cookie->io.seek == NULL )
+    {
+        /* Without seek function, the stream cannot be repositioned. */
+        *_PDCLIB_errno_func() = _PDCLIB_ESPIPE;
+        return EOF;
+    }
+
+    if ( cookie->io.seek( cookie->cookie, &offset, whence ) != 0 )
+    {
+        /* errno set by seek function */
+        return EOF;
+    }
+
+    stream->ungetidx = 0;
+    stream->bufidx = 0;
+    stream->bufend = 0;
+    stream->pos.offset = offset;
+    return offset;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+    /* Testing covered by fopencookie.c */
+    return TEST_RESULTS;
+}
+
+#endif
@@ -0,0 +1,56 @@
+/* _PDCLIB_cookiewrite( struct _PDCLIB_file_t *, const char *, size_t )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#include <stdio.h>
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_internal.h"
+
+_PDCLIB_size_t _PDCLIB_cookiewrite( struct _PDCLIB_file_t * stream, const char * buffer, _PDCLIB_size_t size )
+{
+    struct _PDCLIB_cookie_t * cookie = stream->cookie;
+    _PDCLIB_size_t written = 0;
+
+    if ( cookie->io.write == NULL )
+    {
+        /* Without write function, output is discarded. */
+        stream->pos.offset += size;
+        return size;
+    }
+
+    /* Keep writing until everything is written, or an error occurs. */
+    while ( written < size )
+    {
+        _PDCLIB_ptrdiff_t rc = cookie->io.write( cookie->cookie, buffer + written, size - written );
+
+        if ( rc <= 0 )
+        {
+            /* errno set by write function */
+            stream->status |= _PDCLIB_ERRORFLAG;
+            break;
+        }
+
+        written += ( _PDCLIB_size_t )rc;
+        stream->pos.offset += rc;
+    }
+
+    return written;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+    /* Testing covered by fopencookie.c */
+    return TEST_RESULTS;
+}
+
+#endif
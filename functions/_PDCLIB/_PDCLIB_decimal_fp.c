@@ -0,0 +1,136 @@
+/* _PDCLIB_decimal_fp( _PDCLIB_decimal_t *, int, int, unsigned char const *, size_t, long )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_internal.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Divides the limbs by 2^n (n at most 9); the value must be a multiple
+   of 2^n.
+*/
+static void shr( _PDCLIB_decimal_t * decimal, unsigned n )
+{
+    _PDCLIB_uint_least64_t rem = 0;
+    size_t i = decimal->size;
+
+    while ( i-- > 0 )
+    {
+        rem = rem * _PDCLIB_DECIMAL_LIMB_BASE + decimal->data[ i ];
+        decimal->data[ i ] = ( _PDCLIB_decimal_limb_t )( rem >> n );
+        rem &= ( ( _PDCLIB_uint_least64_t )1 << n ) - 1;
+    }
+
+    while ( decimal->size > 0 && decimal->data[ decimal->size - 1 ] == 0 )
+    {
+        --decimal->size;
+    }
+}
+
+_PDCLIB_decimal_t * _PDCLIB_decimal_fp( _PDCLIB_decimal_t * decimal, int exp, int dec, unsigned char const * mant, size_t mant_dig, long need )
+{
+    unsigned n;
+
+    _PDCLIB_decimal_mant( decimal, dec, mant, mant_dig );
+
+    /* Binary exponent of the mantissa's least significant bit */
+    if ( dec == 0 )
+    {
+        /* Subnormal */
+        ++exp;
+    }
+
+    exp -= ( int )( mant_dig - 1 );
+
+    /* Strip trailing zero bits from the mantissa (as long as the exponent
+       is negative), which keeps N short for values that have only a few
+       fractional bits (e.g. integers).
+       10^9 being a multiple of 2^9, the lowest limb tells about those bits.
+    */
+    while ( exp < 0 && decimal->size > 0 && ( decimal->data[ 0 ] & 1 ) == 0 )
+    {
+        for ( n = 0; n < 9 && ( int )n < -exp && ( decimal->data[ 0 ] & ( 1u << n ) ) == 0; ++n )
+        {
+            /* EMPTY */
+        }
+
+        shr( decimal, n );
+        exp += ( int )n;
+    }
+
+    return _PDCLIB_decimal_scale( decimal, exp, need );
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+#include <string.h>
+
+#ifndef REGTEST
+
+static int check( double value, long scale, char const * digits )
+{
+    unsigned char bytes[ sizeof( double ) ];
+    _PDCLIB_decimal_t decimal;
+    char buffer[ 800 ];
+
+    memcpy( bytes, &value, sizeof( double ) );
+    _PDCLIB_decimal_fp( &decimal,
+                        ( int )_PDCLIB_DBL_EXP( bytes ) - _PDCLIB_DBL_BIAS,
+                        _PDCLIB_DBL_DEC( bytes ),
+                        _PDCLIB_DBL_MANT_START( bytes ),
+                        _PDCLIB_DBL_MANT_DIG,
+                        0 );
+    _PDCLIB_decimal_tostring( &decimal, 0, decimal.digits, buffer );
+    buffer[ decimal.digits ] = '\0';
+    return decimal.scale == scale && strcmp( buffer, digits ) == 0;
+}
+
+#endif
+
+int main( void )
+{
+#ifndef REGTEST
+    TESTCASE( check( 0.0, 0, "" ) );
+    TESTCASE( check( 1.0, 0, "1" ) );
+    TESTCASE( check( 42.0, 0, "42" ) );
+    TESTCASE( check( 0.5, 1, "5" ) );
+    TESTCASE( check( 0.375, 3, "375" ) );
+    TESTCASE( check( 1e22, 0, "10000000000000000000000" ) );
+    TESTCASE( check( 0.1, 55, "1000000000000000055511151231257827021181583404541015625" ) );
+    TESTCASE( check( 4294967296.0 * 4294967296.0, 0, "18446744073709551616" ) );
+    /* Smallest subnormal: 5^1074 has 751 digits */
+    {
+        unsigned char bytes[ sizeof( double ) ] = { 0 };
+        double value;
+        _PDCLIB_decimal_t decimal;
+        char buffer[ 7 ];
+        bytes[ 0 ] = 1;
+        memcpy( &value, bytes, sizeof( double ) );
+        _PDCLIB_decimal_fp( &decimal, -_PDCLIB_DBL_BIAS, 0, _PDCLIB_DBL_MANT_START( bytes ), _PDCLIB_DBL_MANT_DIG, 0 );
+        TESTCASE( decimal.scale == 1074 );
+        TESTCASE( decimal.digits == 751 );
+        TESTCASE( _PDCLIB_decimal_exp( &decimal ) == -324 );
+        TESTCASE( ! decimal.inexact );
+        /* Only the leading digits */
+        _PDCLIB_decimal_fp( &decimal, -_PDCLIB_DBL_BIAS, 0, _PDCLIB_DBL_MANT_START( bytes ), _PDCLIB_DBL_MANT_DIG, 7 );
+        TESTCASE( decimal.inexact );
+        TESTCASE( decimal.size == 4 );
+        TESTCASE( decimal.digits > 7 + _PDCLIB_DECIMAL_GUARD );
+        TESTCASE( _PDCLIB_decimal_exp( &decimal ) == -324 );
+        _PDCLIB_decimal_tostring( &decimal, 0, 7, buffer );
+        TESTCASE( memcmp( buffer, "4940656", 7 ) == 0 );
+    }
+#endif
+    return TEST_RESULTS;
+}
+
+#endif
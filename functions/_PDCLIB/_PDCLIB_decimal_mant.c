@@ -0,0 +1,66 @@
+/* _PDCLIB_decimal_mant( _PDCLIB_decimal_t *, int, unsigned char const *, size_t )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_internal.h"
+
+#include <stddef.h>
+
+_PDCLIB_decimal_t * _PDCLIB_decimal_mant( _PDCLIB_decimal_t * decimal, int dec, unsigned char const * mant, size_t mant_dig )
+{
+    size_t excess_bits = ( mant_dig - 1 ) % _PDCLIB_CHAR_BIT;
+    size_t i;
+
+    decimal->size = 0;
+    decimal->digits = 0;
+    decimal->scale = 0;
+    decimal->inexact = 0;
+
+    /* Handle the most significant byte (which might need masking)... */
+    _PDCLIB_decimal_muladd( decimal, 1, dec );
+    _PDCLIB_decimal_muladd( decimal, 1u << excess_bits, *mant & ( ( 1u << excess_bits ) - 1 ) );
+
+    /* ...then the remaining bytes. */
+    for ( i = 1; i <= ( mant_dig - 1 ) / _PDCLIB_CHAR_BIT; ++i )
+    {
+        _PDCLIB_decimal_muladd( decimal, 1u << _PDCLIB_CHAR_BIT, *( mant _PDCLIB_FLT_OP i ) );
+    }
+
+    return decimal;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+#include <string.h>
+
+int main( void )
+{
+#ifndef REGTEST
+    _PDCLIB_decimal_t decimal;
+    double value = 1.75;
+    unsigned char bytes[ sizeof( double ) ];
+
+    memcpy( bytes, &value, sizeof( double ) );
+    _PDCLIB_decimal_mant( &decimal, _PDCLIB_DBL_DEC( bytes ), _PDCLIB_DBL_MANT_START( bytes ), _PDCLIB_DBL_MANT_DIG );
+    /* 7 * 2^50 = 7881299347898368 */
+    TESTCASE( decimal.size == 2 );
+    TESTCASE( decimal.data[ 0 ] == 347898368u );
+    TESTCASE( decimal.data[ 1 ] == 7881299u );
+
+    value = 0.0;
+    memcpy( bytes, &value, sizeof( double ) );
+    _PDCLIB_decimal_mant( &decimal, _PDCLIB_DBL_DEC( bytes ), _PDCLIB_DBL_MANT_START( bytes ), _PDCLIB_DBL_MANT_DIG );
+    TESTCASE( decimal.size == 0 );
+#endif
+    return TEST_RESULTS;
+}
+
+#endif
@@ -0,0 +1,71 @@
+/* _PDCLIB_decimal_muladd( _PDCLIB_decimal_t *, _PDCLIB_decimal_limb_t, _PDCLIB_decimal_limb_t )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_internal.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+_PDCLIB_decimal_t * _PDCLIB_decimal_muladd( _PDCLIB_decimal_t * decimal, _PDCLIB_decimal_limb_t factor, _PDCLIB_decimal_limb_t addend )
+{
+    /* factor, addend < 2^31 keep this within 64 bit */
+    _PDCLIB_uint_least64_t carry = addend;
+    size_t i;
+
+    for ( i = 0; i < decimal->size; ++i )
+    {
+        carry += ( _PDCLIB_uint_least64_t )decimal->data[ i ] * factor;
+        decimal->data[ i ] = ( _PDCLIB_decimal_limb_t )( carry % _PDCLIB_DECIMAL_LIMB_BASE );
+        carry /= _PDCLIB_DECIMAL_LIMB_BASE;
+    }
+
+    while ( carry > 0 )
+    {
+        /* New limb. */
+        decimal->data[ decimal->size++ ] = ( _PDCLIB_decimal_limb_t )( carry % _PDCLIB_DECIMAL_LIMB_BASE );
+        carry /= _PDCLIB_DECIMAL_LIMB_BASE;
+    }
+
+    return decimal;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+#ifndef REGTEST
+    _PDCLIB_decimal_t decimal;
+
+    decimal.size = 0;
+    _PDCLIB_decimal_muladd( &decimal, 10, 0 );
+    TESTCASE( decimal.size == 0 );
+
+    _PDCLIB_decimal_muladd( &decimal, 10, 7 );
+    TESTCASE( decimal.size == 1 );
+    TESTCASE( decimal.data[ 0 ] == 7 );
+
+    _PDCLIB_decimal_muladd( &decimal, 1000000000u, 999999999u );
+    TESTCASE( decimal.size == 2 );
+    TESTCASE( decimal.data[ 0 ] == 999999999u );
+    TESTCASE( decimal.data[ 1 ] == 7 );
+
+    /* 7999999999 * 1220703125 + 1 = 9765624998779296876 */
+    _PDCLIB_decimal_muladd( &decimal, 1220703125u, 1 );
+    TESTCASE( decimal.size == 3 );
+    TESTCASE( decimal.data[ 0 ] == 779296876u );
+    TESTCASE( decimal.data[ 1 ] == 765624998u );
+    TESTCASE( decimal.data[ 2 ] == 9 );
+#endif
+    return TEST_RESULTS;
+}
+
+#endif
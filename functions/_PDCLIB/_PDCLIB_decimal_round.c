@@ -0,0 +1,282 @@
+/* _PDCLIB_decimal_round( _PDCLIB_decimal_t *, long )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_internal.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+static const _PDCLIB_decimal_limb_t pow10[ _PDCLIB_DECIMAL_LIMB_DIGITS ] =
+{
+    1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u, 100000000u
+};
+
+/* Returns the digit at the given index (0 being the most significant). */
+static int digit_at( _PDCLIB_decimal_t const * decimal, long index )
+{
+    unsigned long pos = ( unsigned long )( decimal->digits - 1 - index );
+
+    return ( int )( ( decimal->data[ pos / _PDCLIB_DECIMAL_LIMB_DIGITS ] / pow10[ pos % _PDCLIB_DECIMAL_LIMB_DIGITS ] ) % 10 );
+}
+
+_PDCLIB_decimal_t * _PDCLIB_decimal_round( _PDCLIB_decimal_t * decimal, long keep )
+{
+    /* Digits to drop, counted from the least significant one */
+    unsigned long drop;
+    /* Limb and position of the rounding digit (the most significant dropped) */
+    size_t limb;
+    unsigned pos;
+    _PDCLIB_decimal_limb_t digit;
+    _PDCLIB_decimal_limb_t top;
+    int up;
+    size_t i;
+
+    if ( decimal->inexact )
+    {
+        /* The true value is somewhat larger than the decimal, affecting only
+           the digits from index reliable onwards.
+        */
+        long reliable = decimal->digits - _PDCLIB_DECIMAL_GUARD;
+        long index;
+        int first;
+
+        if ( keep >= reliable )
+        {
+            return NULL;
+        }
+
+        if ( keep >= 0 )
+        {
+            /* Dropping 4999... might mean just below a tie, or at / above;
+               dropping 5000... might mean a tie, or above.
+            */
+            first = digit_at( decimal, keep );
+
+            if ( first == 4 || first == 5 )
+            {
+                for ( index = keep + 1; index < reliable && digit_at( decimal, index ) == ( ( first == 4 ) ? 9 : 0 ); ++index )
+                {
+                    /* EMPTY */
+                }
+
+                if ( index == reliable )
+                {
+                    return NULL;
+                }
+            }
+        }
+
+        /* The rounded value is exact. */
+        decimal->inexact = 0;
+    }
+
+    if ( keep >= decimal->digits )
+    {
+        /* Nothing to drop. */
+        return decimal;
+    }
+
+    if ( keep < 0 )
+    {
+        /* Less than half a unit of the rounding position. */
+        decimal->size = 0;
+        decimal->digits = 0;
+        decimal->scale = 0;
+        return decimal;
+    }
+
+    drop = ( unsigned long )( decimal->digits - keep );
+    limb = ( drop - 1 ) / _PDCLIB_DECIMAL_LIMB_DIGITS;
+    pos = ( drop - 1 ) % _PDCLIB_DECIMAL_LIMB_DIGITS;
+    digit = ( decimal->data[ limb ] / pow10[ pos ] ) % 10;
+
+    if ( digit != 5 )
+    {
+        up = ( digit > 5 );
+    }
+    else
+    {
+        /* Exactly half a unit, or more? */
+        up = ( decimal->data[ limb ] % pow10[ pos ] ) != 0;
+
+        for ( i = 0; ! up && i < limb; ++i )
+        {
+            up = ( decimal->data[ i ] != 0 );
+        }
+
+        if ( ! up && keep > 0 )
+        {
+            /* Tie, round to even. */
+            limb = drop / _PDCLIB_DECIMAL_LIMB_DIGITS;
+            pos = drop % _PDCLIB_DECIMAL_LIMB_DIGITS;
+            up = ( ( decimal->data[ limb ] / pow10[ pos ] ) % 2 ) != 0;
+        }
+    }
+
+    /* Truncate */
+    limb = drop / _PDCLIB_DECIMAL_LIMB_DIGITS;
+    pos = drop % _PDCLIB_DECIMAL_LIMB_DIGITS;
+
+    for ( i = 0; i < limb && i < decimal->size; ++i )
+    {
+        decimal->data[ i ] = 0;
+    }
+
+    if ( limb < decimal->size )
+    {
+        decimal->data[ limb ] -= decimal->data[ limb ] % pow10[ pos ];
+    }
+
+    if ( up )
+    {
+        /* Add one unit of the last digit kept, propagating the carry. */
+        while ( decimal->size <= limb )
+        {
+            decimal->data[ decimal->size++ ] = 0;
+        }
+
+        decimal->data[ limb ] += pow10[ pos ];
+
+        while ( decimal->data[ limb ] >= _PDCLIB_DECIMAL_LIMB_BASE )
+        {
+            decimal->data[ limb ] -= _PDCLIB_DECIMAL_LIMB_BASE;
+
+            if ( ++limb == decimal->size )
+            {
+                /* New limb. */
+                decimal->data[ decimal->size++ ] = 0;
+            }
+
+            ++decimal->data[ limb ];
+        }
+    }
+
+    while ( decimal->size > 0 && decimal->data[ decimal->size - 1 ] == 0 )
+    {
+        --decimal->size;
+    }
+
+    if ( decimal->size == 0 )
+    {
+        /* Rounded to zero */
+        decimal->digits = 0;
+        decimal->scale = 0;
+        return decimal;
+    }
+
+    decimal->digits = ( long )( decimal->size - 1 ) * _PDCLIB_DECIMAL_LIMB_DIGITS;
+
+    for ( top = decimal->data[ decimal->size - 1 ]; top > 0; top /= 10 )
+    {
+        ++decimal->digits;
+    }
+
+    return decimal;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+#include <string.h>
+
+#ifndef REGTEST
+
+static int check( double value, long keep, long exp, char const * digits )
+{
+    unsigned char bytes[ sizeof( double ) ];
+    _PDCLIB_decimal_t decimal;
+    char buffer[ 800 ];
+
+    memcpy( bytes, &value, sizeof( double ) );
+    _PDCLIB_decimal_fp( &decimal,
+                        ( int )_PDCLIB_DBL_EXP( bytes ) - _PDCLIB_DBL_BIAS,
+                        _PDCLIB_DBL_DEC( bytes ),
+                        _PDCLIB_DBL_MANT_START( bytes ),
+                        _PDCLIB_DBL_MANT_DIG,
+                        0 );
+    _PDCLIB_decimal_round( &decimal, keep );
+    _PDCLIB_decimal_tostring( &decimal, 0, _PDCLIB_decimal_sig( &decimal ), buffer );
+    buffer[ _PDCLIB_decimal_sig( &decimal ) ] = '\0';
+    return _PDCLIB_decimal_exp( &decimal ) == exp && strcmp( buffer, digits ) == 0;
+}
+
+#endif
+
+int main( void )
+{
+#ifndef REGTEST
+    /* Nothing to round */
+    TESTCASE( check( 0.0, 3, 0, "" ) );
+    TESTCASE( check( 0.375, 3, -1, "375" ) );
+    TESTCASE( check( 0.375, 5, -1, "375" ) );
+    /* Round down / up */
+    TESTCASE( check( 0.1, 17, -1, "10000000000000001" ) );
+    TESTCASE( check( 0.1, 16, -1, "1" ) );
+    TESTCASE( check( 2.0 / 3.0, 6, -1, "666667" ) );
+    /* Ties to even, and above ties */
+    TESTCASE( check( 0.375, 2, -1, "38" ) );
+    TESTCASE( check( 0.625, 2, -1, "62" ) );
+    TESTCASE( check( 2.5, 1, 0, "2" ) );
+    TESTCASE( check( 3.5, 1, 0, "4" ) );
+    TESTCASE( check( 2.5000000000000004, 1, 0, "3" ) );
+    /* Carry into a new digit / limb */
+    TESTCASE( check( 9.96, 2, 1, "1" ) );
+    TESTCASE( check( 999999999.5, 9, 9, "1" ) );
+    /* Rounding above the most significant digit */
+    TESTCASE( check( 0.5, 0, 0, "" ) );
+    TESTCASE( check( 0.75, 0, 0, "1" ) );
+    TESTCASE( check( 0.0625, -1, 0, "" ) );
+    TESTCASE( check( 7.0, 0, 1, "1" ) );
+    /* Inexact decimals */
+    {
+        _PDCLIB_decimal_t decimal;
+        char buffer[ 10 ];
+
+        /* 5 000000000 000000000 (last two limbs unreliable) */
+        decimal.size = 3;
+        decimal.data[ 0 ] = 0;
+        decimal.data[ 1 ] = 0;
+        decimal.data[ 2 ] = 5;
+        decimal.digits = 19;
+        decimal.scale = 0;
+        decimal.inexact = 1;
+        TESTCASE( _PDCLIB_decimal_round( &decimal, 1 ) == NULL );
+        TESTCASE( _PDCLIB_decimal_round( &decimal, 0 ) == NULL );
+        TESTCASE( decimal.inexact && decimal.digits == 19 );
+
+        /* 1234 999999999 999999999 */
+        decimal.data[ 0 ] = 999999999;
+        decimal.data[ 1 ] = 999999999;
+        decimal.data[ 2 ] = 1234;
+        decimal.digits = 22;
+        TESTCASE( _PDCLIB_decimal_round( &decimal, 4 ) == NULL );
+        TESTCASE( _PDCLIB_decimal_round( &decimal, 3 ) == NULL );
+        TESTCASE( _PDCLIB_decimal_round( &decimal, 2 ) != NULL );
+        TESTCASE( ! decimal.inexact );
+        _PDCLIB_decimal_tostring( &decimal, 0, 3, buffer );
+        TESTCASE( decimal.digits == 22 && memcmp( buffer, "120", 3 ) == 0 );
+
+        /* 1256 000000000 000000000 */
+        decimal.size = 3;
+        decimal.data[ 0 ] = 0;
+        decimal.data[ 1 ] = 0;
+        decimal.data[ 2 ] = 1256;
+        decimal.digits = 22;
+        decimal.inexact = 1;
+        TESTCASE( _PDCLIB_decimal_round( &decimal, 2 ) != NULL );
+        _PDCLIB_decimal_tostring( &decimal, 0, 2, buffer );
+        TESTCASE( decimal.digits == 22 && memcmp( buffer, "13", 2 ) == 0 );
+    }
+#endif
+    return TEST_RESULTS;
+}
+
+#endif
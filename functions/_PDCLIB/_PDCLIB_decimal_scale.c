@@ -0,0 +1,151 @@
+/* _PDCLIB_decimal_scale( _PDCLIB_decimal_t *, int, long )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_internal.h"
+
+#include <stddef.h>
+#include <string.h>
+
+/* Largest powers of two / five accepted by _PDCLIB_decimal_muladd() */
+#define POW2_STEP 29
+#define POW5_STEP 13
+
+static const _PDCLIB_decimal_limb_t pow5[ POW5_STEP + 1 ] =
+{
+    1u, 5u, 25u, 125u, 625u, 3125u, 15625u, 78125u, 390625u, 1953125u,
+    9765625u, 48828125u, 244140625u, 1220703125u
+};
+
+/* Drops least significant limbs beyond the given count. */
+static void truncate_limbs( _PDCLIB_decimal_t * decimal, size_t limbs )
+{
+    size_t drop;
+
+    if ( decimal->size > limbs )
+    {
+        drop = decimal->size - limbs;
+        memmove( decimal->data, decimal->data + drop, limbs * sizeof( _PDCLIB_decimal_limb_t ) );
+        decimal->size = limbs;
+        decimal->scale -= ( long )drop * _PDCLIB_DECIMAL_LIMB_DIGITS;
+        decimal->inexact = 1;
+    }
+}
+
+_PDCLIB_decimal_t * _PDCLIB_decimal_scale( _PDCLIB_decimal_t * decimal, int exp, long need )
+{
+    _PDCLIB_decimal_limb_t top;
+    /* Limbs to keep while scaling (the full array if exact) */
+    size_t limbs = _PDCLIB_DECIMAL_LIMBS;
+
+    if ( need > 0 && need < ( long )( _PDCLIB_DECIMAL_LIMBS * _PDCLIB_DECIMAL_LIMB_DIGITS ) )
+    {
+        /* Leading digits, plus guard limbs, plus one as the top limb might
+           hold a single digit only.
+        */
+        limbs = ( ( size_t )need + _PDCLIB_DECIMAL_GUARD + _PDCLIB_DECIMAL_LIMB_DIGITS - 1 ) / _PDCLIB_DECIMAL_LIMB_DIGITS + 1;
+    }
+
+    decimal->scale = 0;
+    decimal->inexact = 0;
+
+    if ( decimal->size == 0 )
+    {
+        /* Zero */
+        decimal->digits = 0;
+        return decimal;
+    }
+
+    if ( exp < 0 )
+    {
+        /* N = N * 5^-exp, scale -exp */
+        decimal->scale = -exp;
+
+        for ( ; exp <= -POW5_STEP; exp += POW5_STEP )
+        {
+            _PDCLIB_decimal_muladd( decimal, pow5[ POW5_STEP ], 0 );
+            truncate_limbs( decimal, limbs );
+        }
+
+        _PDCLIB_decimal_muladd( decimal, pow5[ -exp ], 0 );
+    }
+    else
+    {
+        /* N = N * 2^exp, scale 0 */
+        for ( ; exp >= POW2_STEP; exp -= POW2_STEP )
+        {
+            _PDCLIB_decimal_muladd( decimal, 1u << POW2_STEP, 0 );
+            truncate_limbs( decimal, limbs );
+        }
+
+        _PDCLIB_decimal_muladd( decimal, 1u << exp, 0 );
+    }
+
+    truncate_limbs( decimal, limbs );
+
+    /* Number of digits */
+    decimal->digits = ( long )( decimal->size - 1 ) * _PDCLIB_DECIMAL_LIMB_DIGITS;
+
+    for ( top = decimal->data[ decimal->size - 1 ]; top > 0; top /= 10 )
+    {
+        ++decimal->digits;
+    }
+
+    return decimal;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+#include <string.h>
+
+int main( void )
+{
+#ifndef REGTEST
+    _PDCLIB_decimal_t decimal;
+    char buffer[ 40 ];
+
+    /* 3 * 2^-3 = 375 * 10^-3 */
+    decimal.size = 0;
+    _PDCLIB_decimal_muladd( &decimal, 1, 3 );
+    _PDCLIB_decimal_scale( &decimal, -3, 0 );
+    TESTCASE( decimal.scale == 3 );
+    TESTCASE( decimal.digits == 3 );
+    TESTCASE( decimal.data[ 0 ] == 375 );
+    TESTCASE( ! decimal.inexact );
+
+    /* 3 * 2^64 = 55340232221128654848 */
+    decimal.size = 0;
+    _PDCLIB_decimal_muladd( &decimal, 1, 3 );
+    _PDCLIB_decimal_scale( &decimal, 64, 0 );
+    TESTCASE( decimal.scale == 0 );
+    TESTCASE( decimal.digits == 20 );
+    _PDCLIB_decimal_tostring( &decimal, 0, 20, buffer );
+    TESTCASE( memcmp( buffer, "55340232221128654848", 20 ) == 0 );
+
+    /* 2^200, leading digits only */
+    decimal.size = 0;
+    _PDCLIB_decimal_muladd( &decimal, 1, 1 );
+    _PDCLIB_decimal_scale( &decimal, 200, 3 );
+    TESTCASE( decimal.inexact );
+    TESTCASE( _PDCLIB_decimal_exp( &decimal ) == 60 );
+    _PDCLIB_decimal_tostring( &decimal, 0, 10, buffer );
+    TESTCASE( memcmp( buffer, "1606938044", 10 ) == 0 );
+
+    /* Zero */
+    decimal.size = 0;
+    _PDCLIB_decimal_scale( &decimal, -20, 0 );
+    TESTCASE( decimal.digits == 0 );
+    TESTCASE( decimal.scale == 0 );
+#endif
+    return TEST_RESULTS;
+}
+
+#endif
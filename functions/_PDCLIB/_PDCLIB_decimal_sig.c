@@ -0,0 +1,74 @@
+/* _PDCLIB_decimal_sig( _PDCLIB_decimal_t const * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_internal.h"
+
+#include <stddef.h>
+
+long _PDCLIB_decimal_sig( _PDCLIB_decimal_t const * decimal )
+{
+    long sig = decimal->digits;
+    _PDCLIB_decimal_limb_t limb;
+    size_t i;
+
+    if ( sig == 0 )
+    {
+        return 0;
+    }
+
+    /* Skip zero limbs... */
+    for ( i = 0; decimal->data[ i ] == 0; ++i )
+    {
+        sig -= _PDCLIB_DECIMAL_LIMB_DIGITS;
+    }
+
+    /* ...and zero digits of the first nonzero one. */
+    for ( limb = decimal->data[ i ]; limb % 10 == 0; limb /= 10 )
+    {
+        --sig;
+    }
+
+    return sig;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+#ifndef REGTEST
+    _PDCLIB_decimal_t decimal;
+
+    decimal.size = 0;
+    decimal.digits = 0;
+    decimal.scale = 0;
+    TESTCASE( _PDCLIB_decimal_sig( &decimal ) == 0 );
+
+    decimal.size = 1;
+    decimal.data[ 0 ] = 1234;
+    decimal.digits = 4;
+    TESTCASE( _PDCLIB_decimal_sig( &decimal ) == 4 );
+
+    decimal.data[ 0 ] = 12000;
+    decimal.digits = 5;
+    TESTCASE( _PDCLIB_decimal_sig( &decimal ) == 2 );
+
+    decimal.size = 3;
+    decimal.data[ 0 ] = 0;
+    decimal.data[ 1 ] = 500000000;
+    decimal.data[ 2 ] = 7;
+    decimal.digits = 19;
+    TESTCASE( _PDCLIB_decimal_sig( &decimal ) == 2 );
+#endif
+    return TEST_RESULTS;
+}
+
+#endif
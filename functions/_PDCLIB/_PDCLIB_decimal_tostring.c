@@ -0,0 +1,120 @@
+/* _PDCLIB_decimal_tostring( _PDCLIB_decimal_t const *, long, long, char * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_internal.h"
+
+#include <stddef.h>
+#include <string.h>
+
+void _PDCLIB_decimal_tostring( _PDCLIB_decimal_t const * _PDCLIB_restrict decimal, long index, long count, char * _PDCLIB_restrict buffer )
+{
+    /* Digits of one limb, least significant first */
+    char digits[ _PDCLIB_DECIMAL_LIMB_DIGITS ];
+    _PDCLIB_decimal_limb_t limb;
+    unsigned long pos;
+    size_t current;
+    int i;
+
+    /* Leading zeroes */
+    while ( count > 0 && index < 0 )
+    {
+        *buffer++ = '0';
+        ++index;
+        --count;
+    }
+
+    if ( count > 0 && index < decimal->digits )
+    {
+        /* Position of the first digit, counted from the least significant */
+        pos = ( unsigned long )( decimal->digits - 1 - index );
+        current = pos / _PDCLIB_DECIMAL_LIMB_DIGITS;
+
+        /* Each limb is split into digits once, and copied from there. */
+        for ( ;; )
+        {
+            for ( i = 0, limb = decimal->data[ current ]; i < _PDCLIB_DECIMAL_LIMB_DIGITS; ++i, limb /= 10 )
+            {
+                digits[ i ] = ( char )( '0' + limb % 10 );
+            }
+
+            for ( i = ( int )( pos % _PDCLIB_DECIMAL_LIMB_DIGITS ); i >= 0 && count > 0; --i, --count )
+            {
+                *buffer++ = digits[ i ];
+                ++index;
+            }
+
+            if ( count == 0 || current == 0 )
+            {
+                break;
+            }
+
+            --current;
+            pos = ( unsigned long )current * _PDCLIB_DECIMAL_LIMB_DIGITS + _PDCLIB_DECIMAL_LIMB_DIGITS - 1;
+        }
+    }
+
+    /* Trailing zeroes */
+    if ( count > 0 )
+    {
+        memset( buffer, '0', ( size_t )count );
+    }
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+#include <string.h>
+
+int main( void )
+{
+#ifndef REGTEST
+    _PDCLIB_decimal_t decimal;
+    char buffer[ 30 ];
+
+    /* 70000000001234567890 */
+    decimal.size = 3;
+    decimal.data[ 0 ] = 234567890;
+    decimal.data[ 1 ] = 1;
+    decimal.data[ 2 ] = 70;
+    decimal.digits = 20;
+    decimal.scale = 0;
+
+    memset( buffer, '\0', sizeof( buffer ) );
+    _PDCLIB_decimal_tostring( &decimal, 0, 20, buffer );
+    TESTCASE( strcmp( buffer, "70000000001234567890" ) == 0 );
+
+    memset( buffer, '\0', sizeof( buffer ) );
+    _PDCLIB_decimal_tostring( &decimal, 1, 10, buffer );
+    TESTCASE( strcmp( buffer, "0000000001" ) == 0 );
+
+    memset( buffer, '\0', sizeof( buffer ) );
+    _PDCLIB_decimal_tostring( &decimal, -3, 5, buffer );
+    TESTCASE( strcmp( buffer, "00070" ) == 0 );
+
+    memset( buffer, '\0', sizeof( buffer ) );
+    _PDCLIB_decimal_tostring( &decimal, 15, 8, buffer );
+    TESTCASE( strcmp( buffer, "67890000" ) == 0 );
+
+    memset( buffer, '\0', sizeof( buffer ) );
+    _PDCLIB_decimal_tostring( &decimal, 25, 3, buffer );
+    TESTCASE( strcmp( buffer, "000" ) == 0 );
+
+    /* Zero */
+    decimal.size = 0;
+    decimal.digits = 0;
+    memset( buffer, '\0', sizeof( buffer ) );
+    _PDCLIB_decimal_tostring( &decimal, 0, 3, buffer );
+    TESTCASE( strcmp( buffer, "000" ) == 0 );
+#endif
+    return TEST_RESULTS;
+}
+
+#endif
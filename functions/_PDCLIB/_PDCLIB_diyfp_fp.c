@@ -0,0 +1,73 @@
+/* _PDCLIB_diyfp_fp( _PDCLIB_diyfp_t *, int, int, unsigned char const *, size_t )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_internal.h"
+
+#include <stddef.h>
+
+_PDCLIB_diyfp_t * _PDCLIB_diyfp_fp( _PDCLIB_diyfp_t * diyfp, int exp, int dec, unsigned char const * mant, size_t mant_dig )
+{
+    size_t excess_bits = ( mant_dig - 1 ) % _PDCLIB_CHAR_BIT;
+    size_t i;
+
+    /* Handle the most significant byte (which might need masking)... */
+    diyfp->f = ( ( _PDCLIB_uint_least64_t )dec << excess_bits ) | ( *mant & ( ( 1u << excess_bits ) - 1 ) );
+
+    /* ...then the remaining bytes. */
+    for ( i = 1; i <= ( mant_dig - 1 ) / _PDCLIB_CHAR_BIT; ++i )
+    {
+        diyfp->f = ( diyfp->f << _PDCLIB_CHAR_BIT ) | *( mant _PDCLIB_FLT_OP i );
+    }
+
+    /* Binary exponent of the mantissa's least significant bit */
+    diyfp->e = exp + ( dec ? 0 : 1 ) - ( int )( mant_dig - 1 );
+
+    return diyfp;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+#include <string.h>
+
+#ifndef REGTEST
+
+static int check( double value, _PDCLIB_uint_least64_t f, int e )
+{
+    unsigned char bytes[ sizeof( double ) ];
+    _PDCLIB_diyfp_t diyfp;
+
+    memcpy( bytes, &value, sizeof( double ) );
+    _PDCLIB_diyfp_fp( &diyfp,
+                      ( int )_PDCLIB_DBL_EXP( bytes ) - _PDCLIB_DBL_BIAS,
+                      _PDCLIB_DBL_DEC( bytes ),
+                      _PDCLIB_DBL_MANT_START( bytes ),
+                      _PDCLIB_DBL_MANT_DIG );
+    return diyfp.f == f && diyfp.e == e;
+}
+
+#endif
+
+int main( void )
+{
+#ifndef REGTEST
+    TESTCASE( check( 1.0, _PDCLIB_UINT_LEAST64_C( 0x10000000000000 ), -52 ) );
+    TESTCASE( check( 0.375, _PDCLIB_UINT_LEAST64_C( 0x18000000000000 ), -54 ) );
+    TESTCASE( check( 0x1.fffffffffffffp1023, _PDCLIB_UINT_LEAST64_C( 0x1fffffffffffff ), 971 ) );
+    /* Subnormals */
+    TESTCASE( check( 0x0.0000000000001p-1022, 1, -1074 ) );
+    TESTCASE( check( 0x0.8p-1022, _PDCLIB_UINT_LEAST64_C( 0x8000000000000 ), -1074 ) );
+    TESTCASE( check( 0.0, 0, -1074 ) );
+#endif
+    return TEST_RESULTS;
+}
+
+#endif
@@ -0,0 +1,78 @@
+/* _PDCLIB_diyfp_mul( _PDCLIB_diyfp_t *, _PDCLIB_diyfp_t const * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_internal.h"
+
+_PDCLIB_diyfp_t * _PDCLIB_diyfp_mul( _PDCLIB_diyfp_t * diyfp, _PDCLIB_diyfp_t const * factor )
+{
+    /* 64 x 64 bit multiplication in 32 bit halves, keeping the upper 64 bits
+       of the result (rounded).
+    */
+    const _PDCLIB_uint_least64_t mask = _PDCLIB_UINT_LEAST64_C( 0xffffffff );
+    _PDCLIB_uint_least64_t a = diyfp->f >> 32;
+    _PDCLIB_uint_least64_t b = diyfp->f & mask;
+    _PDCLIB_uint_least64_t c = factor->f >> 32;
+    _PDCLIB_uint_least64_t d = factor->f & mask;
+    _PDCLIB_uint_least64_t ad = a * d;
+    _PDCLIB_uint_least64_t bc = b * c;
+    _PDCLIB_uint_least64_t mid = ( ( b * d ) >> 32 ) + ( ad & mask ) + ( bc & mask ) + ( _PDCLIB_UINT_LEAST64_C( 1 ) << 31 );
+
+    diyfp->f = a * c + ( ad >> 32 ) + ( bc >> 32 ) + ( mid >> 32 );
+    diyfp->e += factor->e + 64;
+
+    return diyfp;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+#ifndef REGTEST
+    _PDCLIB_diyfp_t x;
+    _PDCLIB_diyfp_t y;
+
+    /* 2^63 * 2^63 = 2^62 * 2^64 */
+    x.f = _PDCLIB_UINT_LEAST64_C( 1 ) << 63;
+    x.e = 0;
+    y = x;
+    _PDCLIB_diyfp_mul( &x, &y );
+    TESTCASE( x.f == _PDCLIB_UINT_LEAST64_C( 1 ) << 62 );
+    TESTCASE( x.e == 64 );
+
+    /* ( 2^64 - 1 )^2 = 2^128 - 2^65 + 1, upper half rounded: 2^64 - 2 */
+    x.f = ~_PDCLIB_UINT_LEAST64_C( 0 );
+    x.e = -10;
+    y.f = ~_PDCLIB_UINT_LEAST64_C( 0 );
+    y.e = 3;
+    _PDCLIB_diyfp_mul( &x, &y );
+    TESTCASE( x.f == ~_PDCLIB_UINT_LEAST64_C( 1 ) );
+    TESTCASE( x.e == 57 );
+
+    /* Rounding of the lower half: 3 * 2^63 = 1 * 2^64 + 2^63, rounded up */
+    x.f = 3;
+    x.e = 0;
+    y.f = _PDCLIB_UINT_LEAST64_C( 1 ) << 63;
+    y.e = 0;
+    _PDCLIB_diyfp_mul( &x, &y );
+    TESTCASE( x.f == 2 );
+
+    /* ...and 1 * 2^63 - 1 rounded down */
+    x.f = 1;
+    x.e = 0;
+    y.f = ( _PDCLIB_UINT_LEAST64_C( 1 ) << 63 ) - 1;
+    _PDCLIB_diyfp_mul( &x, &y );
+    TESTCASE( x.f == 0 );
+#endif
+    return TEST_RESULTS;
+}
+
+#endif
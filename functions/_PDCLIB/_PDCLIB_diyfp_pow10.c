@@ -0,0 +1,190 @@
+/* _PDCLIB_diyfp_pow10( _PDCLIB_diyfp_t *, int, int * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_internal.h"
+
+#include <stddef.h>
+
+/* 10^k, normalized and rounded to 64 bits, for every eighth k from -348 to
+   340 (covering the exponents of doubles). The binary exponents of
+   neighbouring entries differ by less than the width of the target range
+   _PDCLIB_DIYFP_ALPHA .. _PDCLIB_DIYFP_GAMMA.
+*/
+static const struct
+{
+    _PDCLIB_uint_least64_t f;
+    short e;
+    short k;
+} cache[] =
+{
+    { _PDCLIB_UINT_LEAST64_C( 0xfa8fd5a0081c0288 ), -1220, -348 },
+    { _PDCLIB_UINT_LEAST64_C( 0xbaaee17fa23ebf76 ), -1193, -340 },
+    { _PDCLIB_UINT_LEAST64_C( 0x8b16fb203055ac76 ), -1166, -332 },
+    { _PDCLIB_UINT_LEAST64_C( 0xcf42894a5dce35ea ), -1140, -324 },
+    { _PDCLIB_UINT_LEAST64_C( 0x9a6bb0aa55653b2d ), -1113, -316 },
+    { _PDCLIB_UINT_LEAST64_C( 0xe61acf033d1a45df ), -1087, -308 },
+    { _PDCLIB_UINT_LEAST64_C( 0xab70fe17c79ac6ca ), -1060, -300 },
+    { _PDCLIB_UINT_LEAST64_C( 0xff77b1fcbebcdc4f ), -1034, -292 },
+    { _PDCLIB_UINT_LEAST64_C( 0xbe5691ef416bd60c ), -1007, -284 },
+    { _PDCLIB_UINT_LEAST64_C( 0x8dd01fad907ffc3c ), -980, -276 },
+    { _PDCLIB_UINT_LEAST64_C( 0xd3515c2831559a83 ), -954, -268 },
+    { _PDCLIB_UINT_LEAST64_C( 0x9d71ac8fada6c9b5 ), -927, -260 },
+    { _PDCLIB_UINT_LEAST64_C( 0xea9c227723ee8bcb ), -901, -252 },
+    { _PDCLIB_UINT_LEAST64_C( 0xaecc49914078536d ), -874, -244 },
+    { _PDCLIB_UINT_LEAST64_C( 0x823c12795db6ce57 ), -847, -236 },
+    { _PDCLIB_UINT_LEAST64_C( 0xc21094364dfb5637 ), -821, -228 },
+    { _PDCLIB_UINT_LEAST64_C( 0x9096ea6f3848984f ), -794, -220 },
+    { _PDCLIB_UINT_LEAST64_C( 0xd77485cb25823ac7 ), -768, -212 },
+    { _PDCLIB_UINT_LEAST64_C( 0xa086cfcd97bf97f4 ), -741, -204 },
+    { _PDCLIB_UINT_LEAST64_C( 0xef340a98172aace5 ), -715, -196 },
+    { _PDCLIB_UINT_LEAST64_C( 0xb23867fb2a35b28e ), -688, -188 },
+    { _PDCLIB_UINT_LEAST64_C( 0x84c8d4dfd2c63f3b ), -661, -180 },
+    { _PDCLIB_UINT_LEAST64_C( 0xc5dd44271ad3cdba ), -635, -172 },
+    { _PDCLIB_UINT_LEAST64_C( 0x936b9fcebb25c996 ), -608, -164 },
+    { _PDCLIB_UINT_LEAST64_C( 0xdbac6c247d62a584 ), -582, -156 },
+    { _PDCLIB_UINT_LEAST64_C( 0xa3ab66580d5fdaf6 ), -555, -148 },
+    { _PDCLIB_UINT_LEAST64_C( 0xf3e2f893dec3f126 ), -529, -140 },
+    { _PDCLIB_UINT_LEAST64_C( 0xb5b5ada8aaff80b8 ), -502, -132 },
+    { _PDCLIB_UINT_LEAST64_C( 0x87625f056c7c4a8b ), -475, -124 },
+    { _PDCLIB_UINT_LEAST64_C( 0xc9bcff6034c13053 ), -449, -116 },
+    { _PDCLIB_UINT_LEAST64_C( 0x964e858c91ba2655 ), -422, -108 },
+    { _PDCLIB_UINT_LEAST64_C( 0xdff9772470297ebd ), -396, -100 },
+    { _PDCLIB_UINT_LEAST64_C( 0xa6dfbd9fb8e5b88f ), -369, -92 },
+    { _PDCLIB_UINT_LEAST64_C( 0xf8a95fcf88747d94 ), -343, -84 },
+    { _PDCLIB_UINT_LEAST64_C( 0xb94470938fa89bcf ), -316, -76 },
+    { _PDCLIB_UINT_LEAST64_C( 0x8a08f0f8bf0f156b ), -289, -68 },
+    { _PDCLIB_UINT_LEAST64_C( 0xcdb02555653131b6 ), -263, -60 },
+    { _PDCLIB_UINT_LEAST64_C( 0x993fe2c6d07b7fac ), -236, -52 },
+    { _PDCLIB_UINT_LEAST64_C( 0xe45c10c42a2b3b06 ), -210, -44 },
+    { _PDCLIB_UINT_LEAST64_C( 0xaa242499697392d3 ), -183, -36 },
+    { _PDCLIB_UINT_LEAST64_C( 0xfd87b5f28300ca0e ), -157, -28 },
+    { _PDCLIB_UINT_LEAST64_C( 0xbce5086492111aeb ), -130, -20 },
+    { _PDCLIB_UINT_LEAST64_C( 0x8cbccc096f5088cc ), -103, -12 },
+    { _PDCLIB_UINT_LEAST64_C( 0xd1b71758e219652c ), -77, -4 },
+    { _PDCLIB_UINT_LEAST64_C( 0x9c40000000000000 ), -50, 4 },
+    { _PDCLIB_UINT_LEAST64_C( 0xe8d4a51000000000 ), -24, 12 },
+    { _PDCLIB_UINT_LEAST64_C( 0xad78ebc5ac620000 ), 3, 20 },
+    { _PDCLIB_UINT_LEAST64_C( 0x813f3978f8940984 ), 30, 28 },
+    { _PDCLIB_UINT_LEAST64_C( 0xc097ce7bc90715b3 ), 56, 36 },
+    { _PDCLIB_UINT_LEAST64_C( 0x8f7e32ce7bea5c70 ), 83, 44 },
+    { _PDCLIB_UINT_LEAST64_C( 0xd5d238a4abe98068 ), 109, 52 },
+    { _PDCLIB_UINT_LEAST64_C( 0x9f4f2726179a2245 ), 136, 60 },
+    { _PDCLIB_UINT_LEAST64_C( 0xed63a231d4c4fb27 ), 162, 68 },
+    { _PDCLIB_UINT_LEAST64_C( 0xb0de65388cc8ada8 ), 189, 76 },
+    { _PDCLIB_UINT_LEAST64_C( 0x83c7088e1aab65db ), 216, 84 },
+    { _PDCLIB_UINT_LEAST64_C( 0xc45d1df942711d9a ), 242, 92 },
+    { _PDCLIB_UINT_LEAST64_C( 0x924d692ca61be758 ), 269, 100 },
+    { _PDCLIB_UINT_LEAST64_C( 0xda01ee641a708dea ), 295, 108 },
+    { _PDCLIB_UINT_LEAST64_C( 0xa26da3999aef774a ), 322, 116 },
+    { _PDCLIB_UINT_LEAST64_C( 0xf209787bb47d6b85 ), 348, 124 },
+    { _PDCLIB_UINT_LEAST64_C( 0xb454e4a179dd1877 ), 375, 132 },
+    { _PDCLIB_UINT_LEAST64_C( 0x865b86925b9bc5c2 ), 402, 140 },
+    { _PDCLIB_UINT_LEAST64_C( 0xc83553c5c8965d3d ), 428, 148 },
+    { _PDCLIB_UINT_LEAST64_C( 0x952ab45cfa97a0b3 ), 455, 156 },
+    { _PDCLIB_UINT_LEAST64_C( 0xde469fbd99a05fe3 ), 481, 164 },
+    { _PDCLIB_UINT_LEAST64_C( 0xa59bc234db398c25 ), 508, 172 },
+    { _PDCLIB_UINT_LEAST64_C( 0xf6c69a72a3989f5c ), 534, 180 },
+    { _PDCLIB_UINT_LEAST64_C( 0xb7dcbf5354e9bece ), 561, 188 },
+    { _PDCLIB_UINT_LEAST64_C( 0x88fcf317f22241e2 ), 588, 196 },
+    { _PDCLIB_UINT_LEAST64_C( 0xcc20ce9bd35c78a5 ), 614, 204 },
+    { _PDCLIB_UINT_LEAST64_C( 0x98165af37b2153df ), 641, 212 },
+    { _PDCLIB_UINT_LEAST64_C( 0xe2a0b5dc971f303a ), 667, 220 },
+    { _PDCLIB_UINT_LEAST64_C( 0xa8d9d1535ce3b396 ), 694, 228 },
+    { _PDCLIB_UINT_LEAST64_C( 0xfb9b7cd9a4a7443c ), 720, 236 },
+    { _PDCLIB_UINT_LEAST64_C( 0xbb764c4ca7a44410 ), 747, 244 },
+    { _PDCLIB_UINT_LEAST64_C( 0x8bab8eefb6409c1a ), 774, 252 },
+    { _PDCLIB_UINT_LEAST64_C( 0xd01fef10a657842c ), 800, 260 },
+    { _PDCLIB_UINT_LEAST64_C( 0x9b10a4e5e9913129 ), 827, 268 },
+    { _PDCLIB_UINT_LEAST64_C( 0xe7109bfba19c0c9d ), 853, 276 },
+    { _PDCLIB_UINT_LEAST64_C( 0xac2820d9623bf429 ), 880, 284 },
+    { _PDCLIB_UINT_LEAST64_C( 0x80444b5e7aa7cf85 ), 907, 292 },
+    { _PDCLIB_UINT_LEAST64_C( 0xbf21e44003acdd2d ), 933, 300 },
+    { _PDCLIB_UINT_LEAST64_C( 0x8e679c2f5e44ff8f ), 960, 308 },
+    { _PDCLIB_UINT_LEAST64_C( 0xd433179d9c8cb841 ), 986, 316 },
+    { _PDCLIB_UINT_LEAST64_C( 0x9e19db92b4e31ba9 ), 1013, 324 },
+    { _PDCLIB_UINT_LEAST64_C( 0xeb96bf6ebadf77d9 ), 1039, 332 },
+    { _PDCLIB_UINT_LEAST64_C( 0xaf87023b9bf0ee6b ), 1066, 340 }
+};
+
+_PDCLIB_diyfp_t * _PDCLIB_diyfp_pow10( _PDCLIB_diyfp_t * power, int e, int * k )
+{
+    /* Binary exponent the power must have at least */
+    int min_e = _PDCLIB_DIYFP_ALPHA - e - 64;
+    size_t low = 0;
+    size_t high = sizeof( cache ) / sizeof( cache[ 0 ] );
+    size_t mid;
+
+    /* Binary search for the first entry with an exponent of min_e or
+       above...
+    */
+    while ( low < high )
+    {
+        mid = ( low + high ) / 2;
+
+        if ( cache[ mid ].e < min_e )
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    /* ...which must not exceed the range. */
+    if ( low == sizeof( cache ) / sizeof( cache[ 0 ] ) || cache[ low ].e > _PDCLIB_DIYFP_GAMMA - e - 64 )
+    {
+        return NULL;
+    }
+
+    power->f = cache[ low ].f;
+    power->e = cache[ low ].e;
+    *k = cache[ low ].k;
+    return power;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+#ifndef REGTEST
+    _PDCLIB_diyfp_t power;
+    int k;
+    int e;
+
+    /* 1.0, normalized (2^63 * 2^-63): 10^0 in range, f = 10^0 * 2^63 */
+    TESTCASE( _PDCLIB_diyfp_pow10( &power, -63, &k ) != NULL );
+    TESTCASE( power.e - 63 + 64 >= _PDCLIB_DIYFP_ALPHA );
+    TESTCASE( power.e - 63 + 64 <= _PDCLIB_DIYFP_GAMMA );
+    TESTCASE( k == 4 );
+    TESTCASE( power.f == _PDCLIB_UINT_LEAST64_C( 0x9c40000000000000 ) );
+    TESTCASE( power.e == -50 );
+
+    /* The whole range of doubles, normalized, from the smallest subnormal
+       to the largest value.
+    */
+    for ( e = -1074 - 63; e <= 1023 - 63; ++e )
+    {
+        TESTCASE( _PDCLIB_diyfp_pow10( &power, e, &k ) != NULL );
+        TESTCASE( power.e + e + 64 >= _PDCLIB_DIYFP_ALPHA );
+        TESTCASE( power.e + e + 64 <= _PDCLIB_DIYFP_GAMMA );
+        TESTCASE( ( power.f >> 63 ) == 1 );
+    }
+
+    /* Out of range */
+    TESTCASE( _PDCLIB_diyfp_pow10( &power, -20000, &k ) == NULL );
+    TESTCASE( _PDCLIB_diyfp_pow10( &power, 20000, &k ) == NULL );
+#endif
+    return TEST_RESULTS;
+}
+
+#endif
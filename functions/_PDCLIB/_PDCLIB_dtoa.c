@@ -0,0 +1,101 @@
+/* _PDCLIB_dtoa( char *, size_t, double )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#include <stdlib.h>
+
+#ifndef REGTEST
+
+#include <limits.h>
+#include <string.h>
+
+size_t _PDCLIB_dtoa( char * s, size_t n, double value )
+{
+    unsigned char bytes[ sizeof( double ) ];
+    int exp;
+    memcpy( bytes, &value, sizeof( double ) );
+    exp = _PDCLIB_DBL_EXP( bytes ) - _PDCLIB_DBL_BIAS;
+
+    if ( exp == _PDCLIB_DBL_MAX_EXP )
+    {
+        /*                           NAN       INF */
+        exp = ( value != value ) ? INT_MIN : INT_MAX;
+    }
+
+    return _PDCLIB_fptoa( s, n,
+                          _PDCLIB_DBL_SIGN( bytes ),
+                          exp,
+                          _PDCLIB_DBL_DEC( bytes ),
+                          _PDCLIB_DBL_MANT_START( bytes ),
+                          _PDCLIB_DBL_MANT_DIG,
+                          1 - _PDCLIB_DBL_BIAS );
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+#include <float.h>
+#include <string.h>
+
+#ifndef REGTEST
+
+static int check( double value, char const * expect )
+{
+    char buffer[ _PDCLIB_DTOA_CHARS ];
+    size_t len = _PDCLIB_dtoa( buffer, sizeof( buffer ), value );
+    return len == strlen( expect ) && memcmp( buffer, expect, len ) == 0;
+}
+
+#endif
+
+int main( void )
+{
+#ifndef REGTEST
+    double zero = 0.0;
+    char buffer[ 4 ];
+
+    TESTCASE( check( 0.0, "0" ) );
+    TESTCASE( check( -0.0, "-0" ) );
+    TESTCASE( check( 1.0, "1" ) );
+    TESTCASE( check( -123.0, "-123" ) );
+    TESTCASE( check( 12345.0, "12345" ) );
+    TESTCASE( check( 0.1, "0.1" ) );
+    TESTCASE( check( 0.3, "0.3" ) );
+    TESTCASE( check( 1.5e-7, "1.5e-07" ) );
+    TESTCASE( check( 2.0 / 3.0, "0.6666666666666666" ) );
+    TESTCASE( check( 123.456, "123.456" ) );
+    /* Fixed notation unless scientific is shorter */
+    TESTCASE( check( 100.0, "100" ) );
+    TESTCASE( check( 1e5, "1e+05" ) );
+    TESTCASE( check( 0.001, "0.001" ) );
+    TESTCASE( check( 0.0001, "1e-04" ) );
+    TESTCASE( check( 1e22, "1e+22" ) );
+    TESTCASE( check( 1e23, "1e+23" ) );
+    /* Mantissa a power of two (closer lower neighbour) */
+    TESTCASE( check( 9007199254740992.0, "9007199254740992" ) );
+    TESTCASE( check( 1152921504606846976.0, "1152921504606847000" ) );
+    TESTCASE( check( 1152921504606846976.0 * 1048576.0, "1.2089258196146292e+24" ) );
+    /* Limits */
+    TESTCASE( check( DBL_MAX, "1.7976931348623157e+308" ) );
+    TESTCASE( check( DBL_MIN, "2.2250738585072014e-308" ) );
+    TESTCASE( check( DBL_MIN * 3.0, "6.675221575521604e-308" ) );
+    TESTCASE( check( 4.9406564584124654e-324, "5e-324" ) );
+    TESTCASE( check( -4.9406564584124654e-324, "-5e-324" ) );
+    /* Not a number, infinity */
+    TESTCASE( check( 1.0 / zero, "inf" ) );
+    TESTCASE( check( -1.0 / zero, "-inf" ) );
+    TESTCASE( check( zero / zero, "nan" ) || check( zero / zero, "-nan" ) );
+    /* Buffer too small */
+    TESTCASE( _PDCLIB_dtoa( buffer, 4, 0.125 ) == 0 );
+    TESTCASE( _PDCLIB_dtoa( buffer, 4, 0.25 ) == 4 );
+    TESTCASE( memcmp( buffer, "0.25", 4 ) == 0 );
+#endif
+    return TEST_RESULTS;
+}
+
+#endif
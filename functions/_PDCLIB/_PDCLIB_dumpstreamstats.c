@@ -0,0 +1,100 @@
+/* _PDCLIB_dumpstreamstats( FILE * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#include <stdio.h>
+
+#ifndef REGTEST
+
+#ifdef _PDCLIB_STREAMSTATS
+
+#ifndef __STDC_NO_THREADS__
+#include <threads.h>
+#endif
+
+static int print( struct _PDCLIB_file_t * out, const char * name, const struct _PDCLIB_streamstats_t * stats )
+{
+    return fprintf( out, "%s: %llu bytes read (%llu fills), %llu bytes written (%llu flushes), %llu seeks, %llu lock contentions, %llu us in system calls\n",
+                    name,
+                    ( unsigned long long )stats->bytes_read,
+                    ( unsigned long long )stats->fills,
+                    ( unsigned long long )stats->bytes_written,
+                    ( unsigned long long )stats->flushes,
+                    ( unsigned long long )stats->seeks,
+                    ( unsigned long long )stats->contentions,
+                    ( unsigned long long )( stats->syscall_ns / 1000 ) );
+}
+
+int _PDCLIB_dumpstreamstats( struct _PDCLIB_file_t * out )
+{
+    struct _PDCLIB_file_t ** streams;
+    struct _PDCLIB_streamstats_t stats;
+    char name[ 64 ];
+    size_t count;
+    size_t i;
+    int rc = 0;
+
+    /* Streams are only locked while their statistics are taken, as out is
+       one of them.
+    */
+    if ( ( streams = _PDCLIB_refstreams( &count ) ) != NULL )
+    {
+        for ( i = 0; i < count; ++i )
+        {
+            struct _PDCLIB_file_t * stream = streams[ i ];
+            int open;
+
+            _PDCLIB_FLOCK( stream->lock );
+
+            if ( ( open = _PDCLIB_isstream( stream ) ) )
+            {
+                _PDCLIB_streamstats( stream, &stats );
+
+                if ( stream->status & _PDCLIB_FCOOKIE )
+                {
+                    sprintf( name, "stream %p (cookie)", ( void * )stream );
+                }
+                else
+                {
+                    sprintf( name, "stream %p (fd %d)", ( void * )stream, ( int )stream->handle );
+                }
+            }
+
+            _PDCLIB_FUNLOCK( stream->lock );
+
+            if ( open && print( out, name, &stats ) < 0 )
+            {
+                rc = EOF;
+            }
+        }
+
+        _PDCLIB_unrefstreams( streams, count );
+    }
+
+    _PDCLIB_streamstats( NULL, &stats );
+
+    if ( print( out, "total", &stats ) < 0 )
+    {
+        rc = EOF;
+    }
+
+    return rc;
+}
+
+#endif
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+    /* Testing covered by _PDCLIB_streamstats.c */
+    return TEST_RESULTS;
+}
+
+#endif
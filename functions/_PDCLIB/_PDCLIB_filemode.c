@@ -9,8 +9,12 @@
 #ifndef REGTEST
 
 /* Helper function that parses the C-style mode string passed to fopen() into
-   the PDCLib flags FREAD, FWRITE, FAPPEND, FRW (read-write) and FBIN (binary
-   mode).
+   the PDCLib flags FREAD, FWRITE, FAPPEND, FRW (read-write), FBIN (binary
+   mode), and the extensions FMMAP (memory-mapped) and FAHEAD (read-ahead),
+   which are only honored for read-only streams, FBEHIND (write-behind),
+   which is only honored for write-only streams, and FDIRECT (direct I/O),
+   which is only honored for "r" / "w" streams, and takes precedence over
+   the others.
 */
 unsigned int _PDCLIB_filemode( const char * const mode )
 {
@@ -41,7 +45,8 @@ unsigned int _PDCLIB_filemode( const char * const mode )
             return 0;
     }
 
-    for ( i = 1; i < 4; ++i )
+    /* At most one each of '+', 'b', 'm', 'p', 'd', 'u'. */
+    for ( i = 1; i < 8; ++i )
     {
         switch ( mode[i] )
         {
@@ -65,8 +70,80 @@ unsigned int _PDCLIB_filemode( const char * const mode )
                 rc |= _PDCLIB_FBIN;
                 break;
 
+            case 'm':
+                if ( rc & _PDCLIB_FMMAP )
+                {
+                    /* Duplicates are invalid */
+                    return 0;
+                }
+
+                rc |= _PDCLIB_FMMAP;
+                break;
+
+            case 'p':
+                if ( rc & _PDCLIB_FAHEAD )
+                {
+                    /* Duplicates are invalid */
+                    return 0;
+                }
+
+                rc |= _PDCLIB_FAHEAD;
+                break;
+
+            case 'd':
+                if ( rc & _PDCLIB_FBEHIND )
+                {
+                    /* Duplicates are invalid */
+                    return 0;
+                }
+
+                rc |= _PDCLIB_FBEHIND;
+                break;
+
+            case 'u':
+                if ( rc & _PDCLIB_FDIRECT )
+                {
+                    /* Duplicates are invalid */
+                    return 0;
+                }
+
+                rc |= _PDCLIB_FDIRECT;
+                break;
+
             case '\0':
                 /* End of mode */
+                if ( rc & ( _PDCLIB_FWRITE | _PDCLIB_FRW ) )
+                {
+                    /* Mapping / read-ahead are hints, ignored for
+                       writable streams.
+                    */
+                    rc &= ~( _PDCLIB_FMMAP | _PDCLIB_FAHEAD );
+                }
+
+                if ( ( rc & ( _PDCLIB_FREAD | _PDCLIB_FRW ) ) )
+                {
+                    /* Write-behind is a hint, ignored for readable
+                       streams.
+                    */
+                    rc &= ~_PDCLIB_FBEHIND;
+                }
+
+                if ( rc & ( _PDCLIB_FAPPEND | _PDCLIB_FRW ) )
+                {
+                    /* Direct I/O is a hint, ignored unless reading or
+                       writing sequentially.
+                    */
+                    rc &= ~_PDCLIB_FDIRECT;
+                }
+
+                if ( rc & _PDCLIB_FDIRECT )
+                {
+                    /* Mapping, read-ahead and write-behind go through the
+                       system's cache.
+                    */
+                    rc &= ~( _PDCLIB_FMMAP | _PDCLIB_FAHEAD | _PDCLIB_FBEHIND );
+                }
+
                 return rc;
 
             default:
@@ -75,7 +152,7 @@ unsigned int _PDCLIB_filemode( const char * const mode )
         }
     }
 
-    /* Longer than three chars - invalid. */
+    /* Longer than seven chars - invalid. */
     return 0;
 }
 
@@ -107,6 +184,28 @@ int main( void )
     TESTCASE( _PDCLIB_filemode( "r++" ) == 0 );
     TESTCASE( _PDCLIB_filemode( "wbb" ) == 0 );
     TESTCASE( _PDCLIB_filemode( "a+bx" ) == 0 );
+    TESTCASE( _PDCLIB_filemode( "rm" ) == ( _PDCLIB_FREAD | _PDCLIB_FMMAP ) );
+    TESTCASE( _PDCLIB_filemode( "rbm" ) == ( _PDCLIB_FREAD | _PDCLIB_FBIN | _PDCLIB_FMMAP ) );
+    TESTCASE( _PDCLIB_filemode( "r+m" ) == ( _PDCLIB_FREAD | _PDCLIB_FRW ) );
+    TESTCASE( _PDCLIB_filemode( "wm" ) == _PDCLIB_FWRITE );
+    TESTCASE( _PDCLIB_filemode( "rmm" ) == 0 );
+    TESTCASE( _PDCLIB_filemode( "rbp" ) == ( _PDCLIB_FREAD | _PDCLIB_FBIN | _PDCLIB_FAHEAD ) );
+    TESTCASE( _PDCLIB_filemode( "ap" ) == ( _PDCLIB_FAPPEND | _PDCLIB_FWRITE ) );
+    TESTCASE( _PDCLIB_filemode( "rpp" ) == 0 );
+    TESTCASE( _PDCLIB_filemode( "wbd" ) == ( _PDCLIB_FWRITE | _PDCLIB_FBIN | _PDCLIB_FBEHIND ) );
+    TESTCASE( _PDCLIB_filemode( "ad" ) == ( _PDCLIB_FAPPEND | _PDCLIB_FWRITE | _PDCLIB_FBEHIND ) );
+    TESTCASE( _PDCLIB_filemode( "w+d" ) == ( _PDCLIB_FWRITE | _PDCLIB_FRW ) );
+    TESTCASE( _PDCLIB_filemode( "rd" ) == _PDCLIB_FREAD );
+    TESTCASE( _PDCLIB_filemode( "rb+m" ) == ( _PDCLIB_FREAD | _PDCLIB_FRW | _PDCLIB_FBIN ) );
+    TESTCASE( _PDCLIB_filemode( "rbmp" ) == ( _PDCLIB_FREAD | _PDCLIB_FBIN | _PDCLIB_FMMAP | _PDCLIB_FAHEAD ) );
+    TESTCASE( _PDCLIB_filemode( "rbu" ) == ( _PDCLIB_FREAD | _PDCLIB_FBIN | _PDCLIB_FDIRECT ) );
+    TESTCASE( _PDCLIB_filemode( "wu" ) == ( _PDCLIB_FWRITE | _PDCLIB_FDIRECT ) );
+    TESTCASE( _PDCLIB_filemode( "au" ) == ( _PDCLIB_FAPPEND | _PDCLIB_FWRITE ) );
+    TESTCASE( _PDCLIB_filemode( "r+u" ) == ( _PDCLIB_FREAD | _PDCLIB_FRW ) );
+    TESTCASE( _PDCLIB_filemode( "rmpu" ) == ( _PDCLIB_FREAD | _PDCLIB_FDIRECT ) );
+    TESTCASE( _PDCLIB_filemode( "wdu" ) == ( _PDCLIB_FWRITE | _PDCLIB_FDIRECT ) );
+    TESTCASE( _PDCLIB_filemode( "ruu" ) == 0 );
+    TESTCASE( _PDCLIB_filemode( "rb+mpdu" ) == ( _PDCLIB_FREAD | _PDCLIB_FRW | _PDCLIB_FBIN ) );
 #endif
     return TEST_RESULTS;
 }
@@ -0,0 +1,126 @@
+/* _PDCLIB_flock_wait( struct _PDCLIB_flock_t * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#include <stdio.h>
+
+#ifndef REGTEST
+
+#ifndef __STDC_NO_THREADS__
+
+#include "pdclib/_PDCLIB_glue.h"
+
+#include <threads.h>
+
+void _PDCLIB_flock_wait( struct _PDCLIB_flock_t * lock )
+{
+    thrd_t self = thrd_current();
+    int spins;
+
+    if ( lock->owner == self )
+    {
+        /* Recursive locking. Only the owner itself can have set owner to
+           its own ID, so this is safe to check without synchronization.
+        */
+        ++lock->count;
+        return;
+    }
+
+    /* The lock is probably held only briefly (for a single stdio call), so
+       try for a while before going to sleep.
+    */
+    for ( spins = 0; spins < _PDCLIB_FLOCK_SPINS; ++spins )
+    {
+        if ( lock->state == 0 && _PDCLIB_ATOMIC_CAS( &lock->state, 0, 1 ) )
+        {
+            lock->owner = self;
+            lock->count = 1;
+#ifdef _PDCLIB_STREAMSTATS
+            ++lock->contentions;
+#endif
+            return;
+        }
+    }
+
+    /* Mark the lock as contended (so the thread releasing it knows to wake
+       a waiter), and sleep until it is released. Having acquired the lock
+       this way, it is left marked contended, as other threads might still
+       be waiting.
+    */
+    while ( _PDCLIB_ATOMIC_SWAP( &lock->state, 2 ) != 0 )
+    {
+        _PDCLIB_futex_wait( &lock->state, 2 );
+    }
+
+    lock->owner = self;
+    lock->count = 1;
+#ifdef _PDCLIB_STREAMSTATS
+    ++lock->contentions;
+#endif
+}
+
+#endif
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+#ifndef REGTEST
+#ifndef __STDC_NO_THREADS__
+#include <threads.h>
+
+#define COUNT 4
+#define ROUNDS 10000
+
+static struct _PDCLIB_flock_t g_lock = _PDCLIB_FLOCK_INIT;
+static long g_counter = 0;
+
+static int worker( void * arg )
+{
+    int i;
+    ( void )arg;
+
+    for ( i = 0; i < ROUNDS; ++i )
+    {
+        _PDCLIB_FLOCK( g_lock );
+        _PDCLIB_FLOCK( g_lock );
+        ++g_counter;
+        _PDCLIB_FUNLOCK( g_lock );
+        _PDCLIB_FUNLOCK( g_lock );
+    }
+
+    return 0;
+}
+#endif
+#endif
+
+int main( void )
+{
+#ifndef REGTEST
+#ifndef __STDC_NO_THREADS__
+    thrd_t thread[ COUNT ];
+    int i;
+
+    for ( i = 0; i < COUNT; ++i )
+    {
+        TESTCASE( thrd_create( &thread[ i ], worker, NULL ) == thrd_success );
+    }
+
+    for ( i = 0; i < COUNT; ++i )
+    {
+        TESTCASE( thrd_join( thread[ i ], NULL ) == thrd_success );
+    }
+
+    TESTCASE( g_counter == ( long )COUNT * ROUNDS );
+    TESTCASE( g_lock.state == 0 );
+    TESTCASE( g_lock.count == 0 );
+#endif
+#endif
+    return TEST_RESULTS;
+}
+
+#endif
@@ -0,0 +1,34 @@
+/* _PDCLIB_flock_wake( struct _PDCLIB_flock_t * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#include <stdio.h>
+
+#ifndef REGTEST
+
+#ifndef __STDC_NO_THREADS__
+
+#include "pdclib/_PDCLIB_glue.h"
+
+void _PDCLIB_flock_wake( struct _PDCLIB_flock_t * lock )
+{
+    _PDCLIB_futex_wake( &lock->state );
+}
+
+#endif
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+    /* Testing covered by _PDCLIB_flock_wait.c */
+    return TEST_RESULTS;
+}
+
+#endif
@@ -0,0 +1,53 @@
+/* _PDCLIB_fprintf_format( FILE *, const struct _PDCLIB_format_t *, ... )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#include <stdarg.h>
+#include <stdio.h>
+
+#ifndef REGTEST
+
+int _PDCLIB_fprintf_format( struct _PDCLIB_file_t * _PDCLIB_restrict stream, const struct _PDCLIB_format_t * _PDCLIB_restrict format, ... )
+{
+    int rc;
+    va_list ap;
+    va_start( ap, format );
+    rc = _PDCLIB_vfprintf_format( stream, format, ap );
+    va_end( ap );
+    return rc;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+#ifndef REGTEST
+    struct _PDCLIB_format_t * format;
+    FILE * target;
+    char buffer[ 50 ] = { 0 };
+    int i;
+
+    TESTCASE( ( target = tmpfile() ) != NULL );
+    TESTCASE( ( format = _PDCLIB_compileformat( "[%3d] %s %.2f%%\n" ) ) != NULL );
+
+    for ( i = 0; i < 3; ++i )
+    {
+        TESTCASE( _PDCLIB_fprintf_format( target, format, i, "item", i * 0.5 ) == 17 );
+    }
+
+    _PDCLIB_freeformat( format );
+    rewind( target );
+    TESTCASE( fread( buffer, 1, 51, target ) == 51 );
+    TESTCASE( memcmp( buffer, "[  0] item 0.00%\n[  1] item 0.50%\n[  2] item 1.00%\n", 51 ) == 0 );
+    TESTCASE( fclose( target ) == 0 );
+#endif
+    return TEST_RESULTS;
+}
+
+#endif
@@ -0,0 +1,369 @@
+/* _PDCLIB_fptoa( char *, size_t, int, int, int, unsigned char const *, size_t, int )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_internal.h"
+
+#include <limits.h>
+#include <stddef.h>
+#include <string.h>
+
+/* Sign, digits, decimal point, "e", exponent sign, and up to five exponent
+   digits.
+*/
+#define FPTOA_MAX ( _PDCLIB_LDBL_DECIMAL_DIG + 9 )
+
+static const _PDCLIB_decimal_limb_t pow10[ _PDCLIB_DECIMAL_LIMB_DIGITS ] =
+{
+    1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u, 100000000u
+};
+
+/* Returns the digit of N at the given position (0 being the least
+   significant).
+*/
+static int digit_at( _PDCLIB_decimal_t const * decimal, long pos )
+{
+    return ( int )( ( decimal->data[ pos / _PDCLIB_DECIMAL_LIMB_DIGITS ] / pow10[ pos % _PDCLIB_DECIMAL_LIMB_DIGITS ] ) % 10 );
+}
+
+/* Sets tail to the value of the t least significant digits of N. */
+static void tail_digits( _PDCLIB_decimal_t * tail, _PDCLIB_decimal_t const * value, long t )
+{
+    size_t limbs = ( size_t )t / _PDCLIB_DECIMAL_LIMB_DIGITS;
+
+    if ( limbs >= value->size )
+    {
+        memcpy( tail->data, value->data, value->size * sizeof( _PDCLIB_decimal_limb_t ) );
+        tail->size = value->size;
+    }
+    else
+    {
+        memcpy( tail->data, value->data, limbs * sizeof( _PDCLIB_decimal_limb_t ) );
+        tail->data[ limbs ] = value->data[ limbs ] % pow10[ t % _PDCLIB_DECIMAL_LIMB_DIGITS ];
+        tail->size = limbs + 1;
+    }
+
+    while ( tail->size > 0 && tail->data[ tail->size - 1 ] == 0 )
+    {
+        --tail->size;
+    }
+}
+
+/* Compares N of two decimals, returning less than, equal to, or greater than
+   zero, respectively.
+*/
+static int compare( _PDCLIB_decimal_t const * a, _PDCLIB_decimal_t const * b )
+{
+    size_t i = a->size;
+
+    if ( a->size != b->size )
+    {
+        return ( a->size < b->size ) ? -1 : 1;
+    }
+
+    while ( i-- > 0 )
+    {
+        if ( a->data[ i ] != b->data[ i ] )
+        {
+            return ( a->data[ i ] < b->data[ i ] ) ? -1 : 1;
+        }
+    }
+
+    return 0;
+}
+
+/* Compares N of a decimal to 10^t. */
+static int compare_pow10( _PDCLIB_decimal_t const * a, long t )
+{
+    size_t limbs = ( size_t )t / _PDCLIB_DECIMAL_LIMB_DIGITS + 1;
+    _PDCLIB_decimal_limb_t top = pow10[ t % _PDCLIB_DECIMAL_LIMB_DIGITS ];
+    size_t i = limbs - 1;
+
+    if ( a->size != limbs )
+    {
+        return ( a->size < limbs ) ? -1 : 1;
+    }
+
+    if ( a->data[ i ] != top )
+    {
+        return ( a->data[ i ] < top ) ? -1 : 1;
+    }
+
+    while ( i-- > 0 )
+    {
+        if ( a->data[ i ] != 0 )
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/* Adds N of addend to N of decimal. */
+static void add( _PDCLIB_decimal_t * decimal, _PDCLIB_decimal_t const * addend )
+{
+    _PDCLIB_decimal_limb_t carry = 0;
+    _PDCLIB_decimal_limb_t sum;
+    size_t i;
+
+    for ( i = 0; i < addend->size || carry > 0; ++i )
+    {
+        if ( i == decimal->size )
+        {
+            decimal->data[ decimal->size++ ] = 0;
+        }
+
+        sum = decimal->data[ i ] + carry + ( ( i < addend->size ) ? addend->data[ i ] : 0 );
+        carry = ( sum >= _PDCLIB_DECIMAL_LIMB_BASE );
+        decimal->data[ i ] = carry ? sum - _PDCLIB_DECIMAL_LIMB_BASE : sum;
+    }
+}
+
+/* Writes the shortest digits identifying the value of a nonzero decimal N
+   (the integer mantissa) to the given buffer, and stores the decimal
+   exponent of the first digit in x, using the decimal engine. Arguments
+   as for _PDCLIB_fptoa(), plus asymmetric as for _PDCLIB_grisu_shortest().
+   Returns the number of digits written.
+*/
+static long shortest( _PDCLIB_decimal_t * value, int exp, int dec, size_t mant_dig, int asymmetric, char * digits, long * x )
+{
+    /* V = 4 * mantissa * 2^e, and 2 * 2^e, the distance from V to the
+       boundaries of the values rounding to it -- or, if the mantissa is a
+       power of two above the subnormal range, the distance to the upper
+       boundary only (the lower being half as far).
+    */
+    _PDCLIB_decimal_t delta;
+    _PDCLIB_decimal_t scratch;
+    /* Boundaries are part of the interval if they round (to even) to V */
+    int inclusive = ( value->data[ 0 ] % 2 == 0 );
+    int low_ok;
+    int high_ok;
+    /* Less than, equal to, or greater than zero for rounding down / to even
+       / up
+    */
+    int cmp = -1;
+    int digit;
+    /* Digits of N dropped / kept */
+    long t;
+    long k;
+    long i;
+    /* Binary exponent of the mantissa's least significant bit, minus 2 */
+    int e = exp + ( dec ? 0 : 1 ) - ( int )( mant_dig - 1 ) - 2;
+
+    _PDCLIB_decimal_scale( _PDCLIB_decimal_muladd( value, 4, 0 ), e, 0 );
+    delta.size = 0;
+    _PDCLIB_decimal_scale( _PDCLIB_decimal_muladd( &delta, 1, 2 ), e, 0 );
+
+    /* Find the largest t for which V rounded down or up to a multiple of
+       10^t is within the interval. For t = 0, V itself is.
+       With delta below 10^d, a t above d requires the digits of V from
+       d to t - 1 (counting from the least significant) to be all zeroes
+       (rounding down) or all nines (rounding up), so the search starts
+       past the run of such digits from d.
+    */
+    t = delta.digits;
+    digit = ( t < value->digits ) ? digit_at( value, t ) : -1;
+
+    if ( digit == 0 || digit == 9 )
+    {
+        while ( t < value->digits && digit_at( value, t ) == digit )
+        {
+            ++t;
+        }
+    }
+
+    for ( t = ( t < value->digits ) ? t : value->digits; t > 0; --t )
+    {
+        /* Rounding down: V mod 10^t below the lower distance? */
+        tail_digits( &scratch, value, t );
+
+        if ( asymmetric )
+        {
+            _PDCLIB_decimal_muladd( &scratch, 2, 0 );
+        }
+
+        cmp = compare( &scratch, &delta );
+        low_ok = inclusive ? ( cmp <= 0 ) : ( cmp < 0 );
+
+        /* Rounding up: 10^t - V mod 10^t below the upper distance? */
+        tail_digits( &scratch, value, t );
+        add( &scratch, &delta );
+        cmp = compare_pow10( &scratch, t );
+        high_ok = inclusive ? ( cmp >= 0 ) : ( cmp > 0 );
+
+        if ( low_ok && high_ok )
+        {
+            /* Both; the closer one it is. */
+            tail_digits( &scratch, value, t );
+            cmp = compare_pow10( _PDCLIB_decimal_muladd( &scratch, 2, 0 ), t );
+            break;
+        }
+
+        if ( low_ok || high_ok )
+        {
+            cmp = high_ok ? 1 : -1;
+            break;
+        }
+    }
+
+    if ( t == 0 )
+    {
+        /* All digits needed, no rounding. */
+        cmp = -1;
+    }
+
+    k = value->digits - t;
+    *x = _PDCLIB_decimal_exp( value );
+    _PDCLIB_decimal_tostring( value, 0, k, digits );
+
+    if ( cmp > 0 || ( cmp == 0 && ( digits[ k - 1 ] - '0' ) % 2 != 0 ) )
+    {
+        /* Round up. */
+        for ( i = k - 1; i >= 0 && digits[ i ] == '9'; --i )
+        {
+            digits[ i ] = '0';
+        }
+
+        if ( i >= 0 )
+        {
+            ++digits[ i ];
+        }
+        else
+        {
+            /* Carry into a new digit. */
+            digits[ 0 ] = '1';
+            k = 1;
+            ++*x;
+        }
+    }
+
+    return k;
+}
+
+size_t _PDCLIB_fptoa( char * s, size_t n, int sign, int exp, int dec, unsigned char const * mant, size_t mant_dig, int min_exp )
+{
+    _PDCLIB_decimal_t value;
+    _PDCLIB_diyfp_t diyfp;
+    /* The shortest representation has no more digits than are required to
+       round-trip any value of the type.
+    */
+    char digits[ _PDCLIB_LDBL_DECIMAL_DIG + 1 ];
+    char buffer[ FPTOA_MAX ];
+    size_t len = 0;
+    int asymmetric;
+    /* Digits kept, decimal exponent of the first digit */
+    long k;
+    long x;
+    long i;
+
+    if ( sign )
+    {
+        buffer[ len++ ] = '-';
+    }
+
+    if ( exp == INT_MIN || exp == INT_MAX )
+    {
+        memcpy( buffer + len, ( exp == INT_MIN ) ? "nan" : "inf", 3 );
+        len += 3;
+    }
+    else if ( _PDCLIB_decimal_mant( &value, dec, mant, mant_dig )->size == 0 )
+    {
+        buffer[ len++ ] = '0';
+    }
+    else
+    {
+        /* Mantissa 1.000... */
+        asymmetric = dec && exp > min_exp && ( *mant & ( ( 1u << ( ( mant_dig - 1 ) % _PDCLIB_CHAR_BIT ) ) - 1 ) ) == 0;
+
+        for ( i = 1; asymmetric && ( size_t )i <= ( mant_dig - 1 ) / _PDCLIB_CHAR_BIT; ++i )
+        {
+            asymmetric = ( *( mant _PDCLIB_FLT_OP i ) == 0 );
+        }
+
+        /* Grisu if possible, the exact search if undecided. */
+        if ( mant_dig > _PDCLIB_DIYFP_MANT_DIG || ( k = _PDCLIB_grisu_shortest( _PDCLIB_diyfp_fp( &diyfp, exp, dec, mant, mant_dig ), asymmetric, digits, &x ) ) == 0 )
+        {
+            k = shortest( &value, exp, dec, mant_dig, asymmetric, digits, &x );
+        }
+
+        while ( digits[ k - 1 ] == '0' )
+        {
+            --k;
+        }
+
+        /* Fixed or scientific notation, whichever is shorter (fixed on a
+           tie). The exponent has at least two digits, as for printf().
+        */
+        if ( ( ( x >= k - 1 ) ? x + 1 : ( ( x >= 0 ) ? k + 1 : k + 1 - x ) )
+             <= k + ( k > 1 ) + 2 + ( ( x >= 1000 || x <= -1000 ) ? 4 : ( x >= 100 || x <= -100 ) ? 3 : 2 ) )
+        {
+            if ( x < 0 )
+            {
+                buffer[ len++ ] = '0';
+                buffer[ len++ ] = '.';
+
+                for ( i = x + 1; i < 0; ++i )
+                {
+                    buffer[ len++ ] = '0';
+                }
+            }
+
+            for ( i = 0; i < k || i <= x; ++i )
+            {
+                if ( x >= 0 && i == x + 1 )
+                {
+                    buffer[ len++ ] = '.';
+                }
+
+                buffer[ len++ ] = ( i < k ) ? digits[ i ] : '0';
+            }
+        }
+        else
+        {
+            buffer[ len++ ] = digits[ 0 ];
+
+            if ( k > 1 )
+            {
+                buffer[ len++ ] = '.';
+                memcpy( buffer + len, digits + 1, ( size_t )( k - 1 ) );
+                len += ( size_t )( k - 1 );
+            }
+
+            buffer[ len++ ] = 'e';
+            buffer[ len++ ] = ( x < 0 ) ? '-' : '+';
+            x = ( x < 0 ) ? -x : x;
+
+            for ( i = ( x >= 1000 ) ? 1000 : ( x >= 100 ) ? 100 : 10; i > 0; i /= 10 )
+            {
+                buffer[ len++ ] = ( char )( '0' + ( x / i ) % 10 );
+            }
+        }
+    }
+
+    if ( len > n )
+    {
+        return 0;
+    }
+
+    memcpy( s, buffer, len );
+    return len;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+    /* Testing covered by _PDCLIB_dtoa.c and _PDCLIB_ldtoa.c */
+    return TEST_RESULTS;
+}
+
+#endif
@@ -0,0 +1,102 @@
+/* _PDCLIB_fread_unlocked( void *, size_t, size_t, struct _PDCLIB_file_t * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_glue.h"
+
+_PDCLIB_size_t _PDCLIB_fread_unlocked( void * _PDCLIB_restrict ptr, _PDCLIB_size_t size, _PDCLIB_size_t nmemb, struct _PDCLIB_file_t * _PDCLIB_restrict stream )
+{
+    char * dest = ( char * )ptr;
+    size_t total;
+    size_t done = 0;
+
+    if ( size == 0 || nmemb == 0 )
+    {
+        return 0;
+    }
+
+    /* No object is larger than SIZE_MAX, so a size * nmemb that does not
+       fit cannot be read into ptr in full anyway.
+    */
+    if ( nmemb > _PDCLIB_SIZE_MAX / size )
+    {
+        nmemb = _PDCLIB_SIZE_MAX / size;
+    }
+
+    total = size * nmemb;
+
+    if ( _PDCLIB_prepread( stream ) != EOF )
+    {
+        /* Characters pushed back by ungetc() come first. */
+        while ( stream->ungetidx > 0 && done < total )
+        {
+            dest[ done++ ] = stream->ungetbuf[ --stream->ungetidx ];
+        }
+
+        while ( done < total )
+        {
+            size_t count = stream->bufend - stream->bufidx;
+
+            if ( count > 0 )
+            {
+                /* Move whatever is buffered in one go. */
+                if ( count > total - done )
+                {
+                    count = total - done;
+                }
+
+                memcpy( dest + done, stream->buffer + stream->bufidx, count );
+                stream->bufidx += count;
+                done += count;
+            }
+            else if ( ( total - done >= stream->bufsize ) && ! ( stream->status & ( _PDCLIB_FMMAP | _PDCLIB_FAHEAD | _PDCLIB_FDIRECT ) ) )
+            {
+                /* Buffer is empty, and the remaining request would not fit
+                   it anyway. Reading directly into the destination saves
+                   copying everything through the buffer. (Not so for a
+                   memory-mapped stream, whose buffer is the whole file, a
+                   read-ahead stream, which does positioned reads, or a
+                   direct I/O stream, which needs the aligned buffer.)
+                */
+                if ( ( count = _PDCLIB_read( stream, dest + done, total - done ) ) == 0 )
+                {
+                    /* EOF / error, flags already set */
+                    break;
+                }
+
+                done += count;
+            }
+            else if ( _PDCLIB_fillbuffer( stream ) == EOF )
+            {
+                /* Could not read requested data */
+                break;
+            }
+        }
+    }
+
+    /* Only completely read objects count; a partially read object at the
+       end is consumed, but not reported.
+    */
+    return done / size;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+    /* Testing covered by fread.c */
+    return TEST_RESULTS;
+}
+
+#endif
@@ -0,0 +1,33 @@
+/* _PDCLIB_freeformat( struct _PDCLIB_format_t * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifndef REGTEST
+
+void _PDCLIB_freeformat( struct _PDCLIB_format_t * format )
+{
+    /* Ops and literal text are part of the same allocation. */
+    free( format );
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+#ifndef REGTEST
+    /* Testing covered by _PDCLIB_compileformat.c; NULL is ignored */
+    _PDCLIB_freeformat( NULL );
+#endif
+    return TEST_RESULTS;
+}
+
+#endif
@@ -0,0 +1,188 @@
+/* _PDCLIB_fwrite_unlocked( const void *, size_t, size_t, struct _PDCLIB_file_t * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_glue.h"
+
+/* Returns the offset one past the last newline among the first n characters
+   of s, or zero if there is none. Checks a word at a time where possible
+   (see _PDCLIB_wordhasbyte()).
+*/
+static size_t lastnewline( const char * s, size_t n )
+{
+    /* Byte-wise until the end of the range is word-aligned. */
+    while ( n > 0 && ( ( _PDCLIB_uintptr_t )( s + n ) % sizeof( size_t ) ) != 0 )
+    {
+        if ( s[ --n ] == '\n' )
+        {
+            return n + 1;
+        }
+    }
+
+    /* Word-wise, skipping words that do not contain a newline. */
+    while ( n >= sizeof( size_t ) )
+    {
+        if ( _PDCLIB_wordhasbyte( s + n - sizeof( size_t ), '\n' ) )
+        {
+            break;
+        }
+
+        n -= sizeof( size_t );
+    }
+
+    /* Byte-wise through the word holding the newline (or the remains). */
+    while ( n > 0 )
+    {
+        if ( s[ --n ] == '\n' )
+        {
+            return n + 1;
+        }
+    }
+
+    return 0;
+}
+
+_PDCLIB_size_t _PDCLIB_fwrite_unlocked( const void * _PDCLIB_restrict ptr, _PDCLIB_size_t size, _PDCLIB_size_t nmemb, struct _PDCLIB_file_t * _PDCLIB_restrict stream )
+{
+    const char * src = ( const char * )ptr;
+    size_t total;
+    size_t done = 0;
+    /* Where the data written by this call starts in the buffer */
+    size_t start;
+
+    if ( size == 0 || nmemb == 0 )
+    {
+        return 0;
+    }
+
+    /* No object is larger than SIZE_MAX (see _PDCLIB_fread_unlocked()). */
+    if ( nmemb > _PDCLIB_SIZE_MAX / size )
+    {
+        nmemb = _PDCLIB_SIZE_MAX / size;
+    }
+
+    total = size * nmemb;
+
+    if ( _PDCLIB_prepwrite( stream ) == EOF )
+    {
+        return 0;
+    }
+
+    start = stream->bufidx;
+
+    if ( ( total >= stream->bufsize ) && ! ( stream->status & ( _PDCLIB_FBEHIND | _PDCLIB_FDIRECT ) ) )
+    {
+        /* The payload would fill the buffer completely anyway. Writing
+           buffer contents and payload with one gathered write saves both
+           copying the payload through the buffer, and a separate system
+           call for flushing the buffer. (Not so for a write-behind stream,
+           whose buffers are written by its worker thread, or a direct I/O
+           stream, which needs the aligned buffer.)
+        */
+        struct _PDCLIB_iovec_t iov;
+        iov.base = src;
+        iov.len = total;
+
+        if ( ( done = _PDCLIB_writev( stream, &iov, 1 ) ) < total )
+        {
+            /* Returning number of objects completely written */
+            return done / size;
+        }
+
+        start = 0;
+    }
+
+    while ( done < total )
+    {
+        size_t count = stream->bufsize - stream->bufidx;
+
+        if ( count > total - done )
+        {
+            count = total - done;
+        }
+
+        memcpy( stream->buffer + stream->bufidx, src + done, count );
+        stream->bufidx += count;
+        done += count;
+
+        if ( stream->bufidx == stream->bufsize )
+        {
+            if ( _PDCLIB_flushbuffer( stream ) == EOF )
+            {
+                /* Returning number of objects completely buffered */
+                return done / size;
+            }
+
+            start = 0;
+        }
+    }
+
+    /* Fully-buffered streams are OK. Non-buffered streams must be flushed,
+       line-buffered streams only if there's a newline in the buffer.
+    */
+    switch ( stream->status & ( _IONBF | _IOLBF ) )
+    {
+        case _IONBF:
+            if ( _PDCLIB_flushbuffer( stream ) == EOF )
+            {
+                /* We are in a pinch here. We have an error, which requires a
+                   return value < nmemb. On the other hand, all objects have
+                   been written to buffer, which means all the caller had to
+                   do was removing the error cause, and re-flush the stream...
+                   Catch 22. We'll return a value one short, to indicate the
+                   error, and can't really do anything about the inconsistency.
+                */
+                return nmemb - 1;
+            }
+
+            break;
+
+        case _IOLBF:
+        {
+            /* Line-buffered streams are flushed after each newline, so only
+               the characters added by this call need to be searched.
+            */
+            size_t offset = lastnewline( stream->buffer + start, stream->bufidx - start );
+
+            if ( offset > 0 )
+            {
+                size_t bufidx = stream->bufidx;
+                offset += start;
+                stream->bufidx = offset;
+
+                if ( _PDCLIB_flushbuffer( stream ) == EOF )
+                {
+                    /* See comment above. */
+                    stream->bufidx = bufidx;
+                    return nmemb - 1;
+                }
+
+                stream->bufidx = bufidx - offset;
+                memmove( stream->buffer, stream->buffer + offset, stream->bufidx );
+            }
+        }
+    }
+
+    return nmemb;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+    /* Testing covered by fwrite.c */
+    return TEST_RESULTS;
+}
+
+#endif
@@ -14,23 +14,28 @@ extern struct _PDCLIB_file_t * _PDCLIB_filelist;
 
 int _PDCLIB_getstream( struct _PDCLIB_file_t * stream )
 {
-    struct _PDCLIB_file_t * previous;
-
-    if ( ! _PDCLIB_isstream( stream, &previous ) )
+    if ( ! _PDCLIB_isstream( stream ) )
     {
         *_PDCLIB_errno_func() = _PDCLIB_EBADF;
         return EOF;
     }
 
-    if ( previous != NULL )
+    if ( stream->prev != NULL )
     {
-        previous->next = stream->next;
+        stream->prev->next = stream->next;
     }
     else
     {
         _PDCLIB_filelist = stream->next;
     }
 
+    if ( stream->next != NULL )
+    {
+        stream->next->prev = stream->prev;
+    }
+
+    /* No longer a valid stream */
+    stream->tag = 0;
     return 0;
 }
 
@@ -42,7 +47,7 @@ int _PDCLIB_getstream( struct _PDCLIB_file_t * stream )
 
 int main( void )
 {
-    /* No testdriver */
+    /* Testing covered by _PDCLIB_isstream.c and fclose.c */
     return TEST_RESULTS;
 }
 
@@ -0,0 +1,205 @@
+/* _PDCLIB_grisu_counted( _PDCLIB_diyfp_t const *, int, char *, long * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_internal.h"
+
+#include <stddef.h>
+
+/* Shifts f so that its most significant bit is set. */
+static void normalize( _PDCLIB_diyfp_t * diyfp )
+{
+    while ( ! ( diyfp->f >> 63 ) )
+    {
+        diyfp->f <<= 1;
+        --diyfp->e;
+    }
+}
+
+/* Rounds the len digits (the last worth ten_kappa) to nearest, given the
+   rest below them and its error unit, carrying into kappa if all digits
+   were nines (Grisu3's "round_weed_counted").
+   Returns nonzero if the rounding direction is certain, zero if the rest
+   is too close to half of ten_kappa to tell (including actual ties).
+*/
+static int weed( char * digits, int len, _PDCLIB_uint_least64_t rest, _PDCLIB_uint_least64_t ten_kappa, _PDCLIB_uint_least64_t unit, int * kappa )
+{
+    int i;
+
+    if ( unit >= ten_kappa || ten_kappa - unit <= unit )
+    {
+        return 0;
+    }
+
+    /* Certainly below half: round down. */
+    if ( ten_kappa - rest > rest && ten_kappa - 2 * rest >= 2 * unit )
+    {
+        return 1;
+    }
+
+    /* Certainly above half: round up. */
+    if ( rest > unit && ten_kappa - ( rest - unit ) <= rest - unit )
+    {
+        ++digits[ len - 1 ];
+
+        for ( i = len - 1; i > 0 && digits[ i ] == '0' + 10; --i )
+        {
+            digits[ i ] = '0';
+            ++digits[ i - 1 ];
+        }
+
+        if ( digits[ 0 ] == '0' + 10 )
+        {
+            digits[ 0 ] = '1';
+            ++*kappa;
+        }
+
+        return 1;
+    }
+
+    return 0;
+}
+
+int _PDCLIB_grisu_counted( _PDCLIB_diyfp_t const * v, int count, char * digits, long * x )
+{
+    _PDCLIB_diyfp_t w = *v;
+    _PDCLIB_diyfp_t power;
+    /* One, at the exponent of the scaled value */
+    _PDCLIB_uint_least64_t one;
+    /* Error of the scaled value */
+    _PDCLIB_uint_least64_t unit = 1;
+    _PDCLIB_uint_least64_t fractionals;
+    _PDCLIB_uint_least32_t integrals;
+    _PDCLIB_uint_least32_t divisor;
+    int shift;
+    int kappa;
+    int k;
+    int len = 0;
+    int rc;
+
+    normalize( &w );
+
+    if ( _PDCLIB_diyfp_pow10( &power, w.e, &k ) == NULL )
+    {
+        return 0;
+    }
+
+    /* Scaled by 10^k, w is off by less than one unit. */
+    _PDCLIB_diyfp_mul( &w, &power );
+
+    shift = -w.e;
+    one = _PDCLIB_UINT_LEAST64_C( 1 ) << shift;
+    integrals = ( _PDCLIB_uint_least32_t )( w.f >> shift );
+    fractionals = w.f & ( one - 1 );
+
+    /* Integral digits first (of which there is at least one)... */
+    for ( divisor = 1, kappa = 1; integrals / divisor >= 10; divisor *= 10, ++kappa )
+    {
+        /* EMPTY */
+    }
+
+    while ( kappa > 0 && len < count )
+    {
+        digits[ len++ ] = ( char )( '0' + integrals / divisor );
+        integrals %= divisor;
+        --kappa;
+
+        if ( len < count )
+        {
+            divisor /= 10;
+        }
+    }
+
+    if ( len == count )
+    {
+        rc = weed( digits, len, ( ( _PDCLIB_uint_least64_t )integrals << shift ) + fractionals, ( _PDCLIB_uint_least64_t )divisor << shift, unit, &kappa );
+    }
+    else
+    {
+        /* ...then fractional ones, scaling the error along, as long as it
+           leaves the digits reliable.
+        */
+        while ( len < count && fractionals > unit )
+        {
+            fractionals *= 10;
+            unit *= 10;
+            digits[ len++ ] = ( char )( '0' + ( fractionals >> shift ) );
+            fractionals &= one - 1;
+            --kappa;
+        }
+
+        rc = ( len == count ) && weed( digits, len, fractionals, one, unit, &kappa );
+    }
+
+    /* The digits are worth 10^( kappa - k ) each. */
+    *x = ( long )kappa - k + len - 1;
+    return rc;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+#include <limits.h>
+#include <string.h>
+
+#ifndef REGTEST
+
+static int check( double value, char const * expect, long expect_x )
+{
+    unsigned char bytes[ sizeof( double ) ];
+    _PDCLIB_diyfp_t diyfp;
+    char digits[ _PDCLIB_DBL_DECIMAL_DIG ];
+    int count = ( int )strlen( expect );
+    long x;
+
+    memcpy( bytes, &value, sizeof( double ) );
+    _PDCLIB_diyfp_fp( &diyfp,
+                      ( int )_PDCLIB_DBL_EXP( bytes ) - _PDCLIB_DBL_BIAS,
+                      _PDCLIB_DBL_DEC( bytes ),
+                      _PDCLIB_DBL_MANT_START( bytes ),
+                      _PDCLIB_DBL_MANT_DIG );
+
+    if ( expect_x == LONG_MIN )
+    {
+        /* Expecting the result to be undecided */
+        return ! _PDCLIB_grisu_counted( &diyfp, count, digits, &x );
+    }
+
+    return _PDCLIB_grisu_counted( &diyfp, count, digits, &x ) && memcmp( digits, expect, count ) == 0 && x == expect_x;
+}
+
+#endif
+
+int main( void )
+{
+#ifndef REGTEST
+    TESTCASE( check( 1.0, "100", 0 ) );
+    TESTCASE( check( 0.1, "10000000000000001", -1 ) );
+    TESTCASE( check( 2.0 / 3.0, "66667", -1 ) );
+    TESTCASE( check( 123456.789, "1235", 5 ) );
+    TESTCASE( check( 3.141592653589793, "3141593", 0 ) );
+    TESTCASE( check( 1e23, "99999999999999992", 22 ) );
+    /* Carry into a new leading digit */
+    TESTCASE( check( 9.9996, "1000", 1 ) );
+    TESTCASE( check( 999999.5001, "1", 6 ) );
+    /* Limits */
+    TESTCASE( check( 2.2250738585072014e-308, "22250738585072014", -308 ) );
+    TESTCASE( check( 1.7976931348623157e308, "179769", 308 ) );
+    TESTCASE( check( 4.9406564584124654e-324, "494", -324 ) );
+    TESTCASE( check( 1.5e-310, "15", -310 ) );
+    /* Ties are left to the caller */
+    TESTCASE( check( 0.125, "12", LONG_MIN ) );
+    TESTCASE( check( 1.5, "1", LONG_MIN ) );
+    TESTCASE( check( 2.5, "2", LONG_MIN ) );
+#endif
+    return TEST_RESULTS;
+}
+
+#endif
@@ -0,0 +1,219 @@
+/* _PDCLIB_grisu_shortest( _PDCLIB_diyfp_t const *, int, char *, long * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_internal.h"
+
+#include <stddef.h>
+
+/* Shifts f so that its most significant bit is set. */
+static void normalize( _PDCLIB_diyfp_t * diyfp )
+{
+    while ( ! ( diyfp->f >> 63 ) )
+    {
+        diyfp->f <<= 1;
+        --diyfp->e;
+    }
+}
+
+/* Moves the last of len digits (worth ten_kappa each) closer to w, as long
+   as that stays within the unsafe interval. rest is the distance from the
+   digits to too_high, distance the one from w to too_high, unit the error
+   of both (Grisu3's "round_weed").
+   Returns nonzero if the result is certainly the one closest to the real w,
+   and within the real interval.
+*/
+static int weed( char * digits, int len, _PDCLIB_uint_least64_t distance, _PDCLIB_uint_least64_t unsafe, _PDCLIB_uint_least64_t rest, _PDCLIB_uint_least64_t ten_kappa, _PDCLIB_uint_least64_t unit )
+{
+    /* Distances from too_high to the real w, at the least and the most */
+    _PDCLIB_uint_least64_t small = distance - unit;
+    _PDCLIB_uint_least64_t big = distance + unit;
+
+    /* Decrement the last digit while that brings it closer to w (taken to be
+       as far from too_high as possible).
+    */
+    while ( rest < small && unsafe - rest >= ten_kappa && ( rest + ten_kappa < small || small - rest >= rest + ten_kappa - small ) )
+    {
+        --digits[ len - 1 ];
+        rest += ten_kappa;
+    }
+
+    /* If the next lower one would be closer to w taken as near to too_high
+       as possible, it is undecided which one is closest.
+    */
+    if ( rest < big && unsafe - rest >= ten_kappa && ( rest + ten_kappa < big || big - rest > rest + ten_kappa - big ) )
+    {
+        return 0;
+    }
+
+    /* Within the safe interval (the unsafe one narrowed by the error)? */
+    return ( 2 * unit <= rest ) && ( rest <= unsafe - 4 * unit );
+}
+
+int _PDCLIB_grisu_shortest( _PDCLIB_diyfp_t const * v, int asymmetric, char * digits, long * x )
+{
+    _PDCLIB_diyfp_t w = *v;
+    _PDCLIB_diyfp_t low;
+    _PDCLIB_diyfp_t high;
+    _PDCLIB_diyfp_t power;
+    /* One, at the exponent of the scaled values */
+    _PDCLIB_uint_least64_t one;
+    /* Error of the scaled values */
+    _PDCLIB_uint_least64_t unit = 1;
+    _PDCLIB_uint_least64_t unsafe;
+    _PDCLIB_uint_least64_t fractionals;
+    _PDCLIB_uint_least64_t rest;
+    _PDCLIB_uint_least32_t integrals;
+    _PDCLIB_uint_least32_t divisor;
+    int shift;
+    int kappa;
+    int k;
+    int len = 0;
+    int rc;
+
+    /* The boundaries, halfway to the neighbouring values, at the exponent
+       of the normalized w.
+    */
+    high.f = ( v->f << 1 ) + 1;
+    high.e = v->e - 1;
+    normalize( &high );
+
+    if ( asymmetric )
+    {
+        low.f = ( v->f << 2 ) - 1;
+        low.e = v->e - 2;
+    }
+    else
+    {
+        low.f = ( v->f << 1 ) - 1;
+        low.e = v->e - 1;
+    }
+
+    low.f <<= low.e - high.e;
+    low.e = high.e;
+    normalize( &w );
+
+    if ( _PDCLIB_diyfp_pow10( &power, w.e, &k ) == NULL )
+    {
+        return 0;
+    }
+
+    /* Scaled by 10^k, each value is off by less than one unit; widened by
+       that, the boundaries give the "unsafe" interval, which contains any
+       value that might be within the real one.
+    */
+    _PDCLIB_diyfp_mul( &w, &power );
+    _PDCLIB_diyfp_mul( &low, &power );
+    _PDCLIB_diyfp_mul( &high, &power );
+    low.f -= unit;
+    high.f += unit;
+    unsafe = high.f - low.f;
+
+    shift = -w.e;
+    one = _PDCLIB_UINT_LEAST64_C( 1 ) << shift;
+    integrals = ( _PDCLIB_uint_least32_t )( high.f >> shift );
+    fractionals = high.f & ( one - 1 );
+
+    /* Digits of too_high, until the rest is within the unsafe interval.
+       Integral digits first (of which there is at least one)...
+    */
+    for ( divisor = 1, kappa = 1; integrals / divisor >= 10; divisor *= 10, ++kappa )
+    {
+        /* EMPTY */
+    }
+
+    for ( ;; )
+    {
+        if ( kappa > 0 )
+        {
+            digits[ len++ ] = ( char )( '0' + integrals / divisor );
+            integrals %= divisor;
+            --kappa;
+            rest = ( ( _PDCLIB_uint_least64_t )integrals << shift ) + fractionals;
+
+            if ( rest < unsafe )
+            {
+                rc = weed( digits, len, high.f - w.f, unsafe, rest, ( _PDCLIB_uint_least64_t )divisor << shift, unit );
+                break;
+            }
+
+            divisor /= 10;
+        }
+        else
+        {
+            /* ...then fractional ones, scaling the error along. */
+            fractionals *= 10;
+            unit *= 10;
+            unsafe *= 10;
+            digits[ len++ ] = ( char )( '0' + ( fractionals >> shift ) );
+            fractionals &= one - 1;
+            --kappa;
+
+            if ( fractionals < unsafe )
+            {
+                rc = weed( digits, len, ( high.f - w.f ) * unit, unsafe, fractionals, one, unit );
+                break;
+            }
+        }
+    }
+
+    /* The digits are worth 10^( kappa - k ) each. */
+    *x = ( long )kappa - k + len - 1;
+    return rc ? len : 0;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+#include <string.h>
+
+#ifndef REGTEST
+
+static int check( double value, char const * expect, long expect_x )
+{
+    unsigned char bytes[ sizeof( double ) ];
+    _PDCLIB_diyfp_t diyfp;
+    char digits[ _PDCLIB_DBL_DECIMAL_DIG ];
+    long x;
+    int len;
+
+    memcpy( bytes, &value, sizeof( double ) );
+    _PDCLIB_diyfp_fp( &diyfp,
+                      ( int )_PDCLIB_DBL_EXP( bytes ) - _PDCLIB_DBL_BIAS,
+                      _PDCLIB_DBL_DEC( bytes ),
+                      _PDCLIB_DBL_MANT_START( bytes ),
+                      _PDCLIB_DBL_MANT_DIG );
+    len = _PDCLIB_grisu_shortest( &diyfp, diyfp.f == ( _PDCLIB_UINT_LEAST64_C( 1 ) << 52 ) && diyfp.e > -1074, digits, &x );
+    return len == ( int )strlen( expect ) && memcmp( digits, expect, len ) == 0 && x == expect_x;
+}
+
+#endif
+
+int main( void )
+{
+#ifndef REGTEST
+    TESTCASE( check( 1.0, "1", 0 ) );
+    TESTCASE( check( 0.1, "1", -1 ) );
+    TESTCASE( check( 123456.789, "123456789", 5 ) );
+    TESTCASE( check( 3.141592653589793, "3141592653589793", 0 ) );
+    TESTCASE( check( 1e22, "1", 22 ) );
+    TESTCASE( check( 1.2345e-300, "12345", -300 ) );
+    TESTCASE( check( 2.2250738585072014e-308, "22250738585072014", -308 ) );
+    TESTCASE( check( 1.7976931348623157e308, "17976931348623157", 308 ) );
+    /* Subnormal */
+    TESTCASE( check( 1.5e-310, "15", -310 ) );
+    /* Power of two, lower neighbour closer */
+    TESTCASE( check( 9007199254740992.0, "9007199254740992", 15 ) );
+    TESTCASE( check( 4.9406564584124654e-324, "5", -324 ) );
+#endif
+    return TEST_RESULTS;
+}
+
+#endif
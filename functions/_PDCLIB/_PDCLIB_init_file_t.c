@@ -9,6 +9,7 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #ifndef __STDC_NO_THREADS__
 #include <threads.h>
@@ -25,37 +26,46 @@ struct _PDCLIB_file_t * _PDCLIB_init_file_t( struct _PDCLIB_file_t * stream )
             /* No memory */
             return NULL;
         }
-    }
 
-    if ( ( rc->buffer = (char *)malloc( BUFSIZ ) ) == NULL )
-    {
-        /* No memory */
-        free( rc );
-        return NULL;
+        rc->refs = 0;
+#ifdef _PDCLIB_STREAMSTATS
+        /* Kept over freopen() */
+        memset( &rc->stats, 0, sizeof( rc->stats ) );
+#endif
     }
 
-    rc->bufsize = BUFSIZ;
+    rc->cookie = NULL;
+
+    /* The buffer is allocated on first read / write (see
+       _PDCLIB_allocbuffer()), when the file it is used for is known,
+       and setvbuf() had its chance to request a size.
+    */
+    rc->buffer = NULL;
+    rc->bufsize = 0;
     rc->bufidx = 0;
     rc->bufend = 0;
     rc->pos.offset = 0;
     rc->pos.status = 0;
     rc->ungetidx = 0;
     rc->status = _PDCLIB_FREEBUFFER;
+    /* Not on the list of open files (yet) */
+    rc->tag = 0;
 
 #ifndef __STDC_NO_THREADS__
 
+    rc->async = NULL;
+
     if ( stream == NULL )
     {
-        /* If called by freopen() (stream not NULL), mutex is already
-           initialized.
+        /* If called by freopen() (stream not NULL), lock is already
+           initialized (and held).
         */
-        if ( mtx_init( &rc->mtx, mtx_plain | mtx_recursive ) != thrd_success )
-        {
-            /* could not initialize stream mutex */
-            free( rc->buffer );
-            free( rc );
-            return NULL;
-        }
+        rc->lock.state = 0;
+        rc->lock.count = 0;
+        rc->lock.owner = 0;
+#ifdef _PDCLIB_STREAMSTATS
+        rc->lock.contentions = 0;
+#endif
     }
 
 #endif
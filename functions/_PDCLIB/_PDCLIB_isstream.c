@@ -1,4 +1,4 @@
-/* _PDCLIB_isstream( FILE *, FILE ** )
+/* _PDCLIB_isstream( FILE * )
 
    This file is part of the Public Domain C Library (PDCLib).
    Permission is granted to use, modify, and / or redistribute at will.
@@ -10,28 +10,9 @@
 
 #include "pdclib/_PDCLIB_internal.h"
 
-extern struct _PDCLIB_file_t * _PDCLIB_filelist;
-
-int _PDCLIB_isstream( struct _PDCLIB_file_t * stream, struct _PDCLIB_file_t ** previous )
+int _PDCLIB_isstream( struct _PDCLIB_file_t * stream )
 {
-    struct _PDCLIB_file_t * current = _PDCLIB_filelist;
-
-    if ( previous != NULL )
-    {
-        *previous = NULL;
-    }
-
-    while ( ( current != NULL ) && ( current != stream ) )
-    {
-        if ( previous != NULL )
-        {
-            *previous = current;
-        }
-
-        current = current->next;
-    }
-
-    return current != NULL;
+    return ( stream != NULL ) && ( stream->tag == _PDCLIB_FILE_TAG );
 }
 
 #endif
@@ -42,7 +23,21 @@ int _PDCLIB_isstream( struct _PDCLIB_file_t * stream, struct _PDCLIB_file_t ** p
 
 int main( void )
 {
-    /* No testdriver */
+#ifndef REGTEST
+    FILE * fh;
+    TESTCASE( _PDCLIB_isstream( stdin ) );
+    TESTCASE( _PDCLIB_isstream( stdout ) );
+    TESTCASE( _PDCLIB_isstream( stderr ) );
+    TESTCASE( ! _PDCLIB_isstream( NULL ) );
+    TESTCASE( ( fh = tmpfile() ) != NULL );
+    TESTCASE( _PDCLIB_isstream( fh ) );
+    TESTCASE( _PDCLIB_getstream( fh ) == 0 );
+    TESTCASE( ! _PDCLIB_isstream( fh ) );
+    TESTCASE( _PDCLIB_getstream( fh ) == EOF );
+    _PDCLIB_putstream( fh );
+    TESTCASE( _PDCLIB_isstream( fh ) );
+    TESTCASE( fclose( fh ) == 0 );
+#endif
     return TEST_RESULTS;
 }
 
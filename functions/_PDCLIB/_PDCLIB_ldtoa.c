@@ -0,0 +1,81 @@
+/* _PDCLIB_ldtoa( char *, size_t, long double )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#include <stdlib.h>
+
+#ifndef REGTEST
+
+#include <limits.h>
+#include <string.h>
+
+size_t _PDCLIB_ldtoa( char * s, size_t n, long double value )
+{
+    unsigned char bytes[ sizeof( long double ) ];
+    int exp;
+    memcpy( bytes, &value, sizeof( long double ) );
+    exp = _PDCLIB_LDBL_EXP( bytes ) - _PDCLIB_LDBL_BIAS;
+
+    if ( exp == _PDCLIB_LDBL_MAX_EXP )
+    {
+        /*                           NAN       INF */
+        exp = ( value != value ) ? INT_MIN : INT_MAX;
+    }
+
+    return _PDCLIB_fptoa( s, n,
+                          _PDCLIB_LDBL_SIGN( bytes ),
+                          exp,
+                          _PDCLIB_LDBL_DEC( bytes ),
+                          _PDCLIB_LDBL_MANT_START( bytes ),
+                          _PDCLIB_LDBL_MANT_DIG,
+                          1 - _PDCLIB_LDBL_BIAS );
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+#include <float.h>
+#include <string.h>
+
+#ifndef REGTEST
+
+static int check( long double value, char const * expect )
+{
+    char buffer[ _PDCLIB_LDTOA_CHARS ];
+    size_t len = _PDCLIB_ldtoa( buffer, sizeof( buffer ), value );
+    return len == strlen( expect ) && memcmp( buffer, expect, len ) == 0;
+}
+
+#endif
+
+int main( void )
+{
+#ifndef REGTEST
+    long double zero = 0.0L;
+
+    TESTCASE( check( 0.0L, "0" ) );
+    TESTCASE( check( -0.0L, "-0" ) );
+    TESTCASE( check( 1.0L, "1" ) );
+    TESTCASE( check( 0.5L, "0.5" ) );
+    TESTCASE( check( -123.0L, "-123" ) );
+    TESTCASE( check( 1e22L, "1e+22" ) );
+    TESTCASE( check( 1.0L / zero, "inf" ) );
+    TESTCASE( check( -1.0L / zero, "-inf" ) );
+#if LDBL_MANT_DIG == 64
+    TESTCASE( check( 0.1L, "0.1" ) );
+    TESTCASE( check( 2.0L / 3.0L, "0.6666666666666666667" ) );
+    TESTCASE( check( 0.1, "0.10000000000000000555" ) );
+    TESTCASE( check( LDBL_MAX, "1.189731495357231765e+4932" ) );
+    TESTCASE( check( LDBL_MIN, "3.3621031431120935063e-4932" ) );
+    TESTCASE( check( 0x1p-16445L, "4e-4951" ) );
+#endif
+#endif
+    return TEST_RESULTS;
+}
+
+#endif
@@ -0,0 +1,40 @@
+/* _PDCLIB_memclose( void * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_internal.h"
+
+int _PDCLIB_memclose( void * cookie )
+{
+    struct _PDCLIB_memfile_t * mem = (struct _PDCLIB_memfile_t *)cookie;
+
+    if ( mem->freedata )
+    {
+        /* Allocated by fmemopen() */
+        free( mem->data );
+    }
+
+    free( mem );
+    return 0;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+    /* Testing covered by fmemopen.c and open_memstream.c */
+    return TEST_RESULTS;
+}
+
+#endif
@@ -0,0 +1,47 @@
+/* _PDCLIB_memread( void *, char *, size_t )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_internal.h"
+
+_PDCLIB_ptrdiff_t _PDCLIB_memread( void * cookie, char * buf, _PDCLIB_size_t size )
+{
+    struct _PDCLIB_memfile_t * mem = (struct _PDCLIB_memfile_t *)cookie;
+    _PDCLIB_size_t count = 0;
+
+    if ( mem->pos < mem->size )
+    {
+        count = mem->size - mem->pos;
+
+        if ( count > size )
+        {
+            count = size;
+        }
+
+        memcpy( buf, mem->data + mem->pos, count );
+        mem->pos += count;
+    }
+
+    return ( _PDCLIB_ptrdiff_t )count;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+    /* Testing covered by fmemopen.c */
+    return TEST_RESULTS;
+}
+
+#endif
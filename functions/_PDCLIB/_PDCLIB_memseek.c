@@ -0,0 +1,68 @@
+/* _PDCLIB_memseek( void *, int_least64_t *, int )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#include <stdio.h>
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_internal.h"
+
+int _PDCLIB_memseek( void * cookie, _PDCLIB_int_least64_t * offset, int whence )
+{
+    struct _PDCLIB_memfile_t * mem = (struct _PDCLIB_memfile_t *)cookie;
+    _PDCLIB_int_least64_t pos = *offset;
+
+    switch ( whence )
+    {
+        case SEEK_SET:
+            break;
+
+        case SEEK_CUR:
+            pos += mem->pos;
+            break;
+
+        case SEEK_END:
+            pos += mem->size;
+            break;
+
+        default:
+            *_PDCLIB_errno_func() = _PDCLIB_EINVAL;
+            return -1;
+    }
+
+    /* A fmemopen() buffer cannot be positioned beyond; an open_memstream()
+       buffer grows when written to.
+    */
+    if ( pos < 0 || ( mem->bufp == NULL && ( _PDCLIB_uint_least64_t )pos > mem->capacity ) )
+    {
+        *_PDCLIB_errno_func() = _PDCLIB_EINVAL;
+        return -1;
+    }
+
+    mem->pos = ( _PDCLIB_size_t )pos;
+
+    if ( mem->bufp != NULL )
+    {
+        *mem->sizep = ( mem->pos < mem->size ) ? mem->pos : mem->size;
+    }
+
+    *offset = pos;
+    return 0;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+    /* Testing covered by fmemopen.c and open_memstream.c */
+    return TEST_RESULTS;
+}
+
+#endif
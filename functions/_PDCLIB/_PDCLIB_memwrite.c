@@ -0,0 +1,164 @@
+/* _PDCLIB_memwrite( void *, const char *, size_t )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_internal.h"
+
+_PDCLIB_ptrdiff_t _PDCLIB_memwrite( void * cookie, const char * buf, _PDCLIB_size_t size )
+{
+    struct _PDCLIB_memfile_t * mem = (struct _PDCLIB_memfile_t *)cookie;
+    _PDCLIB_size_t count = size;
+
+    if ( mem->append )
+    {
+        mem->pos = mem->size;
+    }
+
+    if ( mem->bufp != NULL )
+    {
+        /* open_memstream(); grow data as needed, keeping room for the
+           terminating zero byte.
+        */
+        if ( size >= _PDCLIB_SIZE_MAX - mem->pos )
+        {
+            *_PDCLIB_errno_func() = _PDCLIB_ENOMEM;
+            return 0;
+        }
+
+        if ( mem->pos + size >= mem->capacity )
+        {
+            _PDCLIB_size_t capacity = mem->capacity * 2;
+            char * data;
+
+            if ( capacity <= mem->pos + size )
+            {
+                capacity = mem->pos + size + 1;
+            }
+
+            if ( ( data = (char *)realloc( mem->data, capacity ) ) == NULL )
+            {
+                *_PDCLIB_errno_func() = _PDCLIB_ENOMEM;
+                return 0;
+            }
+
+            mem->data = data;
+            mem->capacity = capacity;
+        }
+    }
+    else if ( count > mem->capacity - mem->pos )
+    {
+        /* fmemopen(); write what fits, failing if nothing does */
+        if ( ( count = mem->capacity - mem->pos ) == 0 )
+        {
+            *_PDCLIB_errno_func() = _PDCLIB_ENOSPC;
+            return 0;
+        }
+    }
+
+    if ( mem->pos > mem->size )
+    {
+        /* Fill gap left by seeking beyond end of contents. */
+        memset( mem->data + mem->size, '\0', mem->pos - mem->size );
+    }
+
+    memcpy( mem->data + mem->pos, buf, count );
+    mem->pos += count;
+
+    if ( mem->pos > mem->size )
+    {
+        mem->size = mem->pos;
+    }
+
+    if ( mem->size < mem->capacity )
+    {
+        mem->data[ mem->size ] = '\0';
+    }
+
+    if ( mem->bufp != NULL )
+    {
+        *mem->bufp = mem->data;
+        *mem->sizep = ( mem->pos < mem->size ) ? mem->pos : mem->size;
+    }
+
+    return ( _PDCLIB_ptrdiff_t )count;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+#include <errno.h>
+
+int main( void )
+{
+#ifndef REGTEST
+    struct _PDCLIB_memfile_t mem;
+    char buffer[ 8 ];
+    char * bufp;
+    size_t size;
+    /* Fixed size (fmemopen()) */
+    mem.data = buffer;
+    mem.size = 0;
+    mem.capacity = 6;
+    mem.pos = 0;
+    mem.bufp = NULL;
+    mem.sizep = NULL;
+    mem.append = 0;
+    mem.freedata = 0;
+    memset( buffer, 'x', 8 );
+    TESTCASE( _PDCLIB_memwrite( ( void * )&mem, "abc", 3 ) == 3 );
+    TESTCASE( mem.size == 3 );
+    TESTCASE( mem.pos == 3 );
+    TESTCASE( strcmp( buffer, "abc" ) == 0 );
+    mem.pos = 1;
+    TESTCASE( _PDCLIB_memwrite( ( void * )&mem, "B", 1 ) == 1 );
+    TESTCASE( mem.size == 3 );
+    TESTCASE( strcmp( buffer, "aBc" ) == 0 );
+    mem.append = 1;
+    TESTCASE( _PDCLIB_memwrite( ( void * )&mem, "def", 3 ) == 3 );
+    TESTCASE( mem.size == 6 );
+    TESTCASE( memcmp( buffer, "aBcdefxx", 8 ) == 0 );
+    errno = 0;
+    TESTCASE( _PDCLIB_memwrite( ( void * )&mem, "g", 1 ) == 0 );
+    TESTCASE( errno == ENOSPC );
+    mem.append = 0;
+    mem.pos = 4;
+    TESTCASE( _PDCLIB_memwrite( ( void * )&mem, "EFG", 3 ) == 2 );
+    TESTCASE( _PDCLIB_memwrite( ( void * )&mem, "G", 1 ) == 0 );
+    TESTCASE( memcmp( buffer, "aBcdEFxx", 8 ) == 0 );
+    /* Growing (open_memstream()) */
+    TESTCASE( ( mem.data = (char *)malloc( 2 ) ) != NULL );
+    mem.size = 0;
+    mem.capacity = 2;
+    mem.pos = 0;
+    mem.bufp = &bufp;
+    mem.sizep = &size;
+    TESTCASE( _PDCLIB_memwrite( ( void * )&mem, "abc", 3 ) == 3 );
+    TESTCASE( mem.capacity > 3 );
+    TESTCASE( bufp == mem.data );
+    TESTCASE( size == 3 );
+    TESTCASE( strcmp( bufp, "abc" ) == 0 );
+    mem.pos = 5;
+    TESTCASE( _PDCLIB_memwrite( ( void * )&mem, "f", 1 ) == 1 );
+    TESTCASE( size == 6 );
+    TESTCASE( memcmp( bufp, "abc\0\0f", 7 ) == 0 );
+    mem.pos = 1;
+    TESTCASE( _PDCLIB_memwrite( ( void * )&mem, "B", 1 ) == 1 );
+    TESTCASE( size == 2 );
+    TESTCASE( mem.size == 6 );
+    free( mem.data );
+#endif
+    return TEST_RESULTS;
+}
+
+#endif
@@ -8,8 +8,22 @@
 
 #ifndef REGTEST
 
+#include "pdclib/_PDCLIB_glue.h"
+
 int _PDCLIB_prepwrite( struct _PDCLIB_file_t * stream )
 {
+    if ( ( stream->status & ( _PDCLIB_FREAD | _PDCLIB_FRW ) ) == _PDCLIB_FRW && stream->bufend > 0 )
+    {
+        /* Update stream repositioned within its read buffer by fseek().
+           Discard the buffer, positioning the file where reading left off.
+        */
+        if ( _PDCLIB_seek( stream, ( _PDCLIB_int_least64_t )stream->pos.offset - ( _PDCLIB_int_least64_t )( stream->bufend - stream->bufidx ), SEEK_SET ) == EOF )
+        {
+            stream->status |= _PDCLIB_ERRORFLAG;
+            return EOF;
+        }
+    }
+
     if ( ( stream->bufidx < stream->bufend ) || ( stream->ungetidx > 0 ) ||
          ( stream->status & ( _PDCLIB_FREAD | _PDCLIB_ERRORFLAG | _PDCLIB_WIDESTREAM | _PDCLIB_EOFFLAG ) ) ||
          !( stream->status & ( _PDCLIB_FWRITE | _PDCLIB_FAPPEND | _PDCLIB_FRW ) ) )
@@ -21,7 +35,7 @@ int _PDCLIB_prepwrite( struct _PDCLIB_file_t * stream )
     }
 
     stream->status |= _PDCLIB_FWRITE | _PDCLIB_BYTESTREAM;
-    return 0;
+    return _PDCLIB_allocbuffer( stream );
 }
 
 #endif
@@ -0,0 +1,236 @@
+/* _PDCLIB_print_conversion( const struct _PDCLIB_printop_t *, struct _PDCLIB_status_t * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <stddef.h>
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_print.h"
+
+void _PDCLIB_print_conversion( const struct _PDCLIB_printop_t * op, struct _PDCLIB_status_t * status )
+{
+    if ( op->conversion == '%' )
+    {
+        /* %% -> print single '%' */
+        PUT( '%' );
+        return;
+    }
+
+    /* Initializing status structure */
+    status->flags = op->flags;
+    status->base  = op->base;
+    status->current  = 0;
+    status->width = op->width;
+    status->prec  = op->prec;
+
+    if ( op->flags & E_widtharg )
+    {
+        /* Retrieve width value from argument stack */
+        int width = va_arg( status->arg, int );
+
+        if ( width < 0 )
+        {
+            status->flags |= E_minus;
+            status->width = abs( width );
+        }
+        else
+        {
+            status->width = width;
+        }
+    }
+
+    if ( op->flags & E_precarg )
+    {
+        /* Retrieve precision value from argument stack. A negative value
+           is as if no precision is given - as precision is initalized to
+           EOF (negative), there is no need for testing for negative here.
+        */
+        status->prec = va_arg( status->arg, int );
+    }
+
+    switch ( op->conversion )
+    {
+        case 'c':
+            /* TODO: wide chars. */
+            {
+                char c[1];
+                c[0] = ( char )va_arg( status->arg, int );
+                _PDCLIB_print_string( c, status );
+                return;
+            }
+
+        case 's':
+            /* TODO: wide chars. */
+            _PDCLIB_print_string( va_arg( status->arg, char * ), status );
+            return;
+
+        case 'n':
+            {
+                int * val = va_arg( status->arg, int * );
+                *val = status->i;
+                return;
+            }
+
+        default:
+            break;
+    }
+
+    /* Do the actual output based on our findings */
+    if ( status->base != 0 )
+    {
+        /* TODO: Check for invalid flag combinations. */
+        if ( status->flags & E_double )
+        {
+            /* Floating Point conversions */
+            if ( status->flags & E_ldouble )
+            {
+                long double value = va_arg( status->arg, long double );
+                _PDCLIB_print_ldouble( value, status );
+            }
+            else
+            {
+                double value = va_arg( status->arg, double );
+                _PDCLIB_print_double( value, status );
+            }
+        }
+        else
+        {
+            /* For integer conversions, having a precision cancels out any
+               zero flag.
+            */
+            if ( status->prec >= 0 )
+            {
+                status->flags &= ~E_zero;
+            }
+
+            if ( status->flags & E_unsigned )
+            {
+                /* Integer conversions (unsigned) */
+                uintmax_t value;
+                imaxdiv_t div;
+
+                switch ( status->flags & ( E_char | E_short | E_long | E_llong | E_size | E_pointer | E_intmax ) )
+                {
+                    case E_char:
+                        value = ( uintmax_t )( unsigned char )va_arg( status->arg, int );
+                        break;
+
+                    case E_short:
+                        value = ( uintmax_t )( unsigned short )va_arg( status->arg, int );
+                        break;
+
+                    case 0:
+                        value = ( uintmax_t )va_arg( status->arg, unsigned int );
+                        break;
+
+                    case E_long:
+                        value = ( uintmax_t )va_arg( status->arg, unsigned long );
+                        break;
+
+                    case E_llong:
+                        value = ( uintmax_t )va_arg( status->arg, unsigned long long );
+                        break;
+
+                    case E_size:
+                        value = ( uintmax_t )va_arg( status->arg, size_t );
+                        break;
+
+                    case E_pointer:
+                        value = ( uintmax_t )( uintptr_t )va_arg( status->arg, void * );
+                        break;
+
+                    case E_intmax:
+                        value = va_arg( status->arg, uintmax_t );
+                        break;
+
+                    default:
+                        /* Rejected by _PDCLIB_print_parse(). */
+                        return;
+                }
+
+                div.quot = value / status->base;
+                div.rem = value % status->base;
+                _PDCLIB_print_integer( div, status );
+            }
+            else
+            {
+                /* Integer conversions (signed) */
+                intmax_t value;
+
+                switch ( status->flags & ( E_char | E_short | E_long | E_llong | E_intmax ) )
+                {
+                    case E_char:
+                        value = ( intmax_t )( char )va_arg( status->arg, int );
+                        break;
+
+                    case E_short:
+                        value = ( intmax_t )( short )va_arg( status->arg, int );
+                        break;
+
+                    case 0:
+                        value = ( intmax_t )va_arg( status->arg, int );
+                        break;
+
+                    case E_long:
+                        value = ( intmax_t )va_arg( status->arg, long );
+                        break;
+
+                    case E_llong:
+                        value = ( intmax_t )va_arg( status->arg, long long );
+                        break;
+
+                    case E_ptrdiff:
+                        value = ( intmax_t )va_arg( status->arg, ptrdiff_t );
+                        break;
+
+                    case E_intmax:
+                        value = va_arg( status->arg, intmax_t );
+                        break;
+
+                    default:
+                        /* Rejected by _PDCLIB_print_parse(). */
+                        return;
+                }
+
+                _PDCLIB_print_integer( imaxdiv( value, status->base ), status );
+            }
+        }
+
+        if ( status->flags & E_minus )
+        {
+            /* Left-aligned filling */
+            if ( status->current < status->width )
+            {
+                _PDCLIB_print_fill( ' ', status->width - status->current, status );
+                status->current = status->width;
+            }
+        }
+
+        if ( status->i >= status->n && status->n > 0 )
+        {
+            status->s[status->n - 1] = '\0';
+        }
+    }
+
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+    /* Testing covered by _PDCLIB_print.c */
+    return TEST_RESULTS;
+}
+
+#endif
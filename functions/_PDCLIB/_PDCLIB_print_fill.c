@@ -0,0 +1,81 @@
+/* _PDCLIB_print_fill( char, size_t, struct _PDCLIB_status_t * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#ifndef REGTEST
+
+#include <stdio.h>
+#include <string.h>
+
+#include "pdclib/_PDCLIB_print.h"
+
+void _PDCLIB_print_fill( char c, size_t n, struct _PDCLIB_status_t * status )
+{
+    char buffer[ 32 ];
+    size_t count;
+
+    if ( status->stream != NULL )
+    {
+        struct _PDCLIB_file_t * stream = status->stream;
+
+        if ( ! ( stream->status & ( _IOLBF | _IONBF | _PDCLIB_ERRORFLAG ) ) && ( n < stream->bufsize - stream->bufidx ) )
+        {
+            /* Fits into the buffer without filling it, no flush required. */
+            memset( stream->buffer + stream->bufidx, c, n );
+            stream->bufidx += n;
+            status->i += n;
+            return;
+        }
+    }
+    else
+    {
+        if ( status->i < status->n )
+        {
+            memset( status->s + status->i, c, ( n < status->n - status->i ) ? n : status->n - status->i );
+        }
+
+        status->i += n;
+        return;
+    }
+
+    /* Going through the stream's buffering logic, a chunk at a time. */
+    memset( buffer, c, ( n < sizeof( buffer ) ) ? n : sizeof( buffer ) );
+
+    while ( n > 0 )
+    {
+        count = ( n < sizeof( buffer ) ) ? n : sizeof( buffer );
+        _PDCLIB_print_span( buffer, count, status );
+        n -= count;
+    }
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+#ifndef REGTEST
+    struct _PDCLIB_status_t status;
+    char buffer[ 10 ];
+    memset( buffer, '\0', 10 );
+    status.n = 5;
+    status.i = 0;
+    status.s = buffer;
+    status.stream = NULL;
+    _PDCLIB_print_fill( 'x', 3, &status );
+    TESTCASE( status.i == 3 );
+    _PDCLIB_print_fill( '0', 0, &status );
+    TESTCASE( status.i == 3 );
+    _PDCLIB_print_fill( ' ', 40, &status );
+    TESTCASE( status.i == 43 );
+    TESTCASE( strcmp( buffer, "xxx  " ) == 0 );
+#endif
+    return TEST_RESULTS;
+}
+
+#endif
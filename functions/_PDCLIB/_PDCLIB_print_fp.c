@@ -144,12 +144,9 @@ static void _PDCLIB_print_hexa( int sign,
 
     status->current = m + 4 + ( sign != '\0' ) + ( ( m > 0 ) || ( status->prec > 0 ) || ( status->flags & E_alt ) ) + e;
 
-    if ( ! ( status->flags & ( E_zero | E_minus ) ) )
+    if ( ! ( status->flags & ( E_zero | E_minus ) ) && ( status->current < status->width ) )
     {
-        for ( i = status->current; i < status->width; ++i )
-        {
-            PUT( ' ' );
-        }
+        _PDCLIB_print_fill( ' ', status->width - status->current, status );
     }
 
     if ( sign != '\0' )
@@ -170,23 +167,22 @@ static void _PDCLIB_print_hexa( int sign,
         PUT( '.' );
     }
 
-    if ( ( status->flags & E_zero ) && ! ( status->flags & E_minus ) )
+    if ( ( status->flags & E_zero ) && ! ( status->flags & E_minus ) && ( status->current < status->width ) )
     {
-        for ( i = status->current; i < status->width; ++i )
-        {
-            PUT( '0' );
-        }
+        _PDCLIB_print_fill( '0', status->width - status->current, status );
     }
 
     for ( i = 1; i <= m; ++i )
     {
-        PUT( digit_chars[ mantissa[i] ] );
+        /* Digit values to digit characters, in place */
+        mantissa[ i ] = digit_chars[ mantissa[ i ] ];
     }
 
-    while ( (int)i <= status->prec )
+    _PDCLIB_print_span( ( char const * )mantissa + 1, m, status );
+
+    if ( (int)i <= status->prec )
     {
-        PUT( '0' );
-        ++i;
+        _PDCLIB_print_fill( '0', status->prec - i + 1, status );
     }
 
     PUT( ( status->flags & E_lower ) ? 'p' : 'P' );
@@ -198,6 +194,253 @@ static void _PDCLIB_print_hexa( int sign,
     }
 }
 
+/* Delivers count digits of a decimal, starting at the given index. */
+static void _PDCLIB_print_digits( _PDCLIB_decimal_t const * decimal,
+                                  long index,
+                                  long count,
+                                  struct _PDCLIB_status_t * status )
+{
+    char buffer[ 64 ];
+    long chunk;
+
+    while ( count > 0 )
+    {
+        chunk = ( count < (long)sizeof( buffer ) ) ? count : (long)sizeof( buffer );
+        _PDCLIB_decimal_tostring( decimal, index, chunk, buffer );
+        _PDCLIB_print_span( buffer, chunk, status );
+
+        index += chunk;
+        count -= chunk;
+    }
+}
+
+/* Sets a decimal to the value of a nonzero diyfp, rounded to count digits
+   with _PDCLIB_grisu_counted().
+   Returns NULL if count is out of range for that, or the result undecided.
+*/
+static _PDCLIB_decimal_t * _PDCLIB_print_grisu( _PDCLIB_decimal_t * decimal,
+                                                _PDCLIB_diyfp_t const * diyfp,
+                                                long count )
+{
+    char digits[ _PDCLIB_DBL_DECIMAL_DIG ];
+    long x;
+    long i;
+
+    if ( count < 1 || count > _PDCLIB_DBL_DECIMAL_DIG || ! _PDCLIB_grisu_counted( diyfp, ( int )count, digits, &x ) )
+    {
+        return NULL;
+    }
+
+    decimal->size = 0;
+
+    for ( i = 0; i < count; ++i )
+    {
+        _PDCLIB_decimal_muladd( decimal, 10, ( _PDCLIB_decimal_limb_t )( digits[ i ] - '0' ) );
+    }
+
+    decimal->digits = count;
+    decimal->scale = count - 1 - x;
+    decimal->inexact = 0;
+    return decimal;
+}
+
+/* dec:      1 - normalized, 0 - subnormal
+   mant:     MSB of the mantissa
+   mant_dig: base FLT_RADIX digits in the mantissa, including the decimal
+*/
+static void _PDCLIB_print_decimal( int sign,
+                                   int exp,
+                                   int dec,
+                                   unsigned char const * mant,
+                                   size_t mant_dig,
+                                   struct _PDCLIB_status_t * status )
+{
+    _PDCLIB_decimal_t decimal;
+    _PDCLIB_decimal_t * rounded = NULL;
+    _PDCLIB_diyfp_t diyfp;
+    _PDCLIB_int_fast32_t style = status->flags & ( E_decimal | E_exponent | E_generic );
+    long prec = ( status->prec < 0 ) ? 6 : status->prec;
+    long x;
+    long need;
+    long keep;
+
+    char exponent[ 7 ];
+    size_t e = 0;
+
+    size_t i;
+
+    /* Rounding */
+    /* -------- */
+
+    if ( style == E_generic && prec == 0 )
+    {
+        prec = 1;
+    }
+
+    switch ( style )
+    {
+        case E_decimal:
+            /* prec digits after the decimal point; the decimal exponent is
+               at most ( exp + 1 ) * log10( 2 )
+            */
+            need = ( ( exp + 1L ) * 30103L ) / 100000L + 2 + prec;
+            break;
+        case E_exponent:
+            /* prec digits after the first */
+            need = prec + 1;
+            break;
+        default:
+            /* prec significant digits */
+            need = prec;
+            break;
+    }
+
+    /* Doubles are rounded with Grisu if the digits needed allow for it. For
+       E_decimal, need is only an upper bound, so the digits actually needed
+       follow from the exponent of that first result. (Should rounding to
+       need digits have carried into a new leading digit, rounding to fewer
+       digits carries as well, giving the same power of ten.)
+    */
+    if ( mant_dig <= _PDCLIB_DIYFP_MANT_DIG && _PDCLIB_diyfp_fp( &diyfp, exp, dec, mant, mant_dig )->f != 0 )
+    {
+        rounded = _PDCLIB_print_grisu( &decimal, &diyfp, need );
+
+        if ( rounded != NULL && style == E_decimal )
+        {
+            keep = _PDCLIB_decimal_exp( &decimal ) + 1 + prec;
+
+            if ( keep < need )
+            {
+                rounded = _PDCLIB_print_grisu( &decimal, &diyfp, keep );
+            }
+        }
+    }
+
+    if ( rounded == NULL )
+    {
+        /* The value in decimal, computed for the leading digits needed only,
+           and exactly if those do not suffice for rounding.
+        */
+        _PDCLIB_decimal_fp( &decimal, exp, dec, mant, mant_dig, ( need > 0 ) ? need : 1 );
+
+        do
+        {
+            keep = ( style == E_decimal ) ? _PDCLIB_decimal_exp( &decimal ) + 1 + prec : need;
+        } while ( _PDCLIB_decimal_round( &decimal, keep ) == NULL &&
+                  _PDCLIB_decimal_fp( &decimal, exp, dec, mant, mant_dig, 0 ) );
+    }
+
+    x = _PDCLIB_decimal_exp( &decimal );
+
+    if ( style == E_generic )
+    {
+        /* Style depends on the exponent after rounding; either way, the
+           rounding done above for prec significant digits still holds.
+        */
+        if ( x < -4 || x >= prec )
+        {
+            style = E_exponent;
+            prec -= 1;
+        }
+        else
+        {
+            style = E_decimal;
+            prec -= 1 + x;
+        }
+
+        if ( ! ( status->flags & E_alt ) )
+        {
+            /* Remove trailing zeroes */
+            keep = _PDCLIB_decimal_sig( &decimal ) - 1 - ( ( style == E_decimal ) ? x : 0 );
+
+            if ( keep < prec )
+            {
+                prec = ( keep > 0 ) ? keep : 0;
+            }
+        }
+    }
+
+    /* Exponent */
+    /* -------- */
+
+    if ( style == E_exponent )
+    {
+        long value = ( x < 0 ) ? -x : x;
+
+        exponent[ e++ ] = ( x < 0 ) ? '-' : '+';
+
+        /* At least two digits, in reverse order */
+        do
+        {
+            exponent[ e++ ] = (char)( '0' + value % 10 );
+            value /= 10;
+        } while ( value > 0 || e < 3 );
+    }
+
+    /* Padding */
+    /* ------- */
+
+    status->current = ( sign != '\0' ) + ( ( style == E_decimal && x > 0 ) ? x + 1 : 1 ) + ( ( prec > 0 ) || ( status->flags & E_alt ) ) + prec + ( ( e > 0 ) ? e + 1 : 0 );
+
+    if ( ! ( status->flags & ( E_zero | E_minus ) ) && ( status->current < status->width ) )
+    {
+        _PDCLIB_print_fill( ' ', status->width - status->current, status );
+    }
+
+    if ( sign != '\0' )
+    {
+        PUT( sign );
+    }
+
+    if ( ( status->flags & E_zero ) && ! ( status->flags & E_minus ) && ( status->current < status->width ) )
+    {
+        _PDCLIB_print_fill( '0', status->width - status->current, status );
+    }
+
+    /* Output */
+    /* ------ */
+
+    if ( style == E_decimal )
+    {
+        /* Integral digits (at least one), then prec fractional digits */
+        if ( x >= 0 )
+        {
+            _PDCLIB_print_digits( &decimal, 0, x + 1, status );
+        }
+        else
+        {
+            PUT( '0' );
+        }
+
+        if ( ( prec > 0 ) || ( status->flags & E_alt ) )
+        {
+            PUT( '.' );
+        }
+
+        _PDCLIB_print_digits( &decimal, x + 1, prec, status );
+    }
+    else
+    {
+        /* One digit, then prec digits, then the exponent */
+        _PDCLIB_print_digits( &decimal, 0, 1, status );
+
+        if ( ( prec > 0 ) || ( status->flags & E_alt ) )
+        {
+            PUT( '.' );
+        }
+
+        _PDCLIB_print_digits( &decimal, 1, prec, status );
+
+        PUT( ( status->flags & E_lower ) ? 'e' : 'E' );
+        PUT( exponent[ 0 ] );
+
+        for ( i = e - 1; i > 0; --i )
+        {
+            PUT( exponent[ i ] );
+        }
+    }
+}
+
 /* dec:      1 - normalized, 0 - subnormal
    exp:      INT_MAX - infinity, INT_MIN - Not a Number
    mant:     MSB of the mantissa
@@ -237,13 +480,10 @@ static void _PDCLIB_print_fp( int sign,
 
         status->current = ( sign == '\0' ) ? 3 : 4;
 
-        if ( ! ( status->flags & E_minus ) )
+        if ( ! ( status->flags & E_minus ) && ( status->current < status->width ) )
         {
-            while ( status->current < status->width )
-            {
-                PUT( ' ' );
-                ++status->current;
-            }
+            _PDCLIB_print_fill( ' ', status->width - status->current, status );
+            status->current = status->width;
         }
 
         if ( sign != '\0' )
@@ -251,10 +491,7 @@ static void _PDCLIB_print_fp( int sign,
             PUT( sign );
         }
 
-        while ( *s )
-        {
-            PUT( *s++ );
-        }
+        _PDCLIB_print_span( s, 3, status );
 
         return;
     }
@@ -267,6 +504,8 @@ static void _PDCLIB_print_fp( int sign,
         case E_decimal:
         case E_exponent:
         case E_generic:
+            _PDCLIB_print_decimal( sign, exp, dec, mant, mant_dig, status );
+            break;
         default:
             break;
     }
@@ -7,6 +7,7 @@
 #ifndef REGTEST
 
 #include <inttypes.h>
+#include <limits.h>
 #include <stdio.h>
 
 #include "pdclib/_PDCLIB_print.h"
@@ -75,87 +76,69 @@ static void intformat( intmax_t value, struct _PDCLIB_status_t * status )
 
             if ( status->width > characters )
             {
-                size_t i;
-
-                for ( i = 0; i < status->width - characters; ++i )
-                {
-                    PUT( ' ' );
-                    ++( status->current );
-                }
+                _PDCLIB_print_fill( ' ', status->width - characters, status );
+                status->current += status->width - characters;
             }
         }
 
         /* Now we did the padding, do the prefixes (if any). */
-        preidx = 0;
-
-        while ( preface[ preidx ] != '\0' )
-        {
-            PUT( preface[ preidx++ ] );
-            ++( status->current );
-        }
+        _PDCLIB_print_span( preface, preidx, status );
+        status->current += preidx;
 
         /* Do the precision padding if necessary. */
-        while ( prec_pads-- > 0 )
-        {
-            PUT( '0' );
-            ++( status->current );
-        }
+        _PDCLIB_print_fill( '0', prec_pads, status );
+        status->current += prec_pads;
 
-        if ( ( !( status->flags & E_minus ) ) && ( status->flags & E_zero ) )
+        if ( ( !( status->flags & E_minus ) ) && ( status->flags & E_zero ) && ( status->current < status->width ) )
         {
             /* If field is not left aligned, and zero padding is requested, do
                so.
             */
-            while ( status->current < status->width )
-            {
-                PUT( '0' );
-                ++( status->current );
-            }
+            _PDCLIB_print_fill( '0', status->width - status->current, status );
+            status->current = status->width;
         }
     }
 }
 
-/* This function recursively converts a given integer value to a character
-   stream. The conversion is done under the control of a given status struct
-   and written either to a character string or a stream, depending on that
-   same status struct. The status struct also keeps the function from exceeding
+/* This function converts a given integer value to a character stream. The
+   conversion is done under the control of a given status struct and written
+   either to a character string or a stream, depending on that same status
+   struct. The status struct also keeps the function from exceeding
    snprintf() limits, and enables any necessary padding / prefixing of the
-   output once the number of characters to be printed is known, which happens
-   at the lowermost recursion level.
+   output once the number of characters to be printed is known. The digits
+   are collected (least significant first) into a buffer, and delivered as a
+   single run after the padding / prefixing.
 */
 void _PDCLIB_print_integer( imaxdiv_t div, struct _PDCLIB_status_t * status )
 {
-    if ( status->current == 0 && div.quot == 0 && div.rem == 0 && status->prec == 0 )
+    /* Octal takes the most digits. */
+    char digits[ ( sizeof( intmax_t ) * CHAR_BIT + 2 ) / 3 ];
+    char const * digit_chars = ( status->flags & E_lower ) ? _PDCLIB_digits : _PDCLIB_Xdigits;
+    size_t len = 0;
+    /* Sign of the value, or zero for zero */
+    intmax_t value = ( div.quot < 0 || div.rem < 0 ) ? -1 : ( div.quot > 0 || div.rem > 0 );
+
+    if ( status->current == 0 && value == 0 && status->prec == 0 )
     {
         intformat( 0, status );
+        return;
     }
-    else
-    {
-        ++(status->current);
 
-        if ( div.quot != 0 )
-        {
-            _PDCLIB_print_integer( imaxdiv( div.quot, status->base ), status );
-        }
-        else
-        {
-            intformat( div.rem, status );
-        }
+    for ( ;; )
+    {
+        digits[ sizeof( digits ) - ++len ] = digit_chars[ ( div.rem < 0 ) ? -div.rem : div.rem ];
 
-        if ( div.rem < 0 )
+        if ( div.quot == 0 )
         {
-            div.rem *= -1;
+            break;
         }
 
-        if ( status->flags & E_lower )
-        {
-            PUT( _PDCLIB_digits[ div.rem ] );
-        }
-        else
-        {
-            PUT( _PDCLIB_Xdigits[ div.rem ] );
-        }
+        div = imaxdiv( div.quot, status->base );
     }
+
+    status->current += len;
+    intformat( value, status );
+    _PDCLIB_print_span( digits + sizeof( digits ) - len, len, status );
 }
 
 #endif
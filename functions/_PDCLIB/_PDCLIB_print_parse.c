@@ -0,0 +1,324 @@
+/* _PDCLIB_print_parse( const char *, struct _PDCLIB_printop_t * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#include <stdio.h>
+
+#ifndef REGTEST
+
+#include <limits.h>
+
+#include "pdclib/_PDCLIB_print.h"
+
+const char * _PDCLIB_print_parse( const char * spec, struct _PDCLIB_printop_t * op )
+{
+    const char * orig_spec = spec;
+
+    op->text = NULL;
+    op->length = 0;
+    op->flags = 0;
+    op->base = 0;
+    op->width = 0;
+    op->prec = EOF;
+
+    if ( *( ++spec ) == '%' )
+    {
+        /* %% -> print single '%' */
+        op->conversion = '%';
+        return ++spec;
+    }
+
+    /* First come 0..n flags */
+    do
+    {
+        switch ( *spec )
+        {
+            case '-':
+                /* left-aligned output */
+                op->flags |= E_minus;
+                ++spec;
+                break;
+
+            case '+':
+                /* positive numbers prefixed with '+' */
+                op->flags |= E_plus;
+                ++spec;
+                break;
+
+            case '#':
+                /* alternative format (leading 0x for hex, 0 for octal) */
+                op->flags |= E_alt;
+                ++spec;
+                break;
+
+            case ' ':
+                /* positive numbers prefixed with ' ' */
+                op->flags |= E_space;
+                ++spec;
+                break;
+
+            case '0':
+                /* right-aligned padding done with '0' instead of ' ' */
+                op->flags |= E_zero;
+                ++spec;
+                break;
+
+            default:
+                /* not a flag, exit flag parsing */
+                op->flags |= E_done;
+                break;
+        }
+    } while ( !( op->flags & E_done ) );
+
+    /* Optional field width */
+    if ( *spec == '*' )
+    {
+        /* Width value to be retrieved from argument stack */
+        op->flags |= E_widtharg;
+        ++spec;
+    }
+    else
+    {
+        /* If no width is given, it stays zero. */
+        while ( *spec >= '0' && *spec <= '9' )
+        {
+            op->width = op->width * 10 + ( *spec++ - '0' );
+        }
+    }
+
+    /* Optional precision */
+    if ( *spec == '.' )
+    {
+        ++spec;
+
+        if ( *spec == '*' )
+        {
+            /* Precision value to be retrieved from argument stack */
+            op->flags |= E_precarg;
+            ++spec;
+        }
+        else
+        {
+            /* Decimal point but no number - equals zero */
+            op->prec = 0;
+
+            while ( *spec >= '0' && *spec <= '9' )
+            {
+                op->prec = ( op->prec > ( INT_MAX - 9 ) / 10 ) ? INT_MAX : op->prec * 10 + ( *spec - '0' );
+                ++spec;
+            }
+        }
+    }
+
+    /* Optional length modifier
+       We step one character ahead in any case, and step back only if we find
+       there has been no length modifier (or step ahead another character if it
+       has been "hh" or "ll").
+    */
+    switch ( *( spec++ ) )
+    {
+        case 'h':
+            if ( *spec == 'h' )
+            {
+                /* hh -> char */
+                op->flags |= E_char;
+                ++spec;
+            }
+            else
+            {
+                /* h -> short */
+                op->flags |= E_short;
+            }
+
+            break;
+
+        case 'l':
+            if ( *spec == 'l' )
+            {
+                /* ll -> long long */
+                op->flags |= E_llong;
+                ++spec;
+            }
+            else
+            {
+                /* k -> long */
+                op->flags |= E_long;
+            }
+
+            break;
+
+        case 'j':
+            /* j -> intmax_t, which might or might not be long long */
+            op->flags |= E_intmax;
+            break;
+
+        case 'z':
+            /* z -> size_t, which might or might not be unsigned int */
+            op->flags |= E_size;
+            break;
+
+        case 't':
+            /* t -> ptrdiff_t, which might or might not be long */
+            op->flags |= E_ptrdiff;
+            break;
+
+        case 'L':
+            /* L -> long double */
+            op->flags |= E_ldouble;
+            break;
+
+        default:
+            --spec;
+            break;
+    }
+
+    /* Conversion specifier */
+    switch ( *spec )
+    {
+        case 'd':
+            /* FALLTHROUGH */
+
+        case 'i':
+            op->base = 10;
+            break;
+
+        case 'o':
+            op->base = 8;
+            op->flags |= E_unsigned;
+            break;
+
+        case 'u':
+            op->base = 10;
+            op->flags |= E_unsigned;
+            break;
+
+        case 'x':
+            op->base = 16;
+            op->flags |= ( E_lower | E_unsigned );
+            break;
+
+        case 'X':
+            op->base = 16;
+            op->flags |= E_unsigned;
+            break;
+
+        case 'f':
+            op->base = 2;
+            op->flags |= ( E_decimal | E_double | E_lower );
+            break;
+
+        case 'F':
+            op->base = 2;
+            op->flags |= ( E_decimal | E_double );
+            break;
+
+        case 'e':
+            op->base = 2;
+            op->flags |= ( E_exponent | E_double | E_lower );
+            break;
+
+        case 'E':
+            op->base = 2;
+            op->flags |= ( E_exponent | E_double );
+            break;
+
+        case 'g':
+            op->base = 2;
+            op->flags |= ( E_generic | E_double | E_lower );
+            break;
+
+        case 'G':
+            op->base = 2;
+            op->flags |= ( E_generic | E_double );
+            break;
+
+        case 'a':
+            op->base = 2;
+            op->flags |= ( E_hexa | E_double | E_lower );
+            break;
+
+        case 'A':
+            op->base = 2;
+            op->flags |= ( E_hexa | E_double );
+            break;
+
+        case 'c':
+            op->flags |= E_char;
+            break;
+
+        case 's':
+        case 'n':
+            break;
+
+        case 'p':
+            if ( op->flags & ( E_char | E_short | E_long | E_llong | E_size | E_intmax ) )
+            {
+                /* No length modifiers for pointers. */
+                return orig_spec;
+            }
+
+            op->base = 16;
+            op->flags |= ( E_lower | E_unsigned | E_alt | E_pointer );
+            break;
+
+        default:
+            /* No conversion specifier. Bad conversion. */
+            return orig_spec;
+    }
+
+    op->conversion = *spec;
+    return ++spec;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+#ifndef REGTEST
+    struct _PDCLIB_printop_t op;
+    const char * spec;
+
+    spec = "%-+#08.3lxyz";
+    TESTCASE( _PDCLIB_print_parse( spec, &op ) == spec + 10 );
+    TESTCASE( op.conversion == 'x' );
+    TESTCASE( op.base == 16 );
+    TESTCASE( op.flags == ( E_minus | E_plus | E_alt | E_zero | E_done | E_long | E_lower | E_unsigned ) );
+    TESTCASE( op.width == 8 );
+    TESTCASE( op.prec == 3 );
+    TESTCASE( op.text == NULL );
+
+    spec = "%*.*Lg";
+    TESTCASE( _PDCLIB_print_parse( spec, &op ) == spec + 6 );
+    TESTCASE( op.conversion == 'g' );
+    TESTCASE( op.flags == ( E_done | E_widtharg | E_precarg | E_ldouble | E_generic | E_double | E_lower ) );
+
+    spec = "%.s";
+    TESTCASE( _PDCLIB_print_parse( spec, &op ) == spec + 3 );
+    TESTCASE( op.conversion == 's' );
+    TESTCASE( op.width == 0 );
+    TESTCASE( op.prec == 0 );
+
+    spec = "%%d";
+    TESTCASE( _PDCLIB_print_parse( spec, &op ) == spec + 2 );
+    TESTCASE( op.conversion == '%' );
+
+    /* Invalid conversion specifications */
+    spec = "%y";
+    TESTCASE( _PDCLIB_print_parse( spec, &op ) == spec );
+    spec = "%5%";
+    TESTCASE( _PDCLIB_print_parse( spec, &op ) == spec );
+    spec = "%lp";
+    TESTCASE( _PDCLIB_print_parse( spec, &op ) == spec );
+    spec = "%";
+    TESTCASE( _PDCLIB_print_parse( spec, &op ) == spec );
+#endif
+    return TEST_RESULTS;
+}
+
+#endif
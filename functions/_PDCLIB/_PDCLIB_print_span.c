@@ -0,0 +1,67 @@
+/* _PDCLIB_print_span( const char *, size_t, struct _PDCLIB_status_t * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#ifndef REGTEST
+
+#include <stdio.h>
+#include <string.h>
+
+#include "pdclib/_PDCLIB_print.h"
+
+void _PDCLIB_print_span( const char * s, size_t n, struct _PDCLIB_status_t * status )
+{
+    if ( status->stream != NULL )
+    {
+        struct _PDCLIB_file_t * stream = status->stream;
+
+        if ( ! ( stream->status & ( _IOLBF | _IONBF | _PDCLIB_ERRORFLAG ) ) && ( n < stream->bufsize - stream->bufidx ) )
+        {
+            /* Fits into the buffer without filling it, no flush required. */
+            memcpy( stream->buffer + stream->bufidx, s, n );
+            stream->bufidx += n;
+        }
+        else
+        {
+            _PDCLIB_fwrite_unlocked( s, 1, n, stream );
+        }
+    }
+    else if ( status->i < status->n )
+    {
+        /* Deliver only as much as fits within snprintf() limits. */
+        memcpy( status->s + status->i, s, ( n < status->n - status->i ) ? n : status->n - status->i );
+    }
+
+    status->i += n;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+#ifndef REGTEST
+    struct _PDCLIB_status_t status;
+    char buffer[ 10 ];
+    memset( buffer, '\0', 10 );
+    status.n = 5;
+    status.i = 0;
+    status.s = buffer;
+    status.stream = NULL;
+    _PDCLIB_print_span( "abc", 3, &status );
+    TESTCASE( status.i == 3 );
+    _PDCLIB_print_span( "defg", 4, &status );
+    TESTCASE( status.i == 7 );
+    _PDCLIB_print_span( "hij", 3, &status );
+    TESTCASE( status.i == 10 );
+    TESTCASE( strcmp( buffer, "abcde" ) == 0 );
+#endif
+    return TEST_RESULTS;
+}
+
+#endif
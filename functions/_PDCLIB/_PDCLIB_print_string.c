@@ -42,29 +42,20 @@ void _PDCLIB_print_string( const char * s, struct _PDCLIB_status_t * status )
         }
     }
 
-    if ( !( status->flags & E_minus ) && ( status->width > ( _PDCLIB_size_t )status->prec ) )
+    if ( !( status->flags & E_minus ) && ( status->width > status->current + status->prec ) )
     {
-        while ( status->current < ( status->width - status->prec ) )
-        {
-            PUT( ' ' );
-            ++( status->current );
-        }
+        _PDCLIB_print_fill( ' ', status->width - status->current - status->prec, status );
+        status->current = status->width - status->prec;
     }
 
-    while ( status->prec > 0 )
-    {
-        PUT( *( s++ ) );
-        --( status->prec );
-        ++( status->current );
-    }
+    _PDCLIB_print_span( s, status->prec, status );
+    status->current += status->prec;
+    status->prec = 0;
 
-    if ( status->flags & E_minus )
+    if ( ( status->flags & E_minus ) && ( status->width > status->current ) )
     {
-        while ( status->width > status->current )
-        {
-            PUT( ' ' );
-            ++( status->current );
-        }
+        _PDCLIB_print_fill( ' ', status->width - status->current, status );
+        status->current = status->width;
     }
 }
 
@@ -0,0 +1,41 @@
+/* _PDCLIB_putstream( FILE * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#include <stdio.h>
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_internal.h"
+
+extern struct _PDCLIB_file_t * _PDCLIB_filelist;
+
+void _PDCLIB_putstream( struct _PDCLIB_file_t * stream )
+{
+    stream->prev = NULL;
+    stream->next = _PDCLIB_filelist;
+
+    if ( _PDCLIB_filelist != NULL )
+    {
+        _PDCLIB_filelist->prev = stream;
+    }
+
+    _PDCLIB_filelist = stream;
+    stream->tag = _PDCLIB_FILE_TAG;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+    /* Testing covered by _PDCLIB_isstream.c and fclose.c */
+    return TEST_RESULTS;
+}
+
+#endif
@@ -0,0 +1,78 @@
+/* _PDCLIB_refstreams( size_t * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifndef REGTEST
+
+#ifndef __STDC_NO_THREADS__
+#include <threads.h>
+extern mtx_t _PDCLIB_filelist_mtx;
+#endif
+
+extern struct _PDCLIB_file_t * _PDCLIB_filelist;
+
+struct _PDCLIB_file_t ** _PDCLIB_refstreams( size_t * count )
+{
+    struct _PDCLIB_file_t ** streams;
+    struct _PDCLIB_file_t * stream;
+    size_t n = 0;
+
+    _PDCLIB_LOCK( _PDCLIB_filelist_mtx );
+
+    for ( stream = _PDCLIB_filelist; stream != NULL; stream = stream->next )
+    {
+        ++n;
+    }
+
+    /* One more than necessary, so an empty list does not return NULL */
+    if ( ( streams = ( struct _PDCLIB_file_t ** )malloc( ( n + 1 ) * sizeof( struct _PDCLIB_file_t * ) ) ) != NULL )
+    {
+        n = 0;
+
+        for ( stream = _PDCLIB_filelist; stream != NULL; stream = stream->next )
+        {
+            ++stream->refs;
+            streams[ n++ ] = stream;
+        }
+
+        *count = n;
+    }
+
+    _PDCLIB_UNLOCK( _PDCLIB_filelist_mtx );
+
+    return streams;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+#ifndef REGTEST
+    FILE * fh;
+    struct _PDCLIB_file_t ** streams;
+    size_t count;
+    TESTCASE( ( fh = tmpfile() ) != NULL );
+    TESTCASE( ( streams = _PDCLIB_refstreams( &count ) ) != NULL );
+    TESTCASE( count == 4 );
+    TESTCASE( streams[ 0 ] == fh );
+    TESTCASE( fh->refs == 1 );
+    /* Closing a referenced stream defers freeing it. */
+    TESTCASE( fclose( fh ) == 0 );
+    TESTCASE( ! _PDCLIB_isstream( fh ) );
+    TESTCASE( fh->refs == 1 );
+    _PDCLIB_unrefstreams( streams, count );
+    TESTCASE( stdin->refs == 0 );
+#endif
+    return TEST_RESULTS;
+}
+
+#endif
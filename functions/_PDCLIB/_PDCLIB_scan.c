@@ -71,7 +71,7 @@ static void UNGET( int c, struct _PDCLIB_status_t * status )
 {
     if ( status->stream != NULL )
     {
-        ungetc( c, status->stream ); /* TODO: Error? */
+        _PDCLIB_ungetc_unlocked( c, status->stream ); /* TODO: Error? */
     }
     else
     {
@@ -0,0 +1,51 @@
+/* _PDCLIB_snprintf_format( char *, size_t, const struct _PDCLIB_format_t *, ... )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#include <stdarg.h>
+#include <stdio.h>
+
+#ifndef REGTEST
+
+int _PDCLIB_snprintf_format( char * _PDCLIB_restrict s, size_t n, const struct _PDCLIB_format_t * _PDCLIB_restrict format, ... )
+{
+    int rc;
+    va_list ap;
+    va_start( ap, format );
+    rc = _PDCLIB_vsnprintf_format( s, n, format, ap );
+    va_end( ap );
+    return rc;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+#ifndef REGTEST
+    struct _PDCLIB_format_t * format;
+    char buffer[ 20 ];
+    int n;
+
+    TESTCASE( ( format = _PDCLIB_compileformat( "%s=%-4d|%n" ) ) != NULL );
+    TESTCASE( _PDCLIB_snprintf_format( buffer, 20, format, "key", 42, &n ) == 9 );
+    TESTCASE( strcmp( buffer, "key=42  |" ) == 0 );
+    TESTCASE( n == 9 );
+    /* Truncation */
+    memset( buffer, 'x', 20 );
+    TESTCASE( _PDCLIB_snprintf_format( buffer, 6, format, "key", 42, &n ) == 9 );
+    TESTCASE( strcmp( buffer, "key=4" ) == 0 );
+    TESTCASE( _PDCLIB_snprintf_format( buffer, 3, format, "key", 42, &n ) == 9 );
+    TESTCASE( strcmp( buffer, "ke" ) == 0 );
+    TESTCASE( _PDCLIB_snprintf_format( NULL, 0, format, "longer", 123456, &n ) == 14 );
+    _PDCLIB_freeformat( format );
+#endif
+    return TEST_RESULTS;
+}
+
+#endif
@@ -0,0 +1,144 @@
+/* _PDCLIB_streamstats( FILE *, struct _PDCLIB_streamstats_t * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+
+#ifndef REGTEST
+
+#ifdef _PDCLIB_STREAMSTATS
+
+#ifndef __STDC_NO_THREADS__
+#include <threads.h>
+extern mtx_t _PDCLIB_filelist_mtx;
+#endif
+
+extern struct _PDCLIB_file_t * _PDCLIB_filelist;
+
+/* Statistics of the streams closed already. Updated by fclose(), protected
+   by _PDCLIB_filelist_mtx.
+*/
+struct _PDCLIB_streamstats_t _PDCLIB_closedstats = { 0, 0, 0, 0, 0, 0, 0 };
+
+/* Stream must be locked. */
+static void getstats( struct _PDCLIB_file_t * stream, struct _PDCLIB_streamstats_t * stats )
+{
+    *stats = stream->stats;
+#ifndef __STDC_NO_THREADS__
+    /* Counted by _PDCLIB_flock_wait(), which does not know the stream */
+    stats->contentions = stream->lock.contentions;
+#endif
+}
+
+int _PDCLIB_streamstats( struct _PDCLIB_file_t * stream, struct _PDCLIB_streamstats_t * stats )
+{
+    struct _PDCLIB_streamstats_t current;
+
+    if ( stream != NULL )
+    {
+        int locked = _PDCLIB_LOCKFILE( stream );
+        getstats( stream, stats );
+        _PDCLIB_UNLOCKFILE( stream, locked );
+        return 0;
+    }
+
+    _PDCLIB_LOCK( _PDCLIB_filelist_mtx );
+
+    *stats = _PDCLIB_closedstats;
+
+    for ( stream = _PDCLIB_filelist; stream != NULL; stream = stream->next )
+    {
+        _PDCLIB_FLOCK( stream->lock );
+        getstats( stream, &current );
+        _PDCLIB_FUNLOCK( stream->lock );
+        _PDCLIB_addstreamstats( stats, &current );
+    }
+
+    _PDCLIB_UNLOCK( _PDCLIB_filelist_mtx );
+
+    return 0;
+}
+
+#endif
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+#include <string.h>
+
+int main( void )
+{
+#ifndef REGTEST
+#ifdef _PDCLIB_STREAMSTATS
+    FILE * fh;
+    struct _PDCLIB_streamstats_t stats;
+    struct _PDCLIB_streamstats_t total;
+    char buffer[ 10 ];
+
+    /* Writing */
+    TESTCASE( ( fh = fopen( testfile, "wb" ) ) != NULL );
+    TESTCASE( _PDCLIB_streamstats( fh, &stats ) == 0 );
+    TESTCASE( stats.bytes_written == 0 );
+    TESTCASE( stats.flushes == 0 );
+    TESTCASE( fwrite( "0123456789", 1, 10, fh ) == 10 );
+    TESTCASE( _PDCLIB_streamstats( fh, &stats ) == 0 );
+    TESTCASE( stats.bytes_written == 0 );
+    TESTCASE( fflush( fh ) == 0 );
+    TESTCASE( _PDCLIB_streamstats( fh, &stats ) == 0 );
+    TESTCASE( stats.bytes_written == 10 );
+    TESTCASE( stats.flushes == 1 );
+    TESTCASE( stats.bytes_read == 0 );
+    TESTCASE( stats.fills == 0 );
+    TESTCASE( stats.contentions == 0 );
+    /* Closed streams are kept in the totals */
+    TESTCASE( _PDCLIB_streamstats( NULL, &total ) == 0 );
+    TESTCASE( total.bytes_written >= 10 );
+    TESTCASE( fclose( fh ) == 0 );
+    TESTCASE( _PDCLIB_streamstats( NULL, &stats ) == 0 );
+    TESTCASE( stats.bytes_written == total.bytes_written );
+    TESTCASE( stats.flushes >= total.flushes );
+    /* Reading and seeking */
+    TESTCASE( ( fh = fopen( testfile, "rb" ) ) != NULL );
+    TESTCASE( fgetc( fh ) == '0' );
+    TESTCASE( _PDCLIB_streamstats( fh, &stats ) == 0 );
+    TESTCASE( stats.bytes_read == 10 );
+    TESTCASE( stats.fills == 1 );
+    TESTCASE( stats.seeks == 0 );
+    TESTCASE( fseek( fh, 5, SEEK_SET ) == 0 );
+    TESTCASE( fgetc( fh ) == '5' );
+    TESTCASE( fseek( fh, 0, SEEK_END ) == 0 );
+    TESTCASE( fgetc( fh ) == EOF );
+    TESTCASE( _PDCLIB_streamstats( fh, &stats ) == 0 );
+    TESTCASE( stats.seeks == 1 );
+    TESTCASE( stats.fills == 2 );
+    TESTCASE( stats.bytes_read == 10 );
+    TESTCASE( stats.bytes_written == 0 );
+    TESTCASE( fclose( fh ) == 0 );
+    TESTCASE( remove( testfile ) == 0 );
+    /* Cookie streams */
+    TESTCASE( ( fh = fmemopen( ( void * )"abcdef", 6, "r" ) ) != NULL );
+    TESTCASE( fread( buffer, 1, 3, fh ) == 3 );
+    TESTCASE( _PDCLIB_streamstats( fh, &stats ) == 0 );
+    TESTCASE( stats.bytes_read == 6 );
+    TESTCASE( stats.fills == 1 );
+    TESTCASE( fclose( fh ) == 0 );
+    /* Dump */
+    TESTCASE( ( fh = fopen( testfile, "wb+" ) ) != NULL );
+    TESTCASE( _PDCLIB_dumpstreamstats( fh ) == 0 );
+    rewind( fh );
+    TESTCASE( fread( buffer, 1, 7, fh ) == 7 );
+    TESTCASE( memcmp( buffer, "stream ", 7 ) == 0 );
+    TESTCASE( fclose( fh ) == 0 );
+    TESTCASE( remove( testfile ) == 0 );
+#endif
+#endif
+    return TEST_RESULTS;
+}
+
+#endif
@@ -1,4 +1,4 @@
-/* _PDCLIB_strtod_main( const char *, char ** )
+/* _PDCLIB_strtod_main( const char *, size_t, int, int, uint_least64_t[ 2 ], int *, char * )
 
    This file is part of the Public Domain C Library (PDCLib).
    Permission is granted to use, modify, and / or redistribute at will.
@@ -10,110 +10,770 @@
 #ifndef REGTEST
 
 #include <ctype.h>
-#include <stdio.h>
+#include <errno.h>
+#include <stddef.h>
 #include <string.h>
 
-/* This is a work in progress; this function will later serve as backend
-   for strtof(), strtod() and strtold(), but is currently being implemented
-   in terms of strtod() alone.
+/* The conversion works on 128 bit unsigned integers, built from two 64 bit
+   halves.
+*/
+typedef struct
+{
+    _PDCLIB_uint_least64_t hi;
+    _PDCLIB_uint_least64_t lo;
+} u128;
+
+/* Powers of ten, 10^0 to 10^19, exact. */
+static const _PDCLIB_uint_least64_t pow10_small[ 20 ] =
+{
+    _PDCLIB_UINT_LEAST64_C( 1 ),
+    _PDCLIB_UINT_LEAST64_C( 10 ),
+    _PDCLIB_UINT_LEAST64_C( 100 ),
+    _PDCLIB_UINT_LEAST64_C( 1000 ),
+    _PDCLIB_UINT_LEAST64_C( 10000 ),
+    _PDCLIB_UINT_LEAST64_C( 100000 ),
+    _PDCLIB_UINT_LEAST64_C( 1000000 ),
+    _PDCLIB_UINT_LEAST64_C( 10000000 ),
+    _PDCLIB_UINT_LEAST64_C( 100000000 ),
+    _PDCLIB_UINT_LEAST64_C( 1000000000 ),
+    _PDCLIB_UINT_LEAST64_C( 10000000000 ),
+    _PDCLIB_UINT_LEAST64_C( 100000000000 ),
+    _PDCLIB_UINT_LEAST64_C( 1000000000000 ),
+    _PDCLIB_UINT_LEAST64_C( 10000000000000 ),
+    _PDCLIB_UINT_LEAST64_C( 100000000000000 ),
+    _PDCLIB_UINT_LEAST64_C( 1000000000000000 ),
+    _PDCLIB_UINT_LEAST64_C( 10000000000000000 ),
+    _PDCLIB_UINT_LEAST64_C( 100000000000000000 ),
+    _PDCLIB_UINT_LEAST64_C( 1000000000000000000 ),
+    _PDCLIB_UINT_LEAST64_C( 10000000000000000000 )
+};
+
+/* Powers of ten, 10^( 20 * j ) for j from POW10_MIN to POW10_MAX, as 128 bit
+   mantissa (most significant bit set, truncated) and binary exponent.
+*/
+#define POW10_STEP 20
+#define POW10_MIN ( -17 )
+#define POW10_MAX 16
+
+static const struct
+{
+    _PDCLIB_uint_least64_t hi;
+    _PDCLIB_uint_least64_t lo;
+    int exp;
+} pow10_large[ POW10_MAX - POW10_MIN + 1 ] =
+{
+    { _PDCLIB_UINT_LEAST64_C( 0xbaaee17fa23ebf76 ), _PDCLIB_UINT_LEAST64_C( 0x5d79bcf00d2df649 ), -1257 }, /* 10^-340 */
+    { _PDCLIB_UINT_LEAST64_C( 0xfd00b897478238d0 ), _PDCLIB_UINT_LEAST64_C( 0x8920b098955522b4 ), -1191 }, /* 10^-320 */
+    { _PDCLIB_UINT_LEAST64_C( 0xab70fe17c79ac6ca ), _PDCLIB_UINT_LEAST64_C( 0x6dbd630a48aaf406 ), -1124 }, /* 10^-300 */
+    { _PDCLIB_UINT_LEAST64_C( 0xe858ad248f5c22c9 ), _PDCLIB_UINT_LEAST64_C( 0xd1b3400f8f9cff68 ), -1058 }, /* 10^-280 */
+    { _PDCLIB_UINT_LEAST64_C( 0x9d71ac8fada6c9b5 ), _PDCLIB_UINT_LEAST64_C( 0x6f773fc3603db4a9 ),  -991 }, /* 10^-260 */
+    { _PDCLIB_UINT_LEAST64_C( 0xd5605fcdcf32e1d6 ), _PDCLIB_UINT_LEAST64_C( 0xfb1e4a9a90880a64 ),  -925 }, /* 10^-240 */
+    { _PDCLIB_UINT_LEAST64_C( 0x9096ea6f3848984f ), _PDCLIB_UINT_LEAST64_C( 0x3ff0d2c85def7621 ),  -858 }, /* 10^-220 */
+    { _PDCLIB_UINT_LEAST64_C( 0xc3f490aa77bd60fc ), _PDCLIB_UINT_LEAST64_C( 0xbedbfc4411068a9c ),  -792 }, /* 10^-200 */
+    { _PDCLIB_UINT_LEAST64_C( 0x84c8d4dfd2c63f3b ), _PDCLIB_UINT_LEAST64_C( 0x29ecd9f40041e073 ),  -725 }, /* 10^-180 */
+    { _PDCLIB_UINT_LEAST64_C( 0xb3f4e093db73a093 ), _PDCLIB_UINT_LEAST64_C( 0x59ed216765690f56 ),  -659 }, /* 10^-160 */
+    { _PDCLIB_UINT_LEAST64_C( 0xf3e2f893dec3f126 ), _PDCLIB_UINT_LEAST64_C( 0x5a89dba3c3efccfa ),  -593 }, /* 10^-140 */
+    { _PDCLIB_UINT_LEAST64_C( 0xa54394fe1eedb8fe ), _PDCLIB_UINT_LEAST64_C( 0xc2974eb4ee658828 ),  -526 }, /* 10^-120 */
+    { _PDCLIB_UINT_LEAST64_C( 0xdff9772470297ebd ), _PDCLIB_UINT_LEAST64_C( 0x59787e2b93bc56f7 ),  -460 }, /* 10^-100 */
+    { _PDCLIB_UINT_LEAST64_C( 0x97c560ba6b0919a5 ), _PDCLIB_UINT_LEAST64_C( 0xdccd879fc967d41a ),  -393 }, /* 10^-80 */
+    { _PDCLIB_UINT_LEAST64_C( 0xcdb02555653131b6 ), _PDCLIB_UINT_LEAST64_C( 0x3792f412cb06794d ),  -327 }, /* 10^-60 */
+    { _PDCLIB_UINT_LEAST64_C( 0x8b61313bbabce2c6 ), _PDCLIB_UINT_LEAST64_C( 0x2323ac4b3b3da015 ),  -260 }, /* 10^-40 */
+    { _PDCLIB_UINT_LEAST64_C( 0xbce5086492111aea ), _PDCLIB_UINT_LEAST64_C( 0x88f4bb1ca6bcf584 ),  -194 }, /* 10^-20 */
+    { _PDCLIB_UINT_LEAST64_C( 0x8000000000000000 ), _PDCLIB_UINT_LEAST64_C( 0x0000000000000000 ),  -127 }, /* 10^0 */
+    { _PDCLIB_UINT_LEAST64_C( 0xad78ebc5ac620000 ), _PDCLIB_UINT_LEAST64_C( 0x0000000000000000 ),   -61 }, /* 10^20 */
+    { _PDCLIB_UINT_LEAST64_C( 0xeb194f8e1ae525fd ), _PDCLIB_UINT_LEAST64_C( 0x5dcfab0800000000 ),     5 }, /* 10^40 */
+    { _PDCLIB_UINT_LEAST64_C( 0x9f4f2726179a2245 ), _PDCLIB_UINT_LEAST64_C( 0x01d762422c946590 ),    72 }, /* 10^60 */
+    { _PDCLIB_UINT_LEAST64_C( 0xd7e77a8f87daf7fb ), _PDCLIB_UINT_LEAST64_C( 0xdc33745ec97be906 ),   138 }, /* 10^80 */
+    { _PDCLIB_UINT_LEAST64_C( 0x924d692ca61be758 ), _PDCLIB_UINT_LEAST64_C( 0x593c2626705f9c56 ),   205 }, /* 10^100 */
+    { _PDCLIB_UINT_LEAST64_C( 0xc646d63501a1511d ), _PDCLIB_UINT_LEAST64_C( 0xb281e1fd541501b8 ),   271 }, /* 10^120 */
+    { _PDCLIB_UINT_LEAST64_C( 0x865b86925b9bc5c2 ), _PDCLIB_UINT_LEAST64_C( 0x0b8a2392ba45a9b2 ),   338 }, /* 10^140 */
+    { _PDCLIB_UINT_LEAST64_C( 0xb616a12b7fe617aa ), _PDCLIB_UINT_LEAST64_C( 0x577b986b314d6009 ),   404 }, /* 10^160 */
+    { _PDCLIB_UINT_LEAST64_C( 0xf6c69a72a3989f5b ), _PDCLIB_UINT_LEAST64_C( 0x8aad549e57273d45 ),   470 }, /* 10^180 */
+    { _PDCLIB_UINT_LEAST64_C( 0xa738c6bebb12d16c ), _PDCLIB_UINT_LEAST64_C( 0xb428f8ac016561db ),   537 }, /* 10^200 */
+    { _PDCLIB_UINT_LEAST64_C( 0xe2a0b5dc971f303a ), _PDCLIB_UINT_LEAST64_C( 0x2e44ae64840fd61d ),   603 }, /* 10^220 */
+    { _PDCLIB_UINT_LEAST64_C( 0x9991a6f3d6bf1765 ), _PDCLIB_UINT_LEAST64_C( 0xacca6da1e0a8ef29 ),   670 }, /* 10^240 */
+    { _PDCLIB_UINT_LEAST64_C( 0xd01fef10a657842c ), _PDCLIB_UINT_LEAST64_C( 0x2d2b7569b0432d85 ),   736 }, /* 10^260 */
+    { _PDCLIB_UINT_LEAST64_C( 0x8d07e33455637eb2 ), _PDCLIB_UINT_LEAST64_C( 0xdb0b487b6423e1e8 ),   803 }, /* 10^280 */
+    { _PDCLIB_UINT_LEAST64_C( 0xbf21e44003acdd2c ), _PDCLIB_UINT_LEAST64_C( 0xe0470a63e6bd56c3 ),   869 }, /* 10^300 */
+    { _PDCLIB_UINT_LEAST64_C( 0x81842f29f2cce375 ), _PDCLIB_UINT_LEAST64_C( 0xe6a1158300d46640 ),   936 }  /* 10^320 */
+};
+
+/* Digits collected into the 128 bit integer (38 nines being below 2^127). */
+#define DIGITS_MAX 38
+
+/* The significant digits of a decimal input: count digits (not counting a
+   decimal point in between) from first, the first being of magnitude 10^x.
 */
-static double _PDCLIB_strtod_main( const char * nptr, char ** endptr )
+struct digits_t
+{
+    const char * first;
+    const char * point;
+    long count;
+    long x;
+};
+
+/* 64 x 64 -> 128 bit multiplication. */
+static u128 mul64( _PDCLIB_uint_least64_t a, _PDCLIB_uint_least64_t b )
+{
+    _PDCLIB_uint_least64_t a_lo = a & 0xffffffffu;
+    _PDCLIB_uint_least64_t a_hi = a >> 32;
+    _PDCLIB_uint_least64_t b_lo = b & 0xffffffffu;
+    _PDCLIB_uint_least64_t b_hi = b >> 32;
+    _PDCLIB_uint_least64_t lo_lo = a_lo * b_lo;
+    _PDCLIB_uint_least64_t hi_lo = a_hi * b_lo;
+    _PDCLIB_uint_least64_t lo_hi = a_lo * b_hi;
+    _PDCLIB_uint_least64_t mid = ( lo_lo >> 32 ) + ( hi_lo & 0xffffffffu ) + lo_hi;
+    u128 rc;
+
+    rc.hi = a_hi * b_hi + ( hi_lo >> 32 ) + ( mid >> 32 );
+    rc.lo = ( mid << 32 ) | ( lo_lo & 0xffffffffu );
+    return rc;
+}
+
+static u128 sub128( u128 a, u128 b )
+{
+    u128 rc;
+
+    rc.hi = a.hi - b.hi - ( a.lo < b.lo );
+    rc.lo = a.lo - b.lo;
+    return rc;
+}
+
+/* Returns less than, equal to, or greater than zero. */
+static int compare128( u128 a, u128 b )
+{
+    if ( a.hi != b.hi )
+    {
+        return ( a.hi < b.hi ) ? -1 : 1;
+    }
+
+    return ( a.lo < b.lo ) ? -1 : ( a.lo > b.lo );
+}
+
+/* Shifts right by n bits (n at most 128). */
+static u128 shift_right( u128 a, int n )
+{
+    if ( n >= 128 )
+    {
+        a.hi = 0;
+        a.lo = 0;
+    }
+    else if ( n >= 64 )
+    {
+        a.lo = a.hi >> ( n - 64 );
+        a.hi = 0;
+    }
+    else if ( n > 0 )
+    {
+        a.lo = ( a.lo >> n ) | ( a.hi << ( 64 - n ) );
+        a.hi >>= n;
+    }
+
+    return a;
+}
+
+/* Returns the n least significant bits (n at most 128). */
+static u128 low_bits( u128 a, int n )
+{
+    if ( n < 64 )
+    {
+        a.hi = 0;
+        a.lo &= ( ( _PDCLIB_uint_least64_t )1 << n ) - 1;
+    }
+    else if ( n < 128 )
+    {
+        a.hi &= ( ( _PDCLIB_uint_least64_t )1 << ( n - 64 ) ) - 1;
+    }
+
+    return a;
+}
+
+/* Shifts a nonzero value left until its most significant bit is set,
+   adjusting the binary exponent accordingly.
+*/
+static void normalize( u128 * a, long * exp )
+{
+    int n;
+
+    if ( a->hi == 0 )
+    {
+        a->hi = a->lo;
+        a->lo = 0;
+        *exp -= 64;
+    }
+
+    for ( n = 32; n > 0; n /= 2 )
+    {
+        if ( ( a->hi >> ( 64 - n ) ) == 0 )
+        {
+            a->hi = ( a->hi << n ) | ( a->lo >> ( 64 - n ) );
+            a->lo <<= n;
+            *exp -= n;
+        }
+    }
+}
+
+/* Multiplies a * 2^exp by b * 2^b_exp (both normalized), keeping the most
+   significant 128 bits of the product (normalized). Returns nonzero if
+   nonzero bits were dropped.
+*/
+static int mul128( u128 * a, long * exp, u128 b, long b_exp )
+{
+    u128 hh = mul64( a->hi, b.hi );
+    u128 hl = mul64( a->hi, b.lo );
+    u128 lh = mul64( a->lo, b.hi );
+    u128 ll = mul64( a->lo, b.lo );
+    /* Product in 64 bit words, most significant first */
+    _PDCLIB_uint_least64_t w0, w1, w2, w3;
+    _PDCLIB_uint_least64_t carry;
+
+    w3 = ll.lo;
+    w2 = ll.hi + hl.lo;
+    carry = ( w2 < hl.lo );
+    w2 += lh.lo;
+    carry += ( w2 < lh.lo );
+    w1 = hh.lo + carry;
+    carry = ( w1 < carry );
+    w1 += hl.hi;
+    carry += ( w1 < hl.hi );
+    w1 += lh.hi;
+    carry += ( w1 < lh.hi );
+    w0 = hh.hi + carry;
+
+    *exp += b_exp + 128;
+
+    if ( ( w0 >> 63 ) == 0 )
+    {
+        w0 = ( w0 << 1 ) | ( w1 >> 63 );
+        w1 = ( w1 << 1 ) | ( w2 >> 63 );
+        w2 <<= 1;
+        --*exp;
+    }
+
+    a->hi = w0;
+    a->lo = w1;
+    return ( w2 | w3 ) != 0;
+}
+
+/* Rounds a * 2^exp (a normalized) to mant_dig bits, or fewer in the
+   subnormal range. The value converted is known to be at least a, and
+   less than a + err units in the last place of a (err nonzero), or a plus
+   some fraction of a unit (sticky nonzero) or exactly a (both zero).
+   Sets m and exp to the rounded mantissa and the exponent of its least
+   significant bit, and inexact to nonzero if the value was not exactly
+   representable.
+   Returns zero, with m and exp set to the truncated value, if err is too
+   large to tell.
+*/
+static int round_bits( u128 a, long * exp, unsigned long err, int sticky, _PDCLIB_size_t mant_dig, int min_exp, u128 * m, int * inexact )
+{
+    /* Exponent of the value as used by <float.h>, and bits to keep */
+    long x = *exp + 128;
+    long bits = ( long )mant_dig;
+    u128 rem;
+    u128 half;
+    u128 delta;
+    u128 ones;
+    int shift;
+    int cmp;
+    int up;
+
+    if ( x < min_exp )
+    {
+        /* Subnormal */
+        bits -= min_exp - x;
+    }
+
+    delta.hi = 0;
+    delta.lo = err;
+    ones.hi = ~( _PDCLIB_uint_least64_t )0;
+    ones.lo = ~( _PDCLIB_uint_least64_t )0;
+
+    if ( bits < 0 )
+    {
+        /* Below half the smallest subnormal (unless err might carry into
+           the next binade, reaching half)
+        */
+        m->hi = 0;
+        m->lo = 0;
+        *exp = min_exp - ( long )mant_dig;
+        *inexact = 1;
+        return bits < -1 || compare128( sub128( ones, a ), delta ) >= 0;
+    }
+
+    shift = 128 - ( int )bits;
+    *m = shift_right( a, shift );
+    *exp += shift;
+    rem = low_bits( a, shift );
+    half.hi = ( _PDCLIB_uint_least64_t )1 << 63;
+    half.lo = 0;
+    half = shift_right( half, 128 - shift );
+    cmp = compare128( rem, half );
+
+    if ( err == 0 )
+    {
+        up = ( cmp > 0 ) || ( cmp == 0 && ( sticky || ( m->lo & 1 ) ) );
+        *inexact = sticky || rem.hi != 0 || rem.lo != 0;
+    }
+    else
+    {
+        /* Clear of the midpoint? */
+        if ( cmp <= 0 && ( compare128( half, delta ) < 0 || compare128( rem, sub128( half, delta ) ) > 0 ) )
+        {
+            return 0;
+        }
+
+        /* Clear of the representable values (telling about underflow)? */
+        if ( bits < ( long )mant_dig && ( compare128( rem, delta ) < 0 || compare128( sub128( low_bits( ones, shift ), rem ), delta ) < 0 ) )
+        {
+            return 0;
+        }
+
+        up = ( cmp > 0 );
+        *inexact = 1;
+    }
+
+    if ( up )
+    {
+        if ( ++m->lo == 0 )
+        {
+            ++m->hi;
+        }
+
+        if ( shift_right( *m, ( int )mant_dig ).lo != 0 )
+        {
+            /* Carry into the next binade */
+            *m = shift_right( *m, 1 );
+            ++*exp;
+        }
+    }
+
+    return 1;
+}
+
+/* Converts the significant digits, with their 38 leading digits w and an
+   exponent q of the last of those, as w * 10^q. The power of ten is taken
+   as 10^r (exact) times 10^( POW10_STEP * j ) from the table, chaining the
+   table's largest entries for j outside its range. Each product is
+   truncated, so the result is never above the value, and short of it by
+   less than err units in its last place: for factors short by e1 and e2
+   units, the product is short by less than 2 * ( e1 + e2 ) + 1 units
+   (plus one for the truncation, and one for normalization).
+   Returns as round_bits().
+*/
+static int decimal_bits( struct digits_t const * digits, _PDCLIB_size_t mant_dig, int min_exp, u128 * m, long * exp, int * inexact )
+{
+    u128 a;
+    u128 b;
+    const char * p = digits->first;
+    long count = ( digits->count < DIGITS_MAX ) ? digits->count : DIGITS_MAX;
+    long q = digits->x - count + 1;
+    long j;
+    long i;
+    int r;
+    int dropped;
+    unsigned long err = 0;
+
+    a.hi = 0;
+    a.lo = 0;
+
+    for ( i = 0; i < count; ++i, ++p )
+    {
+        if ( p == digits->point )
+        {
+            ++p;
+        }
+
+        if ( i < 19 )
+        {
+            a.lo = a.lo * 10 + ( unsigned )( *p - '0' );
+        }
+        else
+        {
+            b = mul64( a.lo, 10 );
+            a.lo = b.lo + ( unsigned )( *p - '0' );
+            a.hi = a.hi * 10 + b.hi + ( a.lo < b.lo );
+        }
+    }
+
+    for ( ; i < digits->count; ++i, ++p )
+    {
+        if ( p == digits->point )
+        {
+            ++p;
+        }
+
+        if ( *p != '0' )
+        {
+            /* a * 10^q < value < ( a + 1 ) * 10^q, with a at least 10^37
+               (above 2^122), i.e. short by less than 2^128 / 2^122 units.
+            */
+            err = 64;
+            break;
+        }
+    }
+
+    j = ( q >= 0 ) ? q / POW10_STEP : -( ( -q + POW10_STEP - 1 ) / POW10_STEP );
+    r = ( int )( q - j * POW10_STEP );
+    *exp = 0;
+
+    if ( a.hi == 0 )
+    {
+        a = mul64( a.lo, pow10_small[ r ] );
+        normalize( &a, exp );
+    }
+    else
+    {
+        normalize( &a, exp );
+        b.hi = pow10_small[ r ];
+        b.lo = 0;
+        i = -64;
+        normalize( &b, &i );
+        dropped = mul128( &a, exp, b, i );
+        err = ( err > 0 ) ? 2 * err + 2 : ( unsigned long )dropped;
+    }
+
+    while ( j != 0 )
+    {
+        i = ( j > POW10_MAX ) ? POW10_MAX : ( j < POW10_MIN ) ? POW10_MIN : j;
+        b.hi = pow10_large[ i - POW10_MIN ].hi;
+        b.lo = pow10_large[ i - POW10_MIN ].lo;
+        dropped = mul128( &a, exp, b, pow10_large[ i - POW10_MIN ].exp );
+
+        /* Table entries are exact for 10^0 to 10^40 */
+        if ( i < 0 || i > 2 )
+        {
+            err = 2 * ( err + 1 ) + 2;
+        }
+        else if ( err > 0 )
+        {
+            err = 2 * err + 2;
+        }
+        else
+        {
+            err = ( unsigned long )dropped;
+        }
+
+        j -= i;
+    }
+
+    return round_bits( a, exp, err, 0, mant_dig, min_exp, m, inexact );
+}
+
+/* Compares the value of the digits to n * 2^exp (n nonzero), exactly. */
+static int compare_digits( struct digits_t const * digits, u128 n, long exp )
 {
-    double value = 0.0;
-    int base = 0;
-    char sign = '+';
+    _PDCLIB_decimal_t decimal;
+    char input[ 64 ];
+    char value[ 64 ];
+    const char * p = digits->first;
+    long count;
+    long i;
+    long k;
+    int shift;
+    int rc;
+
+    decimal.size = 0;
+
+    for ( shift = 112; shift >= 0; shift -= 16 )
+    {
+        _PDCLIB_decimal_muladd( &decimal, 1u << 16, ( _PDCLIB_decimal_limb_t )( shift_right( n, shift ).lo & 0xffffu ) );
+    }
+
+    _PDCLIB_decimal_scale( &decimal, ( int )exp, 0 );
+
+    if ( digits->x != _PDCLIB_decimal_exp( &decimal ) )
+    {
+        return ( digits->x < _PDCLIB_decimal_exp( &decimal ) ) ? -1 : 1;
+    }
+
+    /* Same magnitude; compare digit by digit (padding with zeroes). */
+    for ( i = 0; i < digits->count || i < decimal.digits; i += count )
+    {
+        count = ( ( digits->count > decimal.digits ) ? digits->count : decimal.digits ) - i;
+        count = ( count < ( long )sizeof( input ) ) ? count : ( long )sizeof( input );
+
+        for ( k = 0; k < count; ++k )
+        {
+            if ( i + k < digits->count )
+            {
+                if ( p == digits->point )
+                {
+                    ++p;
+                }
+
+                input[ k ] = *p++;
+            }
+            else
+            {
+                input[ k ] = '0';
+            }
+        }
+
+        if ( i < decimal.digits )
+        {
+            _PDCLIB_decimal_tostring( &decimal, i, ( decimal.digits - i < count ) ? decimal.digits - i : count, value );
+        }
+
+        for ( k = ( decimal.digits - i > 0 ) ? decimal.digits - i : 0; k < count; ++k )
+        {
+            value[ k ] = '0';
+        }
+
+        if ( ( rc = memcmp( input, value, ( size_t )count ) ) != 0 )
+        {
+            return rc;
+        }
+    }
+
+    return 0;
+}
+
+const char * _PDCLIB_strtod_main( const char * nptr, _PDCLIB_size_t mant_dig, int min_exp, int max_exp, _PDCLIB_uint_least64_t mant[ 2 ], int * exp, char * sign )
+{
+    int base = 10;
     const char * dec_end;
     const char * frac_end;
     const char * exp_end;
-    const char * p = _PDCLIB_strtox_prelim( nptr, &sign, &base );
+    const char * s;
+    const char * p = _PDCLIB_strtox_prelim( nptr, sign, &base );
+    struct digits_t digits;
+    u128 m;
+    long e;
+    long x = 0;
+    int cmp;
+    int inexact = 0;
 
-    if ( endptr != NULL )
+    mant[ 0 ] = 0;
+    mant[ 1 ] = 0;
+    *exp = 0;
+
+    /* Infinity */
+    if ( tolower( p[0] ) == 'i' && tolower( p[1] ) == 'n' && tolower( p[2] ) == 'f' )
     {
-        *endptr = (char *)nptr;
+        *exp = INT_MAX;
+
+        if ( tolower( p[3] ) == 'i' &&
+             tolower( p[4] ) == 'n' &&
+             tolower( p[5] ) == 'i' &&
+             tolower( p[6] ) == 't' &&
+             tolower( p[7] ) == 'y' )
+        {
+            return p + 8;
+        }
+
+        return p + 3;
     }
 
-    _PDCLIB_strtod_scan( p, &dec_end, &frac_end, &exp_end, base );
+    /* Not a number */
+    if ( tolower( p[0] ) == 'n' && tolower( p[1] ) == 'a' && tolower( p[2] ) == 'n' )
+    {
+        *exp = INT_MIN;
+        p += 3;
+        s = p;
 
-    //printf( "p: %s   base: %d   dec_end: %s   frac_end: %s   exp_end: %s\n", p, base, dec_end, frac_end, exp_end );
+        if ( *p++ == '(' )
+        {
+            while ( isalnum( ( unsigned char )*p ) || *p == '_' )
+            {
+                ++p;
+            }
 
-    switch ( base )
+            if ( *p == ')' )
+            {
+                return p + 1;
+            }
+        }
+
+        return s;
+    }
+
+    /* Hexadecimal, unless "0x" is not followed by digits (in which case
+       the "0" is converted).
+    */
+    if ( p[0] == '0' && ( p[1] == 'x' || p[1] == 'X' ) )
     {
-        case 10:
+        _PDCLIB_strtod_scan( p + 2, &dec_end, &frac_end, &exp_end, 16 );
+
+        if ( exp_end != p + 2 )
+        {
+            base = 16;
+            p += 2;
+        }
+    }
+
+    if ( base == 10 )
+    {
+        _PDCLIB_strtod_scan( p, &dec_end, &frac_end, &exp_end, 10 );
+
+        if ( exp_end == p )
+        {
+            /* No conversion */
+            *sign = '+';
+            return NULL;
+        }
+    }
+
+    /* Exponent (saturating way beyond any meaningful value) */
+    if ( exp_end != frac_end )
+    {
+        s = frac_end + 1;
+
+        if ( *s == '+' || *s == '-' )
+        {
+            ++s;
+        }
+
+        for ( ; s != exp_end && x < 100000000L; ++s )
+        {
+            x = x * 10 + ( *s - '0' );
+        }
+
+        if ( frac_end[1] == '-' )
+        {
+            x = -x;
+        }
+    }
+
+    /* Leading zeroes */
+    digits.point = ( dec_end != frac_end ) ? dec_end : NULL;
+
+    for ( s = p; s != frac_end && ( *s == '0' || s == digits.point ); ++s )
+    {
+        /* EMPTY */
+    }
+
+    if ( s == frac_end )
+    {
+        /* Zero */
+        return exp_end;
+    }
+
+    digits.first = s;
+    digits.count = ( long )( frac_end - s ) - ( ( digits.point != NULL && s < digits.point ) ? 1 : 0 );
+
+    if ( base == 16 )
+    {
+        /* Up to 32 digits exactly, the rest only telling whether they are
+           all zero. Binary exponent of the last digit collected.
+        */
+        m.hi = 0;
+        m.lo = 0;
+        e = x;
+
+        if ( digits.point != NULL && s > digits.point )
+        {
+            e -= 4 * ( s - digits.point - 1 );
+        }
+
+        for ( ; s != frac_end; ++s )
+        {
+            if ( s == digits.point )
             {
-                /* Infinity */
-                if ( tolower( p[0] ) == 'i' && tolower( p[1] ) == 'n' && tolower( p[2] ) == 'f' )
+                continue;
+            }
+
+            if ( ( m.hi >> 60 ) == 0 )
+            {
+                m.hi = ( m.hi << 4 ) | ( m.lo >> 60 );
+                m.lo = ( m.lo << 4 ) | ( unsigned )( ( *s <= '9' ) ? *s - '0' : ( *s | 0x20 ) - 'a' + 10 );
+
+                if ( digits.point != NULL && s > digits.point )
                 {
-                    value = 1.0 / 0.0;
-
-                    if ( sign == '-' )
-                    {
-                        value *= -1;
-                    }
-
-                    if ( endptr != NULL )
-                    {
-                        if ( tolower( p[3] ) == 'i' &&
-                             tolower( p[4] ) == 'n' &&
-                             tolower( p[5] ) == 'i' &&
-                             tolower( p[6] ) == 't' &&
-                             tolower( p[7] ) == 'y' )
-                        {
-                            *endptr = (char *)p + 8;
-                        }
-                        else
-                        {
-                            *endptr = (char *)p + 3;
-                        }
-                    }
-
-                    return value;
+                    e -= 4;
+                }
+            }
+            else
+            {
+                if ( digits.point == NULL || s < digits.point )
+                {
+                    e += 4;
                 }
 
-                /* Not a number */
-                if ( tolower( p[0] ) == 'n' && tolower( p[1] ) == 'a' && tolower( p[2] ) == 'n' )
+                if ( *s != '0' )
                 {
-                    value = 0.0 / 0.0;
-
-                    if ( endptr != NULL )
-                    {
-                        p += 3;
-                        *endptr = (char *)p;
-
-                        if ( *p++ == '(' )
-                        {
-                            while ( isalnum( *p ) )
-                            {
-                                ++p;
-                            }
-
-                            if ( *p == ')' )
-                            {
-                                *endptr = (char *)p + 1;
-                            }
-                        }
-                    }
-
-                    return value;
+                    inexact = 1;
                 }
+            }
+        }
 
-                /* TODO: base-10 conversion */
+        normalize( &m, &e );
+        round_bits( m, &e, 0, inexact, mant_dig, min_exp, &m, &inexact );
+    }
+    else
+    {
+        digits.x = x + ( ( s < dec_end ) ? ( dec_end - s - 1 ) : -( s - dec_end ) );
 
-                return 0.0;
-            }
-        case 16:
+        if ( digits.x > ( max_exp * 302L ) / 1000 + 1 )
+        {
+            /* Overflow */
+            m.hi = 0;
+            m.lo = 0;
+            e = LONG_MAX;
+        }
+        else if ( digits.x < ( ( min_exp - ( long )mant_dig ) * 302L ) / 1000 - 2 )
+        {
+            /* Underflow */
+            m.hi = 0;
+            m.lo = 0;
+            e = min_exp - ( long )mant_dig;
+            inexact = 1;
+        }
+        else if ( ! decimal_bits( &digits, mant_dig, min_exp, &m, &e, &inexact ) )
+        {
+            /* Too close to call. Starting from the truncated value, compare
+               the digits against the exact midpoint to the next mantissa.
+            */
+            for ( ;; )
             {
-                /* TODO: base-16 conversion */
-            }
-        default:
-            {
-                if ( endptr != NULL )
+                u128 n;
+
+                n.hi = ( m.hi << 1 ) | ( m.lo >> 63 );
+                n.lo = ( m.lo << 1 ) | 1;
+
+                if ( ( cmp = compare_digits( &digits, n, e - 1 ) ) < 0 || ( cmp == 0 && ( m.lo & 1 ) == 0 ) )
+                {
+                    break;
+                }
+
+                if ( ++m.lo == 0 )
+                {
+                    ++m.hi;
+                }
+
+                if ( shift_right( m, ( int )mant_dig ).lo != 0 )
                 {
-                    *endptr = (char *)exp_end;
+                    m = shift_right( m, 1 );
+                    ++e;
                 }
 
-                return 0.0;
+                if ( cmp == 0 )
+                {
+                    break;
+                }
             }
+
+            inexact = ( m.hi == 0 && m.lo == 0 ) || compare_digits( &digits, m, e ) != 0;
+        }
     }
+
+    if ( e > max_exp - ( long )mant_dig )
+    {
+        errno = ERANGE;
+        *exp = INT_MAX;
+        return exp_end;
+    }
+
+    if ( inexact && shift_right( m, ( int )mant_dig - 1 ).lo == 0 )
+    {
+        /* Subnormal (or zero) and inexact */
+        errno = ERANGE;
+    }
+
+    mant[ 0 ] = m.hi;
+    mant[ 1 ] = m.lo;
+    *exp = ( int )e;
+    return exp_end;
 }
 
 #endif
@@ -122,79 +782,68 @@ static double _PDCLIB_strtod_main( const char * nptr, char ** endptr )
 
 #include "_PDCLIB_test.h"
 
-#include <stddef.h>
+#include <errno.h>
 
 #ifndef REGTEST
-#define strtod _PDCLIB_strtod_main
+
+static int check( const char * s, ptrdiff_t end, _PDCLIB_uint_least64_t mant, int exp, char sign, int range )
+{
+    _PDCLIB_uint_least64_t m[ 2 ];
+    const char * p;
+    int e;
+    char c = '+';
+
+    errno = 0;
+    p = _PDCLIB_strtod_main( s, 53, -1021, 1024, m, &e, &c );
+    return ( ( end < 0 ) ? p == NULL : p == s + end ) && m[ 0 ] == 0 && m[ 1 ] == mant && e == exp && c == sign && ( errno == ERANGE ) == range;
+}
+
 #endif
 
 int main( void )
 {
-    char * endptr;
-    unsigned i;
-    char const * tests[] =
-    {
-        "0.0", "+0.0", "-0.0",
-        "0", "+0", "-0",
-        "inf", "+inf", "-inf",
-        "3.14", "+3.14", "-3.14",
-        "45.1237e6", "+45.1237e+6", "-45.1237e-6",
-        "0xa.bcdp+6", "+0x000.001p-1", "-0x12p4", "0x.123p-6", "0x123.p-5",
-        ".123e-4", "123.e-4",
-        ".e", ".", "",
-        "foo"
-    };
-    double expected_doubles[] =
-    {
-        0x0p+0, 0x0p+0, -0x0p+0,
-        0.0, 0.0, 0.0,
-        ( 1.0 / 0.0 ), ( 1.0 / 0.0 ), ( -1.0 / 0.0 ),
-        0x1.91eb851eb851fp+1, 0x1.91eb851eb851fp+1, -0x1.91eb851eb851fp+1,
-        0x1.58443ap+25, 0x1.58443ap+25, -0x1.7a86686b4c9fep-15,
-        0x1.579ap+9, 0x1p-13, -0x1.2p+8, 0x1.23p-10, 0x1.23p+3,
-        0x1.9cb8320b1507p-17, 0x1.930be0ded288dp-7,
-        0x0p+0, 0x0p+0, 0x0p+0,
-        0.0
-    };
-    ptrdiff_t expected_endptr[] =
-    {
-        3, 4, 4,
-        1, 2, 2,
-        3, 4, 4,
-        4, 5, 5,
-        9, 11, 11,
-        10, 13, 7, 9, 9,
-        7, 7,
-        0, 0, 0,
-        0
-    };
-    char const * nan_tests[] =
-    {
-        "nan", "+nan", "-nan",
-        "nan(foo)", "nan(foo", "nan(foo42bar)",
-        "nan()", "nan(42)", "nan( )"
-    };
-    ptrdiff_t nan_expected_endptr[] =
-    {
-        3, 4, 4,
-        8, 3, 13,
-        5, 7, 3
-    };
-
-    for ( i = 0; i < sizeof( tests ) / sizeof( tests[0] ); ++i )
-    {
-        double d = strtod( tests[i], &endptr );
-        TESTCASE( d == expected_doubles[i] );
-        TESTCASE( ( endptr - tests[i] ) == expected_endptr[i] );
-    }
-
-    for ( i = 0; i < sizeof( nan_tests ) / sizeof( nan_tests[0] ); ++i )
-    {
-        double d = strtod( nan_tests[i], &endptr );
-        TESTCASE( d != d );
-        TESTCASE( ( endptr - nan_tests[i] ) == nan_expected_endptr[i] );
+#ifndef REGTEST
+    /* No conversion */
+    TESTCASE( check( "", -1, 0, 0, '+', 0 ) );
+    TESTCASE( check( "foo", -1, 0, 0, '+', 0 ) );
+    TESTCASE( check( " -.e1", -1, 0, 0, '+', 0 ) );
+    TESTCASE( check( "-e1", -1, 0, 0, '+', 0 ) );
+    /* Zero, infinity, not a number */
+    TESTCASE( check( "0", 1, 0, 0, '+', 0 ) );
+    TESTCASE( check( "-0x0p99", 7, 0, 0, '-', 0 ) );
+    TESTCASE( check( "0x", 1, 0, 0, '+', 0 ) );
+    TESTCASE( check( "-Infinity", 9, 0, INT_MAX, '-', 0 ) );
+    TESTCASE( check( "nan(1)", 6, 0, INT_MIN, '+', 0 ) );
+    /* Mantissa normalized to mant_dig bits */
+    TESTCASE( check( "1", 1, _PDCLIB_UINT_LEAST64_C( 0x10000000000000 ), -52, '+', 0 ) );
+    TESTCASE( check( "0x1p0", 5, _PDCLIB_UINT_LEAST64_C( 0x10000000000000 ), -52, '+', 0 ) );
+    TESTCASE( check( "0.1", 3, _PDCLIB_UINT_LEAST64_C( 0x1999999999999a ), -56, '+', 0 ) );
+    /* Ties to even, exactly and beyond 38 digits */
+    TESTCASE( check( "9007199254740993", 16, _PDCLIB_UINT_LEAST64_C( 0x10000000000000 ), 1, '+', 0 ) );
+    TESTCASE( check( "9007199254740995", 16, _PDCLIB_UINT_LEAST64_C( 0x10000000000002 ), 1, '+', 0 ) );
+    TESTCASE( check( "9007199254740993.000000000000000000000000000000", 47, _PDCLIB_UINT_LEAST64_C( 0x10000000000000 ), 1, '+', 0 ) );
+    TESTCASE( check( "9007199254740993.000000000000000000000000000001", 47, _PDCLIB_UINT_LEAST64_C( 0x10000000000001 ), 1, '+', 0 ) );
+    TESTCASE( check( "0x20000000000001p0", 18, _PDCLIB_UINT_LEAST64_C( 0x10000000000000 ), 1, '+', 0 ) );
+    TESTCASE( check( "0x20000000000001000000000000000000001p0", 39, _PDCLIB_UINT_LEAST64_C( 0x10000000000001 ), 85, '+', 0 ) );
+    /* Largest / smallest values, and beyond */
+    TESTCASE( check( "1.7976931348623157e308", 22, _PDCLIB_UINT_LEAST64_C( 0x1fffffffffffff ), 971, '+', 0 ) );
+    TESTCASE( check( "1.7976931348623159e308", 22, 0, INT_MAX, '+', 1 ) );
+    TESTCASE( check( "1e400", 5, 0, INT_MAX, '+', 1 ) );
+    TESTCASE( check( "2.2250738585072014e-308", 23, _PDCLIB_UINT_LEAST64_C( 0x10000000000000 ), -1074, '+', 0 ) );
+    TESTCASE( check( "2.2250738585072011e-308", 23, _PDCLIB_UINT_LEAST64_C( 0xfffffffffffff ), -1074, '+', 1 ) );
+    TESTCASE( check( "4.9e-324", 8, 1, -1074, '+', 1 ) );
+    TESTCASE( check( "0x1p-1074", 9, 1, -1074, '+', 0 ) );
+    TESTCASE( check( "0x1p-1075", 9, 0, -1074, '+', 1 ) );
+    TESTCASE( check( "1e-400", 6, 0, -1074, '+', 1 ) );
+    /* Exactly half the smallest subnormal, and slightly above */
+    {
+        char buffer[ 800 ] = "2.4703282292062327208828439643411068618252990130716238221279284125033775363510437593264991818081799618989828234772285886546332835517796989819938739800539093906315035659515570226392290858392449105184435931802849936536152500319370457678249219365623669863658480757001585769269903706311928279558551332927834338409351978015531246597263579574622766465272827220056374006485499977096599470454020828166226237857393450736339007967761930577506740176324673600968951340535537458516661134223766678604162159680461914467291840300530057530849048765391711386591646239524912623653881879636239373280423891018672348497668235089863388587925628302755995657524455507255189313690836254779186948667994968324049705821028513185451396213837722826145437693412532098591327667236328125e-324";
+        size_t len = strlen( buffer );
+        TESTCASE( check( buffer, ( ptrdiff_t )len, 0, -1074, '+', 1 ) );
+        buffer[ len - 6 ] = '6';
+        TESTCASE( check( buffer, ( ptrdiff_t )len, 1, -1074, '+', 1 ) );
     }
-
+#endif
     return TEST_RESULTS;
 }
 
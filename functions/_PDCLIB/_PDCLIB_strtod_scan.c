@@ -9,33 +9,49 @@
 #include <locale.h>
 #include <stdlib.h>
 
+/* Skips the digits (to the given base, 10 or 16) at s. The digits being
+   the same in every locale, they are compared directly rather than through
+   isdigit() / isxdigit().
+*/
+static const char * skip_digits( const char * s, int base )
+{
+    for ( ;; )
+    {
+        if ( ( *s >= '0' && *s <= '9' ) ||
+             ( base == 16 && ( ( *s >= 'a' && *s <= 'f' ) || ( *s >= 'A' && *s <= 'F' ) ) ) )
+        {
+            ++s;
+        }
+        else
+        {
+            return s;
+        }
+    }
+}
+
 /* This function scans a (potential) floating point input, determining
    where each part (decimal, fractional, exponent) ends. The actual
    values are discarded, as they need to be interpreted in floating
    point context, not integer.
+   (Digits are skipped directly rather than through strtol(), which would
+   accept whitespace and signs within the input.)
 */
 void _PDCLIB_strtod_scan( const char * s, const char ** dec, const char ** frac, const char ** exp, int base )
 {
     char decimal_point = '.';
     struct lconv * lconv;
+    const char * p;
 
     if ( ( lconv = localeconv() ) != NULL )
     {
         decimal_point = *lconv->decimal_point;
     }
 
-    strtol( (char *)s, (char **)dec, base );
+    *dec = skip_digits( s, base );
 
     if ( **dec == decimal_point )
     {
-        strtol( (char *)( *dec + 1 ), (char **)frac, base );
-
-        if ( *dec == s && *frac == s + 1 )
-        {
-            *frac = s;
-            *exp = s;
-            return;
-        }
+        *frac = skip_digits( *dec + 1, base );
     }
     else
     {
@@ -43,24 +59,32 @@ void _PDCLIB_strtod_scan( const char * s, const char ** dec, const char ** frac,
         *frac = *dec;
     }
 
-    if ( base == 10 && ( **frac == 'e' || **frac == 'E' ) )
+    if ( *dec == s && *frac <= s + 1 )
     {
-        strtol( (char *)( *frac + 1 ), (char **)exp, base );
-    }
-    else if ( base == 16 && ( **frac == 'p' || **frac == 'P' ) )
-    {
-        strtol( (char *)( *frac + 1 ), (char **)exp, 10 );
-    }
-    else
-    {
-        /* no exponent part */
-        *exp = *frac;
+        /* no digits (and thus no exponent part either) */
+        *frac = s;
+        *exp = s;
+        return;
     }
 
-    if ( *exp == *frac + 1 )
+    /* no exponent part (unless there are digits following the lead) */
+    *exp = *frac;
+
+    if ( ( base == 10 && ( **frac == 'e' || **frac == 'E' ) ) ||
+         ( base == 16 && ( **frac == 'p' || **frac == 'P' ) ) )
     {
-        /* exponent "lead" ('e', 'p') but no digits */
-        *exp = *frac;
+        p = *frac + 1;
+
+        if ( *p == '+' || *p == '-' )
+        {
+            ++p;
+        }
+
+        /* exponent is decimal for either base */
+        if ( *p >= '0' && *p <= '9' )
+        {
+            *exp = skip_digits( p, 10 );
+        }
     }
 
     return;
@@ -81,7 +105,8 @@ int main( void )
     const char * s[] =
         { "12.34e56", ".12e34", "98e76", "12.34", ".34", "18",
           "1.2e3", ".1e2", "1e2", "1.2", ".1", "1",
-          ".", ".e", "e", "1.e", ".1e"
+          ".", ".e", "e", "1.e", ".1e",
+          "1. 5", "1.-5", "1e 5", "1e+", "a.bp-3", "e5"
         };
 
     _PDCLIB_strtod_scan( s[0], &dec, &frac, &exp, 10 );
@@ -168,6 +193,36 @@ int main( void )
     TESTCASE( dec == s[16] );
     TESTCASE( frac == s[16] + 2 );
     TESTCASE( exp == s[16] + 2 );
+
+    /* No whitespace / sign within the number */
+    _PDCLIB_strtod_scan( s[17], &dec, &frac, &exp, 10 );
+    TESTCASE( dec == s[17] + 1 );
+    TESTCASE( frac == s[17] + 2 );
+    TESTCASE( exp == s[17] + 2 );
+
+    _PDCLIB_strtod_scan( s[18], &dec, &frac, &exp, 10 );
+    TESTCASE( frac == s[18] + 2 );
+    TESTCASE( exp == s[18] + 2 );
+
+    _PDCLIB_strtod_scan( s[19], &dec, &frac, &exp, 10 );
+    TESTCASE( frac == s[19] + 1 );
+    TESTCASE( exp == s[19] + 1 );
+
+    _PDCLIB_strtod_scan( s[20], &dec, &frac, &exp, 10 );
+    TESTCASE( frac == s[20] + 1 );
+    TESTCASE( exp == s[20] + 1 );
+
+    /* Hexadecimal, decimal exponent */
+    _PDCLIB_strtod_scan( s[21], &dec, &frac, &exp, 16 );
+    TESTCASE( dec == s[21] + 1 );
+    TESTCASE( frac == s[21] + 3 );
+    TESTCASE( exp == s[21] + 6 );
+
+    /* No exponent part without digits */
+    _PDCLIB_strtod_scan( s[22], &dec, &frac, &exp, 10 );
+    TESTCASE( dec == s[22] );
+    TESTCASE( frac == s[22] );
+    TESTCASE( exp == s[22] );
 #endif
 
     return TEST_RESULTS;
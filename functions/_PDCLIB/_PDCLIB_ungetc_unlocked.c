@@ -0,0 +1,56 @@
+/* _PDCLIB_ungetc_unlocked( int, FILE * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#include <stdio.h>
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_internal.h"
+
+int _PDCLIB_ungetc_unlocked( int c, struct _PDCLIB_file_t * stream )
+{
+    if ( c == EOF )
+    {
+        return EOF;
+    }
+
+    if ( ( stream->status & _PDCLIB_FREAD ) && ! ( stream->status & _PDCLIB_FWRITE ) &&
+         stream->ungetidx == 0 && stream->bufidx > 0 && stream->bufidx <= stream->bufend &&
+         ( unsigned char )stream->buffer[ stream->bufidx - 1 ] == ( unsigned char )c )
+    {
+        /* Character last read from the buffer (which is not written to
+           while reading, and might be read-only if memory-mapped); step
+           back instead of storing it.
+        */
+        --stream->bufidx;
+    }
+    else if ( stream->ungetidx < _PDCLIB_UNGETCBUFSIZE )
+    {
+        stream->ungetbuf[ stream->ungetidx++ ] = ( unsigned char )c;
+    }
+    else
+    {
+        /* No room */
+        return EOF;
+    }
+
+    stream->status &= ~_PDCLIB_EOFFLAG;
+    return ( unsigned char )c;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+    /* Testing covered by ungetc.c */
+    return TEST_RESULTS;
+}
+
+#endif
@@ -0,0 +1,52 @@
+/* _PDCLIB_unrefstreams( FILE **, size_t )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifndef REGTEST
+
+#ifndef __STDC_NO_THREADS__
+#include <threads.h>
+extern mtx_t _PDCLIB_filelist_mtx;
+#endif
+
+void _PDCLIB_unrefstreams( struct _PDCLIB_file_t ** streams, size_t count )
+{
+    size_t i;
+
+    _PDCLIB_LOCK( _PDCLIB_filelist_mtx );
+
+    for ( i = 0; i < count; ++i )
+    {
+        struct _PDCLIB_file_t * stream = streams[ i ];
+
+        if ( --stream->refs == 0 && ! _PDCLIB_isstream( stream ) &&
+             stream != stdin && stream != stdout && stream != stderr )
+        {
+            /* Closed while referenced; fclose() left freeing it to us. */
+            free( stream );
+        }
+    }
+
+    _PDCLIB_UNLOCK( _PDCLIB_filelist_mtx );
+
+    free( streams );
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+    /* Testing covered by _PDCLIB_refstreams.c */
+    return TEST_RESULTS;
+}
+
+#endif
@@ -0,0 +1,114 @@
+/* _PDCLIB_vfprintf_format( FILE *, const struct _PDCLIB_format_t *, va_list )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_glue.h"
+#include "pdclib/_PDCLIB_print.h"
+
+#ifndef __STDC_NO_THREADS__
+#include <threads.h>
+#endif
+
+int _PDCLIB_vfprintf_format( struct _PDCLIB_file_t * _PDCLIB_restrict stream, const struct _PDCLIB_format_t * _PDCLIB_restrict format, va_list arg )
+{
+    const struct _PDCLIB_printop_t * op = format->ops;
+    const struct _PDCLIB_printop_t * end = op + format->count;
+    struct _PDCLIB_status_t status;
+    int locked;
+    status.base = 0;
+    status.flags = 0;
+    status.n = SIZE_MAX;
+    status.i = 0;
+    status.current = 0;
+    status.s = NULL;
+    status.width = 0;
+    status.prec = EOF;
+    status.stream = stream;
+
+    locked = _PDCLIB_LOCKFILE( stream );
+
+    if ( _PDCLIB_prepwrite( stream ) == EOF )
+    {
+        _PDCLIB_UNLOCKFILE( stream, locked );
+        return EOF;
+    }
+
+    va_copy( status.arg, arg );
+
+    for ( ; op != end; ++op )
+    {
+        if ( op->text != NULL )
+        {
+            _PDCLIB_print_span( op->text, op->length, &status );
+        }
+        else
+        {
+            _PDCLIB_print_conversion( op, &status );
+        }
+
+        if ( stream->status & _PDCLIB_ERRORFLAG )
+        {
+            va_end( status.arg );
+            _PDCLIB_UNLOCKFILE( stream, locked );
+            return EOF;
+        }
+    }
+
+    va_end( status.arg );
+    _PDCLIB_UNLOCKFILE( stream, locked );
+    return status.i;
+}
+
+#endif
+
+#ifdef TEST
+
+#include <stddef.h>
+#include <float.h>
+
+#define _PDCLIB_FILEID "_PDCLIB/_PDCLIB_vfprintf_format.c"
+#define _PDCLIB_FILEIO
+
+#include "_PDCLIB_test.h"
+
+#ifndef REGTEST
+
+static int testprintf( FILE * stream, const char * format, ... )
+{
+    struct _PDCLIB_format_t * compiled;
+    int i = -2;
+    va_list arg;
+    va_start( arg, format );
+
+    if ( ( compiled = _PDCLIB_compileformat( format ) ) != NULL )
+    {
+        i = _PDCLIB_vfprintf_format( stream, compiled, arg );
+        _PDCLIB_freeformat( compiled );
+    }
+
+    va_end( arg );
+    return i;
+}
+
+#endif
+
+int main( void )
+{
+#ifndef REGTEST
+    FILE * target;
+    TESTCASE( ( target = tmpfile() ) != NULL );
+#include "printf_testcases.h"
+    TESTCASE( fclose( target ) == 0 );
+#endif
+    return TEST_RESULTS;
+}
+
+#endif
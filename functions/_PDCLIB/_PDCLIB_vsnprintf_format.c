@@ -0,0 +1,99 @@
+/* _PDCLIB_vsnprintf_format( char *, size_t, const struct _PDCLIB_format_t *, va_list )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#include <stdarg.h>
+#include <stdio.h>
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_print.h"
+
+int _PDCLIB_vsnprintf_format( char * _PDCLIB_restrict s, size_t n, const struct _PDCLIB_format_t * _PDCLIB_restrict format, va_list arg )
+{
+    const struct _PDCLIB_printop_t * op = format->ops;
+    const struct _PDCLIB_printop_t * end = op + format->count;
+    struct _PDCLIB_status_t status;
+    status.base = 0;
+    status.flags = 0;
+    status.n = n;
+    status.i = 0;
+    status.current = 0;
+    status.s = s;
+    status.width = 0;
+    status.prec = EOF;
+    status.stream = NULL;
+    va_copy( status.arg, arg );
+
+    for ( ; op != end; ++op )
+    {
+        if ( op->text != NULL )
+        {
+            _PDCLIB_print_span( op->text, op->length, &status );
+        }
+        else
+        {
+            _PDCLIB_print_conversion( op, &status );
+        }
+    }
+
+    if ( status.i  < n )
+    {
+        s[ status.i ] = '\0';
+    }
+    else if ( n > 0 )
+    {
+        /* Output truncated */
+        s[ n - 1 ] = '\0';
+    }
+
+    va_end( status.arg );
+    return status.i;
+}
+
+#endif
+
+#ifdef TEST
+
+#include <stddef.h>
+#include <stdint.h>
+#include <float.h>
+
+#define _PDCLIB_FILEID "_PDCLIB/_PDCLIB_vsnprintf_format.c"
+#define _PDCLIB_STRINGIO
+
+#include "_PDCLIB_test.h"
+
+#ifndef REGTEST
+
+static int testprintf( char * s, const char * format, ... )
+{
+    struct _PDCLIB_format_t * compiled;
+    int i = -2;
+    va_list arg;
+    va_start( arg, format );
+
+    if ( ( compiled = _PDCLIB_compileformat( format ) ) != NULL )
+    {
+        i = _PDCLIB_vsnprintf_format( s, 100, compiled, arg );
+        _PDCLIB_freeformat( compiled );
+    }
+
+    va_end( arg );
+    return i;
+}
+
+#endif
+
+int main( void )
+{
+#ifndef REGTEST
+    char target[100];
+#include "printf_testcases.h"
+#endif
+    return TEST_RESULTS;
+}
+
+#endif
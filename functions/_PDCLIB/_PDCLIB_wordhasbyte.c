@@ -0,0 +1,63 @@
+/* _PDCLIB_wordhasbyte( const void *, unsigned char )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_internal.h"
+
+#include <limits.h>
+#include <string.h>
+
+int _PDCLIB_wordhasbyte( const void * p, unsigned char c )
+{
+    const _PDCLIB_size_t ones = ( ( _PDCLIB_size_t )-1 ) / UCHAR_MAX;
+    const _PDCLIB_size_t highs = ones << ( CHAR_BIT - 1 );
+    _PDCLIB_size_t word;
+
+    /* memcpy() instead of dereferencing a size_t pointer, which would break
+       strict aliasing; compilers turn it into a plain load.
+    */
+    memcpy( &word, p, sizeof( word ) );
+    word ^= ones * c;
+
+    /* "Word contains a zero byte", from Hacker's Delight */
+    return ( ( word - ones ) & ~word & highs ) != 0;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+#ifndef REGTEST
+    unsigned char buffer[ sizeof( _PDCLIB_size_t ) * 2 ];
+    _PDCLIB_size_t i;
+
+    memset( buffer, 'x', sizeof( buffer ) );
+    TESTCASE( ! _PDCLIB_wordhasbyte( buffer, '\n' ) );
+    TESTCASE( _PDCLIB_wordhasbyte( buffer, 'x' ) );
+
+    /* Each position in the word, at an unaligned address */
+    for ( i = 0; i < sizeof( _PDCLIB_size_t ); ++i )
+    {
+        buffer[ 1 + i ] = '\n';
+        TESTCASE( _PDCLIB_wordhasbyte( buffer + 1, '\n' ) );
+        TESTCASE( ! _PDCLIB_wordhasbyte( buffer + 1, '\0' ) );
+        buffer[ 1 + i ] = 'x';
+    }
+
+    /* Bytes with the high bit set */
+    buffer[ 3 ] = 0xff;
+    TESTCASE( _PDCLIB_wordhasbyte( buffer, 0xff ) );
+    TESTCASE( ! _PDCLIB_wordhasbyte( buffer, 0x7f ) );
+#endif
+    return TEST_RESULTS;
+}
+
+#endif
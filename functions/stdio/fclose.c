@@ -18,66 +18,131 @@ extern mtx_t _PDCLIB_filelist_mtx;
 
 extern struct _PDCLIB_file_t * _PDCLIB_filelist;
 
+#ifdef _PDCLIB_STREAMSTATS
+extern struct _PDCLIB_streamstats_t _PDCLIB_closedstats;
+#endif
+
 int fclose( struct _PDCLIB_file_t * stream )
 {
-    _PDCLIB_LOCK( _PDCLIB_filelist_mtx );
-    _PDCLIB_LOCK( stream->mtx );
+#ifdef _PDCLIB_STREAMSTATS
+    struct _PDCLIB_streamstats_t stats;
+#endif
+    char * filename;
+    int delonclose;
+    int dofree;
+    int rc = 0;
+
+    /* Flushing and closing is done holding the stream lock only, so a
+       stream that is slow to close does not hold up opening / closing of
+       other streams. _PDCLIB_filelist_mtx is taken for unlinking only.
+    */
+    _PDCLIB_FLOCK( stream->lock );
+
+    /* Closed meanwhile (see below), e.g. by _PDCLIB_closeall() */
+    if ( ! _PDCLIB_isstream( stream ) || ( stream->status & _PDCLIB_FCLOSED ) )
+    {
+        _PDCLIB_FUNLOCK( stream->lock );
+        *_PDCLIB_errno_func() = _PDCLIB_EBADF;
+        return EOF;
+    }
 
-    /* Flush buffer */
+    /* Flush buffer. The stream is closed even if that fails (there is no
+       retrying fclose()), only the return value reports the error.
+    */
     if ( stream->status & _PDCLIB_FWRITE )
     {
         if ( _PDCLIB_flushbuffer( stream ) == EOF )
         {
             /* Flush failed, errno already set */
-            _PDCLIB_UNLOCK( stream->mtx );
-            _PDCLIB_UNLOCK( _PDCLIB_filelist_mtx );
-            return EOF;
+            rc = EOF;
+        }
+
+#ifndef __STDC_NO_THREADS__
+
+        if ( _PDCLIB_waitasync( stream ) == EOF )
+        {
+            /* Deferred write failed, errno already set */
+            rc = EOF;
         }
+
+#endif
     }
 
-    /* Close handle */
-    _PDCLIB_close( stream->handle );
+#ifndef __STDC_NO_THREADS__
+    /* Stop worker thread */
+    _PDCLIB_endasync( stream );
+#endif
 
-    /* Remove stream from list */
-    if ( _PDCLIB_getstream( stream ) )
+    /* Close handle (or cookie) */
+    if ( stream->status & _PDCLIB_FCOOKIE )
     {
-        _PDCLIB_UNLOCK( stream->mtx );
-        _PDCLIB_UNLOCK( _PDCLIB_filelist_mtx );
-        return EOF;
+        _PDCLIB_cookieclose( stream );
     }
-
-    /* Delete tmpfile() */
-    if ( stream->status & _PDCLIB_DELONCLOSE )
+    else
     {
-        _PDCLIB_remove( stream->filename );
+        _PDCLIB_close( stream->handle );
     }
 
+#ifdef _PDCLIB_STREAMSTATS
+    _PDCLIB_streamstats( stream, &stats );
+#endif
+
     /* Free buffer */
     if ( stream->status & _PDCLIB_FREEBUFFER )
     {
         free( stream->buffer );
     }
+    else if ( stream->status & _PDCLIB_FMMAP )
+    {
+        _PDCLIB_unmapfile( stream );
+    }
 
-    /* Free filename (standard streams do not have one, but free( NULL )
-       is a valid no-op)
+    /* Until unlinked, the stream is still found by fflush( NULL ) (which
+       skips it as not writable) and _PDCLIB_closeall() (see above). The
+       filename, still looked at by rename(), is released after that.
     */
-    free( stream->filename );
+    filename = stream->filename;
+    delonclose = ( stream->status & _PDCLIB_DELONCLOSE ) != 0;
+    stream->status &= ~( _PDCLIB_FREAD | _PDCLIB_FWRITE | _PDCLIB_FREEBUFFER | _PDCLIB_FMMAP );
+    stream->status |= _PDCLIB_FCLOSED;
 
-    _PDCLIB_UNLOCK( stream->mtx );
+    _PDCLIB_FUNLOCK( stream->lock );
 
-#ifndef __STDC_NO_THREADS__
-    mtx_destroy( &stream->mtx );
+    _PDCLIB_LOCK( _PDCLIB_filelist_mtx );
+
+    /* Remove stream from list */
+    _PDCLIB_getstream( stream );
+
+#ifdef _PDCLIB_STREAMSTATS
+    /* Keep statistics for the process totals (see _PDCLIB_streamstats()) */
+    _PDCLIB_addstreamstats( &_PDCLIB_closedstats, &stats );
 #endif
 
-    /* Free stream */
-    if ( stream != stdin && stream != stdout && stream != stderr )
+    /* Free stream, unless referenced by _PDCLIB_refstreams(), in which case
+       _PDCLIB_unrefstreams() does it (so the stream must not be accessed
+       after unlocking).
+    */
+    dofree = ( stream != stdin && stream != stdout && stream != stderr && stream->refs == 0 );
+
+    _PDCLIB_UNLOCK( _PDCLIB_filelist_mtx );
+
+    /* Delete tmpfile() */
+    if ( delonclose )
     {
-        free( stream );
+        _PDCLIB_remove( filename );
     }
 
-    _PDCLIB_UNLOCK( _PDCLIB_filelist_mtx );
+    /* Free filename (standard streams do not have one, but free( NULL )
+       is a valid no-op)
+    */
+    free( filename );
 
-    return 0;
+    if ( dofree )
+    {
+        free( stream );
+    }
+
+    return rc;
 }
 
 #endif
@@ -86,6 +151,8 @@ int fclose( struct _PDCLIB_file_t * stream )
 
 #include "_PDCLIB_test.h"
 
+#include <errno.h>
+
 int main( void )
 {
 #ifndef REGTEST
@@ -106,6 +173,33 @@ int main( void )
     TESTCASE( _PDCLIB_filelist == file2 );
     TESTCASE( fclose( file2 ) == 0 );
     TESTCASE( _PDCLIB_filelist == stdin );
+    /* Closing again while referenced (as by _PDCLIB_closeall()) */
+    {
+        struct _PDCLIB_file_t ** streams;
+        size_t count;
+        TESTCASE( ( file1 = fopen( testfile1, "w" ) ) != NULL );
+        TESTCASE( ( streams = _PDCLIB_refstreams( &count ) ) != NULL );
+        TESTCASE( fputs( "x", file1 ) >= 0 );
+        TESTCASE( fclose( file1 ) == 0 );
+        TESTCASE( _PDCLIB_filelist == stdin );
+        errno = 0;
+        TESTCASE( fclose( file1 ) == EOF );
+        TESTCASE( errno == EBADF );
+        _PDCLIB_unrefstreams( streams, count );
+    }
+#ifndef __STDC_NO_THREADS__
+    /* A failed deferred write is reported, but the stream closed anyway */
+    if ( ( file1 = fopen( "/dev/full", "wd" ) ) != NULL )
+    {
+        TESTCASE( setvbuf( file1, NULL, _IOFBF, 16 ) == 0 );
+        TESTCASE( fwrite( "0123456789abcdef", 1, 16, file1 ) == 16 );
+        TESTCASE( _PDCLIB_filelist == file1 );
+        errno = 0;
+        TESTCASE( fclose( file1 ) == EOF );
+        TESTCASE( errno == ENOSPC );
+        TESTCASE( _PDCLIB_filelist == stdin );
+    }
+#endif
     TESTCASE( remove( testfile1 ) == 0 );
     TESTCASE( remove( testfile2 ) == 0 );
 #else
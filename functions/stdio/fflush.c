@@ -17,40 +17,93 @@ extern mtx_t _PDCLIB_filelist_mtx;
 
 extern struct _PDCLIB_file_t * _PDCLIB_filelist;
 
+/* Flushes a stream for fflush( NULL ), if it is (still) open for writing.
+   Streams closed meanwhile have been flushed by fclose().
+*/
+static int flushstream( struct _PDCLIB_file_t * stream )
+{
+    int rc = 0;
+
+    _PDCLIB_FLOCK( stream->lock );
+
+    if ( _PDCLIB_isstream( stream ) && ( stream->status & _PDCLIB_FWRITE ) )
+    {
+        rc = _PDCLIB_flushbuffer( stream );
+
+#ifndef __STDC_NO_THREADS__
+
+        if ( _PDCLIB_waitasync( stream ) == EOF )
+        {
+            rc = EOF;
+        }
+
+#endif
+    }
+
+    _PDCLIB_FUNLOCK( stream->lock );
+
+    return rc;
+}
+
 int fflush( struct _PDCLIB_file_t * stream )
 {
     int rc = 0;
 
     if ( stream == NULL )
     {
-        _PDCLIB_LOCK( _PDCLIB_filelist_mtx );
-        stream = _PDCLIB_filelist;
+        struct _PDCLIB_file_t ** streams;
+        size_t count;
+        size_t i;
 
         /* TODO: Check what happens when fflush( NULL ) encounters write errors, in other libs */
-        while ( stream != NULL )
+        if ( ( streams = _PDCLIB_refstreams( &count ) ) != NULL )
         {
-            _PDCLIB_LOCK( stream->mtx );
-
-            if ( stream->status & _PDCLIB_FWRITE )
+            /* Flush streams one by one, without holding
+               _PDCLIB_filelist_mtx, so a stream that is slow to flush does
+               not hold up opening / closing of other streams.
+            */
+            for ( i = 0; i < count; ++i )
             {
-                if ( _PDCLIB_flushbuffer( stream ) == EOF )
+                if ( flushstream( streams[ i ] ) == EOF )
                 {
                     rc = EOF;
                 }
             }
 
-            _PDCLIB_UNLOCK( stream->mtx );
-
-            stream = stream->next;
+            _PDCLIB_unrefstreams( streams, count );
         }
+        else
+        {
+            /* Out of memory; walk the list holding the lock instead. */
+            _PDCLIB_LOCK( _PDCLIB_filelist_mtx );
+
+            for ( stream = _PDCLIB_filelist; stream != NULL; stream = stream->next )
+            {
+                if ( flushstream( stream ) == EOF )
+                {
+                    rc = EOF;
+                }
+            }
 
-        _PDCLIB_UNLOCK( _PDCLIB_filelist_mtx );
+            _PDCLIB_UNLOCK( _PDCLIB_filelist_mtx );
+        }
     }
     else
     {
-        _PDCLIB_LOCK( stream->mtx );
+        _PDCLIB_FLOCK( stream->lock );
         rc = _PDCLIB_flushbuffer( stream );
-        _PDCLIB_UNLOCK( stream->mtx );
+
+#ifndef __STDC_NO_THREADS__
+
+        /* Data handed over to write-behind thread has to be written, too. */
+        if ( _PDCLIB_waitasync( stream ) == EOF )
+        {
+            rc = EOF;
+        }
+
+#endif
+
+        _PDCLIB_FUNLOCK( stream->lock );
     }
 
     return rc;
@@ -17,8 +17,7 @@
 int fgetc( struct _PDCLIB_file_t * stream )
 {
     int rc = EOF;
-
-    _PDCLIB_LOCK( stream->mtx );
+    int locked = _PDCLIB_LOCKFILE( stream );
 
     if ( _PDCLIB_prepread( stream ) != EOF )
     {
@@ -28,7 +27,7 @@ int fgetc( struct _PDCLIB_file_t * stream )
         }
     }
 
-    _PDCLIB_UNLOCK( stream->mtx );
+    _PDCLIB_UNLOCKFILE( stream, locked );
 
     return rc;
 }
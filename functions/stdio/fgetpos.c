@@ -14,11 +14,11 @@
 
 int fgetpos( struct _PDCLIB_file_t * _PDCLIB_restrict stream, struct _PDCLIB_fpos_t * _PDCLIB_restrict pos )
 {
-    _PDCLIB_LOCK( stream->mtx );
+    int locked = _PDCLIB_LOCKFILE( stream );
     pos->offset = ( stream->pos.offset - ( ( ( int )stream->bufend - ( int )stream->bufidx ) + stream->ungetidx ) );
     pos->status = stream->pos.status;
     /* TODO: Add mbstate. */
-    _PDCLIB_UNLOCK( stream->mtx );
+    _PDCLIB_UNLOCKFILE( stream, locked );
     return 0;
 }
 
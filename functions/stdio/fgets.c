@@ -5,6 +5,7 @@
 */
 
 #include <stdio.h>
+#include <string.h>
 
 #ifndef REGTEST
 
@@ -17,8 +18,11 @@
 char * fgets( char * _PDCLIB_restrict s, int size, struct _PDCLIB_file_t * _PDCLIB_restrict stream )
 {
     char * dest = s;
+    size_t left;
+    int done = 0;
+    int locked;
 
-    if ( size == 0 )
+    if ( size <= 0 )
     {
         return NULL;
     }
@@ -29,13 +33,27 @@ char * fgets( char * _PDCLIB_restrict s, int size, struct _PDCLIB_file_t * _PDCL
         return s;
     }
 
-    _PDCLIB_LOCK( stream->mtx );
+    /* Leaving room for the terminating '\0' */
+    left = ( size_t )size - 1;
+
+    locked = _PDCLIB_LOCKFILE( stream );
 
     if ( _PDCLIB_prepread( stream ) != EOF )
     {
-        do
+        /* Characters pushed back by ungetc() come first. */
+        while ( stream->ungetidx > 0 && left > 0 && ! done )
+        {
+            done = ( ( *dest++ = ( char )stream->ungetbuf[ --stream->ungetidx ] ) == '\n' );
+            --left;
+        }
+
+        while ( left > 0 && ! done )
         {
-            if ( _PDCLIB_CHECKBUFFER( stream ) == EOF )
+            const char * src;
+            const char * newline;
+            size_t count;
+
+            if ( stream->bufidx == stream->bufend && _PDCLIB_fillbuffer( stream ) == EOF )
             {
                 /* In case of error / EOF before a character is read, this
                    will lead to a \0 be written anyway. Since the results
@@ -43,11 +61,32 @@ char * fgets( char * _PDCLIB_restrict s, int size, struct _PDCLIB_file_t * _PDCL
                 */
                 break;
             }
+
+            /* Copy up to (and including) the first newline in the buffered
+               characters, in one go.
+            */
+            src = stream->buffer + stream->bufidx;
+            count = stream->bufend - stream->bufidx;
+
+            if ( count > left )
+            {
+                count = left;
+            }
+
+            if ( ( newline = ( const char * )memchr( src, '\n', count ) ) != NULL )
+            {
+                count = newline - src + 1;
+                done = 1;
+            }
+
+            memcpy( dest, src, count );
+            dest += count;
+            stream->bufidx += count;
+            left -= count;
         }
-        while ( ( ( *dest++ = _PDCLIB_GETC( stream ) ) != '\n' ) && ( --size > 0 ) );
     }
 
-    _PDCLIB_UNLOCK( stream->mtx );
+    _PDCLIB_UNLOCKFILE( stream, locked );
 
     *dest = '\0';
     return ( dest == s ) ? NULL : s;
@@ -91,6 +130,23 @@ int main( void )
     TESTCASE( fgets( buffer, 2, fh ) == NULL );
     TESTCASE( feof( fh ) );
     TESTCASE( fclose( fh ) == 0 );
+    /* Lines spanning buffer refills, truncated lines, ungetc() */
+    TESTCASE( ( fh = fopen( testfile, "rb" ) ) != NULL );
+    TESTCASE( setvbuf( fh, NULL, _IOFBF, 3 ) == 0 );
+    TESTCASE( fgets( buffer, 3, fh ) == buffer );
+    TESTCASE( strcmp( buffer, "fo" ) == 0 );
+    TESTCASE( fgets( buffer, 10, fh ) == buffer );
+    TESTCASE( strcmp( buffer, "o\n" ) == 0 );
+    TESTCASE( ungetc( 'x', fh ) == 'x' );
+    TESTCASE( fgets( buffer, 10, fh ) == buffer );
+    TESTCASE( memcmp( buffer, "xbar\0baz\n", 10 ) == 0 );
+    TESTCASE( ungetc( '\n', fh ) == '\n' );
+    TESTCASE( fgets( buffer, 10, fh ) == buffer );
+    TESTCASE( strcmp( buffer, "\n" ) == 0 );
+    TESTCASE( fgets( buffer, 10, fh ) == buffer );
+    TESTCASE( strcmp( buffer, "weenie" ) == 0 );
+    TESTCASE( feof( fh ) );
+    TESTCASE( fclose( fh ) == 0 );
     TESTCASE( remove( testfile ) == 0 );
     return TEST_RESULTS;
 }
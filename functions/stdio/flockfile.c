@@ -0,0 +1,76 @@
+/* flockfile( FILE * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+
+#ifndef REGTEST
+
+#ifndef __STDC_NO_THREADS__
+#include <threads.h>
+#endif
+
+void flockfile( struct _PDCLIB_file_t * stream )
+{
+    /* Not elided like _PDCLIB_LOCKFILE(), as the lock might be held while
+       another thread is created.
+    */
+    _PDCLIB_FLOCK( stream->lock );
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+#ifndef __STDC_NO_THREADS__
+#include <threads.h>
+
+static FILE * fh;
+
+static int trylock( void * arg )
+{
+    ( void )arg;
+
+    if ( ftrylockfile( fh ) == 0 )
+    {
+        funlockfile( fh );
+        return 0;
+    }
+
+    return 1;
+}
+#endif
+
+int main( void )
+{
+#ifndef __STDC_NO_THREADS__
+    thrd_t thread;
+    int rc;
+    TESTCASE( ( fh = tmpfile() ) != NULL );
+    /* Recursive locking */
+    flockfile( fh );
+    flockfile( fh );
+    TESTCASE( ftrylockfile( fh ) == 0 );
+    TESTCASE( fputc( 'x', fh ) == 'x' );
+    funlockfile( fh );
+    funlockfile( fh );
+    /* Other threads cannot acquire the lock while it is held... */
+    TESTCASE( thrd_create( &thread, trylock, NULL ) == thrd_success );
+    TESTCASE( thrd_join( thread, &rc ) == thrd_success );
+    TESTCASE( rc == 1 );
+    funlockfile( fh );
+    /* ...but once it is released. */
+    TESTCASE( thrd_create( &thread, trylock, NULL ) == thrd_success );
+    TESTCASE( thrd_join( thread, &rc ) == thrd_success );
+    TESTCASE( rc == 0 );
+    TESTCASE( fclose( fh ) == 0 );
+#endif
+    return TEST_RESULTS;
+}
+
+#endif
@@ -0,0 +1,149 @@
+/* fmemopen( void *, size_t, const char * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_glue.h"
+
+struct _PDCLIB_file_t * fmemopen( void * _PDCLIB_restrict buf, size_t size, const char * _PDCLIB_restrict mode )
+{
+    struct _PDCLIB_file_t * rc;
+    struct _PDCLIB_memfile_t * mem;
+    cookie_io_functions_t funcs = { _PDCLIB_memread, _PDCLIB_memwrite, _PDCLIB_memseek, _PDCLIB_memclose };
+    unsigned int filemode = _PDCLIB_filemode( mode );
+
+    if ( filemode == 0 || size == 0 )
+    {
+        /* mode or size invalid */
+        *_PDCLIB_errno_func() = _PDCLIB_EINVAL;
+        return NULL;
+    }
+
+    if ( ( mem = (struct _PDCLIB_memfile_t *)malloc( sizeof( struct _PDCLIB_memfile_t ) ) ) == NULL )
+    {
+        /* No memory */
+        *_PDCLIB_errno_func() = _PDCLIB_ENOMEM;
+        return NULL;
+    }
+
+    mem->freedata = ( buf == NULL );
+
+    if ( buf == NULL && ( buf = calloc( size, 1 ) ) == NULL )
+    {
+        /* No memory */
+        free( mem );
+        *_PDCLIB_errno_func() = _PDCLIB_ENOMEM;
+        return NULL;
+    }
+
+    mem->data = (char *)buf;
+    mem->capacity = size;
+    mem->bufp = NULL;
+    mem->sizep = NULL;
+    mem->append = 0;
+
+    if ( filemode & _PDCLIB_FAPPEND )
+    {
+        /* Contents up to the first zero character, written at the end. */
+        char * end = (char *)memchr( mem->data, '\0', size );
+        mem->size = ( end != NULL ) ? ( _PDCLIB_size_t )( end - mem->data ) : size;
+        mem->append = 1;
+    }
+    else if ( filemode & _PDCLIB_FWRITE )
+    {
+        /* Truncated */
+        mem->size = 0;
+        mem->data[ 0 ] = '\0';
+    }
+    else
+    {
+        /* The whole buffer */
+        mem->size = size;
+    }
+
+    mem->pos = mem->append ? mem->size : 0;
+
+    if ( ( rc = fopencookie( mem, mode, funcs ) ) == NULL )
+    {
+        /* errno already set */
+        _PDCLIB_memclose( mem );
+        return NULL;
+    }
+
+    rc->pos.offset = mem->pos;
+    return rc;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+#include <errno.h>
+
+int main( void )
+{
+    char buffer[ 16 ];
+    char out[ 16 ];
+    FILE * fh;
+    /* Reading */
+    memcpy( buffer, "abcdef", 6 );
+    TESTCASE( ( fh = fmemopen( buffer, 6, "r" ) ) != NULL );
+    TESTCASE( fgetc( fh ) == 'a' );
+    TESTCASE( fread( out, 1, 10, fh ) == 5 );
+    TESTCASE( memcmp( out, "bcdef", 5 ) == 0 );
+    TESTCASE( feof( fh ) );
+    TESTCASE( fseek( fh, -2, SEEK_END ) == 0 );
+    TESTCASE( fgetc( fh ) == 'e' );
+    TESTCASE( ftell( fh ) == 5 );
+    TESTCASE( fseek( fh, 7, SEEK_SET ) != 0 );
+    TESTCASE( fclose( fh ) == 0 );
+    /* Writing */
+    memset( buffer, 'x', sizeof( buffer ) );
+    TESTCASE( ( fh = fmemopen( buffer, 8, "w" ) ) != NULL );
+    TESTCASE( fprintf( fh, "%d-%s", 42, "ab" ) == 5 );
+    TESTCASE( fflush( fh ) == 0 );
+    TESTCASE( strcmp( buffer, "42-ab" ) == 0 );
+    TESTCASE( ftell( fh ) == 5 );
+    TESTCASE( fseek( fh, 1, SEEK_SET ) == 0 );
+    TESTCASE( fputc( '3', fh ) == '3' );
+    TESTCASE( fflush( fh ) == 0 );
+    TESTCASE( strcmp( buffer, "43-ab" ) == 0 );
+    TESTCASE( fseek( fh, 0, SEEK_END ) == 0 );
+    TESTCASE( fputs( "cdef", fh ) >= 0 );
+    TESTCASE_NOREG( fflush( fh ) == EOF );
+    TESTCASE_NOREG( errno == ENOSPC );
+    TESTCASE_NOREG( memcmp( buffer, "43-abcde", 8 ) == 0 );
+    TESTCASE( buffer[ 8 ] == 'x' );
+    TESTCASE_NOREG( fclose( fh ) == 0 );
+    /* Appending */
+    strcpy( buffer, "abc" );
+    TESTCASE( ( fh = fmemopen( buffer, 8, "a" ) ) != NULL );
+    TESTCASE( ftell( fh ) == 3 );
+    TESTCASE( fputs( "de", fh ) >= 0 );
+    TESTCASE( fclose( fh ) == 0 );
+    TESTCASE( strcmp( buffer, "abcde" ) == 0 );
+    /* Allocated buffer, update mode */
+    TESTCASE( ( fh = fmemopen( NULL, 4, "w+" ) ) != NULL );
+    TESTCASE( fputs( "xyz", fh ) >= 0 );
+    rewind( fh );
+    TESTCASE( fgets( out, sizeof( out ), fh ) == out );
+    TESTCASE( strcmp( out, "xyz" ) == 0 );
+    TESTCASE( fclose( fh ) == 0 );
+    /* Invalid arguments */
+    TESTCASE_NOREG( fmemopen( buffer, 0, "r" ) == NULL );
+    TESTCASE_NOREG( errno == EINVAL );
+    TESTCASE_NOREG( fmemopen( buffer, 8, "x" ) == NULL );
+    return TEST_RESULTS;
+}
+
+#endif
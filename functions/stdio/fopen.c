@@ -18,8 +18,6 @@
 extern mtx_t _PDCLIB_filelist_mtx;
 #endif
 
-extern struct _PDCLIB_file_t * _PDCLIB_filelist;
-
 struct _PDCLIB_file_t * fopen( const char * _PDCLIB_restrict filename, const char * _PDCLIB_restrict mode )
 {
     struct _PDCLIB_file_t * rc;
@@ -45,30 +43,29 @@ struct _PDCLIB_file_t * fopen( const char * _PDCLIB_restrict filename, const cha
         return NULL;
     }
 
-    /* Setting buffer to _IOLBF because "when opened, a stream is fully
-       buffered if and only if it can be determined not to refer to an
-       interactive device."
-    */
-    rc->status |= filemode | _IOLBF;
+    rc->status |= filemode;
 
     if ( ( rc->handle = _PDCLIB_open( filename, rc->status ) ) == _PDCLIB_NOHANDLE )
     {
         /* OS open() failed */
-#ifndef __STDC_NO_THREADS__
-        mtx_destroy( &rc->mtx );
-#endif
         free( rc->buffer );
         free( rc );
         return NULL;
     }
 
-    /* Getting absolute filename (for potential freopen()) */
-    rc->filename = _PDCLIB_realpath( filename );
+    /* "When opened, a stream is fully buffered if and only if it can be
+       determined not to refer to an interactive device."
+    */
+    rc->status |= _PDCLIB_isinteractive( rc->handle ) ? _IOLBF : _IOFBF;
+
+    /* The absolute filename (for potential freopen()) is only determined
+       when actually needed, see _PDCLIB_realpath().
+    */
+    rc->filename = NULL;
 
     /* Adding to list of open files */
     _PDCLIB_LOCK( _PDCLIB_filelist_mtx );
-    rc->next = _PDCLIB_filelist;
-    _PDCLIB_filelist = rc;
+    _PDCLIB_putstream( rc );
     _PDCLIB_UNLOCK( _PDCLIB_filelist_mtx );
     return rc;
 }
@@ -95,6 +92,8 @@ int main( void )
     TESTCASE_NOREG( fopen( testfile, "wq" ) == NULL ); /* Undefined mode */
     TESTCASE_NOREG( fopen( testfile, "wr" ) == NULL ); /* Undefined mode */
     TESTCASE( ( fh = fopen( testfile, "w" ) ) != NULL );
+    /* Absolute filename not determined before needed by freopen() */
+    TESTCASE_NOREG( fh->filename == NULL );
     TESTCASE( fclose( fh ) == 0 );
     TESTCASE( remove( testfile ) == 0 );
     return TEST_RESULTS;
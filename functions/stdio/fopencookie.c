@@ -0,0 +1,229 @@
+/* fopencookie( void *, const char *, cookie_io_functions_t )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_glue.h"
+
+#ifndef __STDC_NO_THREADS__
+#include <threads.h>
+extern mtx_t _PDCLIB_filelist_mtx;
+#endif
+
+struct _PDCLIB_file_t * fopencookie( void * _PDCLIB_restrict cookie, const char * _PDCLIB_restrict mode, cookie_io_functions_t io_funcs )
+{
+    struct _PDCLIB_file_t * rc;
+    struct _PDCLIB_cookie_t * backend;
+    /* Memory-mapping, read-ahead, write-behind and direct I/O are file
+       specific.
+    */
+    unsigned int filemode = _PDCLIB_filemode( mode ) & ~( _PDCLIB_FMMAP | _PDCLIB_FAHEAD | _PDCLIB_FBEHIND | _PDCLIB_FDIRECT );
+
+    if ( filemode == 0 )
+    {
+        /* mode invalid */
+        *_PDCLIB_errno_func() = _PDCLIB_EINVAL;
+        return NULL;
+    }
+
+    if ( ( backend = (struct _PDCLIB_cookie_t *)malloc( sizeof( struct _PDCLIB_cookie_t ) ) ) == NULL )
+    {
+        /* No memory */
+        *_PDCLIB_errno_func() = _PDCLIB_ENOMEM;
+        return NULL;
+    }
+
+    backend->cookie = cookie;
+    backend->io = io_funcs;
+
+    if ( ( rc = _PDCLIB_init_file_t( NULL ) ) == NULL )
+    {
+        /* initializing FILE structure failed */
+        free( backend );
+        *_PDCLIB_errno_func() = _PDCLIB_ENOMEM;
+        return NULL;
+    }
+
+    /* No telling whether the cookie is interactive; fully buffered. */
+    rc->status |= filemode | _PDCLIB_FCOOKIE | _IOFBF;
+    rc->handle = _PDCLIB_NOHANDLE;
+    rc->cookie = backend;
+    rc->bufsize = BUFSIZ;
+    /* Nothing to reopen */
+    rc->filename = NULL;
+
+    /* Adding to list of open files */
+    _PDCLIB_LOCK( _PDCLIB_filelist_mtx );
+    _PDCLIB_putstream( rc );
+    _PDCLIB_UNLOCK( _PDCLIB_filelist_mtx );
+    return rc;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+#include <errno.h>
+#include <stdint.h>
+
+/* A cookie transforming what is written (rot13), and serving reads from a
+   fixed string, counting calls.
+*/
+struct testcookie
+{
+    char data[ 64 ];
+    size_t size;
+    size_t pos;
+    int writes;
+    int closed;
+};
+
+static ssize_t testread( void * cookie, char * buf, size_t size )
+{
+    struct testcookie * tc = (struct testcookie *)cookie;
+    size_t count = tc->size - tc->pos;
+
+    if ( count > size )
+    {
+        count = size;
+    }
+
+    memcpy( buf, tc->data + tc->pos, count );
+    tc->pos += count;
+    return ( ssize_t )count;
+}
+
+static ssize_t testwrite( void * cookie, const char * buf, size_t size )
+{
+    struct testcookie * tc = (struct testcookie *)cookie;
+    size_t i;
+
+    ++tc->writes;
+
+    if ( size > sizeof( tc->data ) - tc->pos )
+    {
+        errno = ENOSPC;
+        return 0;
+    }
+
+    for ( i = 0; i < size; ++i )
+    {
+        char c = buf[ i ];
+
+        if ( c >= 'a' && c <= 'z' )
+        {
+            c = 'a' + ( c - 'a' + 13 ) % 26;
+        }
+
+        tc->data[ tc->pos++ ] = c;
+    }
+
+    if ( tc->pos > tc->size )
+    {
+        tc->size = tc->pos;
+    }
+
+    return ( ssize_t )size;
+}
+
+static int testseek( void * cookie, int64_t * offset, int whence )
+{
+    struct testcookie * tc = (struct testcookie *)cookie;
+    int64_t pos = *offset;
+
+    if ( whence == SEEK_CUR )
+    {
+        pos += tc->pos;
+    }
+    else if ( whence == SEEK_END )
+    {
+        pos += tc->size;
+    }
+
+    if ( pos < 0 || pos > ( int64_t )tc->size )
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    tc->pos = ( size_t )pos;
+    *offset = pos;
+    return 0;
+}
+
+static int testclose( void * cookie )
+{
+    ( (struct testcookie *)cookie )->closed = 1;
+    return 0;
+}
+
+int main( void )
+{
+    struct testcookie tc;
+    cookie_io_functions_t funcs;
+    char buffer[ 64 ];
+    FILE * fh;
+    memset( &tc, 0, sizeof( tc ) );
+    funcs.read = testread;
+    funcs.write = testwrite;
+    funcs.seek = testseek;
+    funcs.close = testclose;
+    /* Writing goes through the buffer */
+    TESTCASE( ( fh = fopencookie( &tc, "w+", funcs ) ) != NULL );
+    TESTCASE( fputs( "hello", fh ) >= 0 );
+    TESTCASE( fprintf( fh, ", %s %d", "world", 42 ) == 10 );
+    TESTCASE( tc.writes == 0 );
+    TESTCASE( fflush( fh ) == 0 );
+    TESTCASE( tc.writes == 1 );
+    TESTCASE( tc.size == 15 );
+    TESTCASE( memcmp( tc.data, "uryyb, jbeyq 42", 15 ) == 0 );
+    TESTCASE( ftell( fh ) == 15 );
+    /* Reading, seeking */
+    TESTCASE( fseek( fh, 7, SEEK_SET ) == 0 );
+    TESTCASE( fgets( buffer, sizeof( buffer ), fh ) == buffer );
+    TESTCASE( strcmp( buffer, "jbeyq 42" ) == 0 );
+    TESTCASE( feof( fh ) );
+    TESTCASE( fseek( fh, -2, SEEK_END ) == 0 );
+    TESTCASE( fgetc( fh ) == '4' );
+    TESTCASE( fseek( fh, 20, SEEK_SET ) != 0 );
+    TESTCASE( errno == EINVAL );
+    TESTCASE( fclose( fh ) == 0 );
+    TESTCASE( tc.closed );
+    /* File specific modifiers are ignored */
+    tc.pos = 0;
+    TESTCASE( ( fh = fopencookie( &tc, "ru", funcs ) ) != NULL );
+#ifndef REGTEST
+    TESTCASE( ! ( fh->status & _PDCLIB_FDIRECT ) );
+#endif
+    TESTCASE( fgets( buffer, sizeof( buffer ), fh ) == buffer );
+    TESTCASE( strcmp( buffer, "uryyb, jbeyq 42" ) == 0 );
+    TESTCASE( fclose( fh ) == 0 );
+    /* Missing functions */
+    funcs.read = NULL;
+    funcs.write = NULL;
+    funcs.seek = NULL;
+    funcs.close = NULL;
+    TESTCASE( ( fh = fopencookie( &tc, "r+", funcs ) ) != NULL );
+    TESTCASE( fgetc( fh ) == EOF );
+    TESTCASE_NOREG( feof( fh ) );
+    TESTCASE( fseek( fh, 0, SEEK_SET ) != 0 );
+    TESTCASE( fclose( fh ) == 0 );
+    TESTCASE( ( fh = fopencookie( &tc, "w", funcs ) ) != NULL );
+    TESTCASE( fputs( "discarded", fh ) >= 0 );
+    TESTCASE_NOREG( fclose( fh ) == 0 );
+    /* Invalid mode */
+    TESTCASE_NOREG( fopencookie( &tc, "x", funcs ) == NULL );
+    return TEST_RESULTS;
+}
+
+#endif
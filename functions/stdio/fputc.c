@@ -16,11 +16,11 @@
 
 int fputc( int c, struct _PDCLIB_file_t * stream )
 {
-    _PDCLIB_LOCK( stream->mtx );
+    int locked = _PDCLIB_LOCKFILE( stream );
 
     if ( _PDCLIB_prepwrite( stream ) == EOF )
     {
-        _PDCLIB_UNLOCK( stream->mtx );
+        _PDCLIB_UNLOCKFILE( stream, locked );
         return EOF;
     }
 
@@ -35,7 +35,7 @@ int fputc( int c, struct _PDCLIB_file_t * stream )
         c = ( _PDCLIB_flushbuffer( stream ) == 0 ) ? c : EOF;
     }
 
-    _PDCLIB_UNLOCK( stream->mtx );
+    _PDCLIB_UNLOCKFILE( stream, locked );
 
     return c;
 }
@@ -16,11 +16,11 @@
 
 int fputs( const char * _PDCLIB_restrict s, struct _PDCLIB_file_t * _PDCLIB_restrict stream )
 {
-    _PDCLIB_LOCK( stream->mtx );
+    int locked = _PDCLIB_LOCKFILE( stream );
 
     if ( _PDCLIB_prepwrite( stream ) == EOF )
     {
-        _PDCLIB_UNLOCK( stream->mtx );
+        _PDCLIB_UNLOCKFILE( stream, locked );
         return EOF;
     }
 
@@ -38,7 +38,7 @@ int fputs( const char * _PDCLIB_restrict s, struct _PDCLIB_file_t * _PDCLIB_rest
         {
             if ( _PDCLIB_flushbuffer( stream ) == EOF )
             {
-                _PDCLIB_UNLOCK( stream->mtx );
+                _PDCLIB_UNLOCKFILE( stream, locked );
                 return EOF;
             }
         }
@@ -50,12 +50,12 @@ int fputs( const char * _PDCLIB_restrict s, struct _PDCLIB_file_t * _PDCLIB_rest
     {
         if ( _PDCLIB_flushbuffer( stream ) == EOF )
         {
-            _PDCLIB_UNLOCK( stream->mtx );
+            _PDCLIB_UNLOCKFILE( stream, locked );
             return EOF;
         }
     }
 
-    _PDCLIB_UNLOCK( stream->mtx );
+    _PDCLIB_UNLOCKFILE( stream, locked );
 
     return 0;
 }
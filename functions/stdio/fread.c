@@ -17,37 +17,11 @@
 
 size_t fread( void * _PDCLIB_restrict ptr, size_t size, size_t nmemb, struct _PDCLIB_file_t * _PDCLIB_restrict stream )
 {
-    char * dest = ( char * )ptr;
-    size_t nmemb_i = 0;
-
-    _PDCLIB_LOCK( stream->mtx );
-
-    if ( _PDCLIB_prepread( stream ) != EOF )
-    {
-        for ( nmemb_i = 0; nmemb_i < nmemb; ++nmemb_i )
-        {
-            size_t size_i;
-
-            /* TODO: For better performance, move from stream buffer
-               to destination block-wise, not byte-wise.
-            */
-            for ( size_i = 0; size_i < size; ++size_i )
-            {
-                if ( _PDCLIB_CHECKBUFFER( stream ) == EOF )
-                {
-                    /* Could not read requested data */
-                    _PDCLIB_UNLOCK( stream->mtx );
-                    return nmemb_i;
-                }
-
-                dest[ nmemb_i * size + size_i ] = _PDCLIB_GETC( stream );
-            }
-        }
-    }
-
-    _PDCLIB_UNLOCK( stream->mtx );
-
-    return nmemb_i;
+    size_t rc;
+    int locked = _PDCLIB_LOCKFILE( stream );
+    rc = _PDCLIB_fread_unlocked( ptr, size, nmemb, stream );
+    _PDCLIB_UNLOCKFILE( stream, locked );
+    return rc;
 }
 
 #endif
@@ -56,6 +30,8 @@ size_t fread( void * _PDCLIB_restrict ptr, size_t size, size_t nmemb, struct _PD
 
 #include "_PDCLIB_test.h"
 
+#include <stdint.h>
+
 int main( void )
 {
     FILE * fh;
@@ -87,6 +63,48 @@ int main( void )
     TESTCASE( buffer[20] == 'x' );
     /* Done. */
     TESTCASE( fclose( fh ) == 0 );
+    /* Requests larger than the stream buffer, mixed with ungetc() */
+    TESTCASE( ( fh = tmpfile() ) != NULL );
+    TESTCASE( setvbuf( fh, NULL, _IOFBF, 4 ) == 0 );
+    TESTCASE( fwrite( message, 1, 20, fh ) == 20 );
+    rewind( fh );
+    TESTCASE( memset( buffer, '\0', 20 ) == buffer );
+    TESTCASE( fread( buffer, 1, 2, fh ) == 2 );
+    TESTCASE( memcmp( buffer, message, 2 ) == 0 );
+    TESTCASE( ungetc( 'e', fh ) == 'e' );
+    TESTCASE( fread( buffer, 1, 19, fh ) == 19 );
+    TESTCASE( memcmp( buffer, message + 1, 19 ) == 0 );
+    TESTCASE( ftell( fh ) == 20l );
+    TESTCASE( fread( buffer, 1, 1, fh ) == 0 );
+    TESTCASE( feof( fh ) );
+    /* Partial object at end-of-file is not counted */
+    rewind( fh );
+    TESTCASE( fread( buffer, 3, 7, fh ) == 6 );
+    TESTCASE( memcmp( buffer, message, 20 ) == 0 );
+    TESTCASE( feof( fh ) );
+    TESTCASE( buffer[20] == 'x' );
+    TESTCASE( fclose( fh ) == 0 );
+#ifndef REGTEST
+    /* size * nmemb overflowing size_t (on a memory-mapped stream, as the
+       system would refuse a read request of that size)
+    */
+    TESTCASE( ( fh = fopen( testfile, "wb" ) ) != NULL );
+    TESTCASE( fwrite( message, 1, 20, fh ) == 20 );
+    TESTCASE( fclose( fh ) == 0 );
+    TESTCASE( ( fh = fopen( testfile, "rbm" ) ) != NULL );
+    TESTCASE( memset( buffer, '\0', 20 ) == buffer );
+    TESTCASE( fread( buffer, 4, SIZE_MAX, fh ) == 5 );
+    TESTCASE( memcmp( buffer, message, 20 ) == 0 );
+    TESTCASE( feof( fh ) );
+    TESTCASE( buffer[20] == 'x' );
+    rewind( fh );
+    TESTCASE( memset( buffer, '\0', 20 ) == buffer );
+    TESTCASE( fread( buffer, SIZE_MAX / 2 + 1, 2, fh ) == 0 );
+    TESTCASE( memcmp( buffer, message, 20 ) == 0 );
+    TESTCASE( feof( fh ) );
+    TESTCASE( fclose( fh ) == 0 );
+    TESTCASE( remove( testfile ) == 0 );
+#endif
     return TEST_RESULTS;
 }
 
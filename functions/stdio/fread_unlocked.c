@@ -0,0 +1,45 @@
+/* fread_unlocked( void *, size_t, size_t, FILE * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+/* For the regression test; glibc declares fread_unlocked() as extension */
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+
+#ifndef REGTEST
+
+size_t fread_unlocked( void * _PDCLIB_restrict ptr, size_t size, size_t nmemb, struct _PDCLIB_file_t * _PDCLIB_restrict stream )
+{
+    return _PDCLIB_fread_unlocked( ptr, size, nmemb, stream );
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+#include <string.h>
+
+int main( void )
+{
+    FILE * fh;
+    const char * message = "Testing fread_unlocked()...\n";
+    char buffer[ 28 ];
+    TESTCASE( ( fh = tmpfile() ) != NULL );
+    flockfile( fh );
+    TESTCASE( fwrite_unlocked( message, 1, 28, fh ) == 28 );
+    rewind( fh );
+    TESTCASE( fread_unlocked( buffer, 4, 7, fh ) == 7 );
+    TESTCASE( memcmp( buffer, message, 28 ) == 0 );
+    TESTCASE( fread_unlocked( buffer, 1, 1, fh ) == 0 );
+    TESTCASE( feof( fh ) );
+    funlockfile( fh );
+    TESTCASE( fclose( fh ) == 0 );
+    return TEST_RESULTS;
+}
+
+#endif
@@ -19,8 +19,6 @@
 extern mtx_t _PDCLIB_filelist_mtx;
 #endif
 
-extern struct _PDCLIB_file_t * _PDCLIB_filelist;
-
 struct _PDCLIB_file_t * freopen( const char * _PDCLIB_restrict filename, const char * _PDCLIB_restrict mode, struct _PDCLIB_file_t * _PDCLIB_restrict stream )
 {
     unsigned int filemode = _PDCLIB_filemode( mode );
@@ -33,10 +31,10 @@ struct _PDCLIB_file_t * freopen( const char * _PDCLIB_restrict filename, const c
 
     _PDCLIB_LOCK( _PDCLIB_filelist_mtx );
 
-    if ( _PDCLIB_isstream( stream, NULL ) )
+    if ( _PDCLIB_isstream( stream ) )
     {
         /* May lock only after established that stream is valid */
-        _PDCLIB_LOCK( stream->mtx );
+        _PDCLIB_FLOCK( stream->lock );
 
         /* Flush buffer */
         if ( stream->status & _PDCLIB_FWRITE )
@@ -46,12 +44,20 @@ struct _PDCLIB_file_t * freopen( const char * _PDCLIB_restrict filename, const c
 
         if ( filename == NULL )
         {
+            if ( stream->filename == NULL && ! ( stream->status & _PDCLIB_FCOOKIE ) )
+            {
+                /* Determine absolute filename for reopen (not done by
+                   fopen() to save the cost for the common case).
+                */
+                stream->filename = _PDCLIB_realpath( stream->handle );
+            }
+
             /* Attempt to change mode without closing stream */
             switch ( _PDCLIB_changemode( stream, filemode ) )
             {
                 case INT_MIN:
                     /* fail completely */
-                    _PDCLIB_UNLOCK( stream->mtx );
+                    _PDCLIB_FUNLOCK( stream->lock );
                     _PDCLIB_UNLOCK( _PDCLIB_filelist_mtx );
                     return NULL;
 
@@ -64,14 +70,26 @@ struct _PDCLIB_file_t * freopen( const char * _PDCLIB_restrict filename, const c
 
                 default:
                     /* success */
-                    _PDCLIB_UNLOCK( stream->mtx );
+                    _PDCLIB_FUNLOCK( stream->lock );
                     _PDCLIB_UNLOCK( _PDCLIB_filelist_mtx );
                     return stream;
             }
         }
 
-        /* Close handle */
-        _PDCLIB_close( stream->handle );
+#ifndef __STDC_NO_THREADS__
+        /* Stop worker thread */
+        _PDCLIB_endasync( stream );
+#endif
+
+        /* Close handle (or cookie) */
+        if ( stream->status & _PDCLIB_FCOOKIE )
+        {
+            _PDCLIB_cookieclose( stream );
+        }
+        else
+        {
+            _PDCLIB_close( stream->handle );
+        }
 
         /* Remove stream from list */
         _PDCLIB_getstream( stream );
@@ -91,6 +109,10 @@ struct _PDCLIB_file_t * freopen( const char * _PDCLIB_restrict filename, const c
         {
             free( stream->buffer );
         }
+        else if ( stream->status & _PDCLIB_FMMAP )
+        {
+            _PDCLIB_unmapfile( stream );
+        }
 
         if ( filename == NULL )
         {
@@ -114,27 +136,23 @@ struct _PDCLIB_file_t * freopen( const char * _PDCLIB_restrict filename, const c
     {
         /* Not a valid stream. As _PDCLIB_init_file_t() cannot tell the
            difference, only knows that it has been called by freopen()
-           (by the non-NULL parameter), we need to initialize the mutex
+           (by the non-NULL parameter), we need to initialize the lock
            here (so that either way, _PDCLIB_init_file_t() gets a pre-
-           initialized mutex).
+           initialized lock).
         */
 #ifndef __STDC_NO_THREADS__
-        if ( mtx_init( &stream->mtx, mtx_plain | mtx_recursive ) != thrd_success )
-        {
-            /* Could not initialize stream mutex */
-            _PDCLIB_UNLOCK( _PDCLIB_filelist_mtx );
-            return NULL;
-        }
-
+        stream->lock.state = 0;
+        stream->lock.count = 0;
+        stream->lock.owner = 0;
 #endif
 
-        /* Locking the mutex, so we come out of the if-else with a locked
-           mutex either way.
+        /* Locking the stream, so we come out of the if-else with a held
+           lock either way.
         */
-        _PDCLIB_LOCK( stream->mtx );
+        _PDCLIB_FLOCK( stream->lock );
     }
 
-    /* Stream is closed, or never was open (even though its mutex exists
+    /* Stream is closed, or never was open (even though its lock exists
        and is locked) at this point.
        Now we check if we have the whereabouts to open it.
     */
@@ -142,12 +160,14 @@ struct _PDCLIB_file_t * freopen( const char * _PDCLIB_restrict filename, const c
     if ( filemode == 0 )
     {
         /* Mode invalid */
-        _PDCLIB_UNLOCK( stream->mtx );
-#ifndef __STDC_NO_THREADS__
-        mtx_destroy( &stream->mtx );
-#endif
+        _PDCLIB_FUNLOCK( stream->lock );
         free( stream->filename );
-        free( stream );
+
+        if ( stream->refs == 0 )
+        {
+            free( stream );
+        }
+
         _PDCLIB_UNLOCK( _PDCLIB_filelist_mtx );
         return NULL;
     }
@@ -155,12 +175,14 @@ struct _PDCLIB_file_t * freopen( const char * _PDCLIB_restrict filename, const c
     if ( filename == NULL || filename[0] == '\0' )
     {
         /* No filename available (standard stream?) */
-        _PDCLIB_UNLOCK( stream->mtx );
-#ifndef __STDC_NO_THREADS__
-        mtx_destroy( &stream->mtx );
-#endif
+        _PDCLIB_FUNLOCK( stream->lock );
         free( stream->filename );
-        free( stream );
+
+        if ( stream->refs == 0 )
+        {
+            free( stream );
+        }
+
         _PDCLIB_UNLOCK( _PDCLIB_filelist_mtx );
         return NULL;
     }
@@ -169,42 +191,48 @@ struct _PDCLIB_file_t * freopen( const char * _PDCLIB_restrict filename, const c
     if ( _PDCLIB_init_file_t( stream ) == NULL )
     {
         /* Re-init failed. */
-        _PDCLIB_UNLOCK( stream->mtx );
-#ifndef __STDC_NO_THREADS__
-        mtx_destroy( &stream->mtx );
-#endif
+        _PDCLIB_FUNLOCK( stream->lock );
         free( stream->filename );
-        free( stream );
+
+        if ( stream->refs == 0 )
+        {
+            free( stream );
+        }
+
         _PDCLIB_UNLOCK( _PDCLIB_filelist_mtx );
         return NULL;
     }
 
-    /* Resetting buffer mode and filemode */
-    stream->status |= filemode | _IOLBF;
+    /* Resetting filemode */
+    stream->status |= filemode;
 
     /* Attempt open */
     if ( ( stream->handle = _PDCLIB_open( filename, stream->status ) ) == _PDCLIB_NOHANDLE )
     {
         /* OS open() failed */
-        _PDCLIB_UNLOCK( stream->mtx );
-#ifndef __STDC_NO_THREADS__
-        mtx_destroy( &stream->mtx );
-#endif
+        _PDCLIB_FUNLOCK( stream->lock );
         free( stream->filename );
         free( stream->buffer );
-        free( stream );
+
+        if ( stream->refs == 0 )
+        {
+            free( stream );
+        }
+
         _PDCLIB_UNLOCK( _PDCLIB_filelist_mtx );
         return NULL;
     }
 
-    /* Getting absolute filename */
-    stream->filename = _PDCLIB_realpath( filename );
+    /* Resetting buffer mode (see fopen()) */
+    stream->status |= _PDCLIB_isinteractive( stream->handle ) ? _IOLBF : _IOFBF;
+
+    /* Absolute filename is determined when needed (see fopen()) */
+    stream->filename = NULL;
 
     /* Adding to list of open files */
-    stream->next = _PDCLIB_filelist;
-    _PDCLIB_filelist = stream;
+    _PDCLIB_putstream( stream );
 
-    _PDCLIB_UNLOCK( stream->mtx );
+    _PDCLIB_FUNLOCK( stream->lock );
     _PDCLIB_UNLOCK( _PDCLIB_filelist_mtx );
 
     return stream;
@@ -231,6 +259,13 @@ int main( void )
     rewind( fout );
     TESTCASE( fgetc( fout ) == 'x' );
 
+    /* Reopening under the current name */
+    TESTCASE( ( fin = freopen( NULL, "rb", fin ) ) != NULL );
+    TESTCASE( getchar() == 'x' );
+    TESTCASE( ( fout = freopen( NULL, "rb", fout ) ) != NULL );
+    TESTCASE( fgetc( fout ) == 'x' );
+    TESTCASE( fgetc( fout ) == EOF );
+
     TESTCASE( fclose( fin ) == 0 );
     TESTCASE( fclose( fout ) == 0 );
     TESTCASE( remove( testfile1 ) == 0 );
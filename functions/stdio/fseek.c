@@ -17,15 +17,59 @@
 int fseek( struct _PDCLIB_file_t * stream, long offset, int whence )
 {
     int rc;
-    _PDCLIB_LOCK( stream->mtx );
+    _PDCLIB_FLOCK( stream->lock );
+
+    if ( ( whence == SEEK_SET || whence == SEEK_CUR ) && stream->bufend > 0 && ! ( stream->status & _PDCLIB_FWRITE ) )
+    {
+        /* If the target lies within the read buffer, there is no need to
+           discard the buffer, and no system call. (The buffer holds the
+           characters of the file up to pos.offset.)
+        */
+        _PDCLIB_int_least64_t base = ( _PDCLIB_int_least64_t )stream->pos.offset - ( _PDCLIB_int_least64_t )stream->bufend;
+        _PDCLIB_int_least64_t target = offset;
+
+        if ( whence == SEEK_CUR )
+        {
+            target += base + ( _PDCLIB_int_least64_t )stream->bufidx - ( _PDCLIB_int_least64_t )stream->ungetidx;
+        }
+
+        if ( target >= base && target <= ( _PDCLIB_int_least64_t )stream->pos.offset )
+        {
+            stream->bufidx = ( _PDCLIB_size_t )( target - base );
+            stream->ungetidx = 0;
+            stream->status &= ~ _PDCLIB_EOFFLAG;
+
+            if ( stream->status & _PDCLIB_FRW )
+            {
+                /* A following write has _PDCLIB_prepwrite() discard the
+                   buffer.
+                */
+                stream->status &= ~( _PDCLIB_FREAD | _PDCLIB_FWRITE );
+            }
+
+            _PDCLIB_FUNLOCK( stream->lock );
+            return 0;
+        }
+    }
 
     if ( stream->status & _PDCLIB_FWRITE )
     {
         if ( _PDCLIB_flushbuffer( stream ) == EOF )
         {
-            _PDCLIB_UNLOCK( stream->mtx );
+            _PDCLIB_FUNLOCK( stream->lock );
             return EOF;
         }
+
+#ifndef __STDC_NO_THREADS__
+
+        /* Write-behind thread must be done before repositioning. */
+        if ( _PDCLIB_waitasync( stream ) == EOF )
+        {
+            _PDCLIB_FUNLOCK( stream->lock );
+            return EOF;
+        }
+
+#endif
     }
 
     stream->status &= ~ _PDCLIB_EOFFLAG;
@@ -37,11 +81,11 @@ int fseek( struct _PDCLIB_file_t * stream, long offset, int whence )
 
     if ( whence == SEEK_CUR )
     {
-        offset -= ( ( ( int )stream->bufend - ( int )stream->bufidx ) + stream->ungetidx );
+        offset -= ( ( long )( stream->bufend - stream->bufidx ) + stream->ungetidx );
     }
 
     rc = ( _PDCLIB_seek( stream, offset, whence ) != EOF ) ? 0 : EOF;
-    _PDCLIB_UNLOCK( stream->mtx );
+    _PDCLIB_FUNLOCK( stream->lock );
     return rc;
 }
 
@@ -96,6 +140,37 @@ int main( void )
     /* Checking error handling */
     TESTCASE( fseek( fh, -5, SEEK_SET ) == -1 );
     TESTCASE( fseek( fh, 0, SEEK_END ) == 0 );
+    /* Seeking within the read buffer */
+    TESTCASE( fseek( fh, 0, SEEK_SET ) == 0 );
+    TESTCASE( fgetc( fh ) == teststring[0] );
+#ifndef REGTEST
+    {
+        _PDCLIB_uint_least64_t offset = fh->pos.offset;
+        TESTCASE( fseek( fh, 4, SEEK_SET ) == 0 );
+        TESTCASE_NOREG( fh->pos.offset == offset );
+        TESTCASE( fseek( fh, -2, SEEK_CUR ) == 0 );
+        TESTCASE_NOREG( fh->pos.offset == offset );
+    }
+#endif
+    TESTCASE( fseek( fh, 2, SEEK_SET ) == 0 );
+    TESTCASE( ftell( fh ) == 2 );
+    TESTCASE( fgetc( fh ) == teststring[2] );
+    TESTCASE( fseek( fh, -3, SEEK_CUR ) == 0 );
+    TESTCASE( ftell( fh ) == 0 );
+    TESTCASE( fgetc( fh ) == teststring[0] );
+    TESTCASE( ungetc( 'x', fh ) == 'x' );
+    TESTCASE( fseek( fh, 1, SEEK_CUR ) == 0 );
+    TESTCASE( fgetc( fh ) == teststring[1] );
+    /* Writing after seeking within the read buffer */
+    TESTCASE( fseek( fh, 3, SEEK_SET ) == 0 );
+    TESTCASE( fputc( 'y', fh ) == 'y' );
+    TESTCASE( ftell( fh ) == 4 );
+    TESTCASE( fseek( fh, 0, SEEK_SET ) == 0 );
+    TESTCASE( fgetc( fh ) == teststring[0] );
+    TESTCASE( fseek( fh, 2, SEEK_SET ) == 0 );
+    TESTCASE( fgetc( fh ) == teststring[2] );
+    TESTCASE( fgetc( fh ) == 'y' );
+    TESTCASE( fgetc( fh ) == teststring[4] );
     TESTCASE( fclose( fh ) == 0 );
     return TEST_RESULTS;
 }
@@ -16,27 +16,27 @@
 
 int fsetpos( struct _PDCLIB_file_t * stream, const struct _PDCLIB_fpos_t * pos )
 {
-    _PDCLIB_LOCK( stream->mtx );
+    _PDCLIB_FLOCK( stream->lock );
 
     if ( stream->status & _PDCLIB_FWRITE )
     {
         if ( _PDCLIB_flushbuffer( stream ) == EOF )
         {
-            _PDCLIB_UNLOCK( stream->mtx );
+            _PDCLIB_FUNLOCK( stream->lock );
             return EOF;
         }
     }
 
     if ( _PDCLIB_seek( stream, pos->offset, SEEK_SET ) == EOF )
     {
-        _PDCLIB_UNLOCK( stream->mtx );
+        _PDCLIB_FUNLOCK( stream->lock );
         return EOF;
     }
 
     stream->pos.status = pos->status;
     /* TODO: Add mbstate. */
 
-    _PDCLIB_UNLOCK( stream->mtx );
+    _PDCLIB_FUNLOCK( stream->lock );
 
     return 0;
 }
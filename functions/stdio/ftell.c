@@ -30,23 +30,27 @@ long int ftell( struct _PDCLIB_file_t * stream )
            i.e. unprocessed bytes as positive number.
        That is how the somewhat obscure return-value calculation works.
     */
+    /* This is computed from the stream's state alone; no system call is
+       needed.
+    */
+    _PDCLIB_int_least64_t offset;
+    int locked = _PDCLIB_LOCKFILE( stream );
+
+    offset = ( _PDCLIB_int_least64_t )stream->pos.offset - ( ( ( _PDCLIB_int_least64_t )stream->bufend - ( _PDCLIB_int_least64_t )stream->bufidx ) + ( _PDCLIB_int_least64_t )stream->ungetidx );
+
+    _PDCLIB_UNLOCKFILE( stream, locked );
+
     /*  If offset is too large for return type, report error instead of wrong
         offset value.
     */
-    long int rc;
-    _PDCLIB_LOCK( stream->mtx );
-
-    if ( ( stream->pos.offset - stream->bufend ) > ( LONG_MAX - ( stream->bufidx - stream->ungetidx ) ) )
+    if ( offset > LONG_MAX )
     {
         /* integer overflow */
-        _PDCLIB_UNLOCK( stream->mtx );
         *_PDCLIB_errno_func() = _PDCLIB_ERANGE;
         return -1;
     }
 
-    rc = ( stream->pos.offset - ( ( ( int )stream->bufend - ( int )stream->bufidx ) + stream->ungetidx ) );
-    _PDCLIB_UNLOCK( stream->mtx );
-    return rc;
+    return ( long int )offset;
 }
 
 #endif
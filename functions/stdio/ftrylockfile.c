@@ -0,0 +1,52 @@
+/* ftrylockfile( FILE * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+
+#ifndef REGTEST
+
+#ifndef __STDC_NO_THREADS__
+#include <threads.h>
+#endif
+
+int ftrylockfile( struct _PDCLIB_file_t * stream )
+{
+#ifndef __STDC_NO_THREADS__
+    if ( _PDCLIB_ATOMIC_CAS( &stream->lock.state, 0, 1 ) )
+    {
+        stream->lock.owner = thrd_current();
+        stream->lock.count = 1;
+        return 0;
+    }
+
+    if ( stream->lock.owner == thrd_current() )
+    {
+        /* Recursive locking */
+        ++stream->lock.count;
+        return 0;
+    }
+
+    return -1;
+#else
+    ( void )stream;
+    return 0;
+#endif
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+    /* Testing covered by flockfile.c */
+    return TEST_RESULTS;
+}
+
+#endif
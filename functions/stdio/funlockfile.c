@@ -0,0 +1,33 @@
+/* funlockfile( FILE * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+
+#ifndef REGTEST
+
+#ifndef __STDC_NO_THREADS__
+#include <threads.h>
+#endif
+
+void funlockfile( struct _PDCLIB_file_t * stream )
+{
+    _PDCLIB_FUNLOCK( stream->lock );
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+    /* Testing covered by flockfile.c */
+    return TEST_RESULTS;
+}
+
+#endif
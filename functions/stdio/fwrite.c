@@ -17,89 +17,11 @@
 
 size_t fwrite( const void * _PDCLIB_restrict ptr, size_t size, size_t nmemb, struct _PDCLIB_file_t * _PDCLIB_restrict stream )
 {
-    _PDCLIB_size_t offset = 0;
-    /* TODO: lineend */
-    /* int lineend = 0; */
-    size_t nmemb_i;
-
-    _PDCLIB_LOCK( stream->mtx );
-
-    if ( _PDCLIB_prepwrite( stream ) == EOF )
-    {
-        _PDCLIB_UNLOCK( stream->mtx );
-        return 0;
-    }
-
-    for ( nmemb_i = 0; nmemb_i < nmemb; ++nmemb_i )
-    {
-        size_t size_i;
-
-        for ( size_i = 0; size_i < size; ++size_i )
-        {
-            if ( ( stream->buffer[ stream->bufidx++ ] = ( ( char * )ptr )[ nmemb_i * size + size_i ] ) == '\n' )
-            {
-                /* Remember last newline, in case we have to do a partial line-buffered flush */
-                offset = stream->bufidx;
-                /* lineend = true; */
-            }
-
-            if ( stream->bufidx == stream->bufsize )
-            {
-                if ( _PDCLIB_flushbuffer( stream ) == EOF )
-                {
-                    /* Returning number of objects completely buffered */
-                    _PDCLIB_UNLOCK( stream->mtx );
-                    return nmemb_i;
-                }
-
-                offset = 0;
-                /* lineend = false; */
-            }
-        }
-    }
-
-    /* Fully-buffered streams are OK. Non-buffered streams must be flushed,
-       line-buffered streams only if there's a newline in the buffer.
-    */
-    switch ( stream->status & ( _IONBF | _IOLBF ) )
-    {
-        case _IONBF:
-            if ( _PDCLIB_flushbuffer( stream ) == EOF )
-            {
-                /* We are in a pinch here. We have an error, which requires a
-                   return value < nmemb. On the other hand, all objects have
-                   been written to buffer, which means all the caller had to
-                   do was removing the error cause, and re-flush the stream...
-                   Catch 22. We'll return a value one short, to indicate the
-                   error, and can't really do anything about the inconsistency.
-                */
-                _PDCLIB_UNLOCK( stream->mtx );
-                return nmemb_i - 1;
-            }
-
-            break;
-
-        case _IOLBF:
-            if ( offset > 0 )
-            {
-                size_t bufidx = stream->bufidx;
-                stream->bufidx = offset;
-
-                if ( _PDCLIB_flushbuffer( stream ) == EOF )
-                {
-                    /* See comment above. */
-                    stream->bufidx = bufidx;
-                    _PDCLIB_UNLOCK( stream->mtx );
-                    return nmemb_i - 1;
-                }
-
-                stream->bufidx = bufidx - offset;
-                memmove( stream->buffer, stream->buffer + offset, stream->bufidx );
-            }
-    }
-
-    _PDCLIB_UNLOCK( stream->mtx );
-    return nmemb_i;
+    size_t rc;
+    int locked = _PDCLIB_LOCKFILE( stream );
+    rc = _PDCLIB_fwrite_unlocked( ptr, size, nmemb, stream );
+    _PDCLIB_UNLOCKFILE( stream, locked );
+    return rc;
 }
 
 #endif
@@ -110,7 +32,27 @@ size_t fwrite( const void * _PDCLIB_restrict ptr, size_t size, size_t nmemb, str
 
 int main( void )
 {
-    /* Testing covered by fread(). */
+    /* Basic testing covered by fread(). */
+    FILE * fh;
+    const char * message = "Testing fwrite()...\n";
+    char buffer[27];
+    TESTCASE( ( fh = tmpfile() ) != NULL );
+    TESTCASE( setvbuf( fh, NULL, _IOLBF, 8 ) == 0 );
+    /* Line-buffered stream flushed up to the last newline */
+    TESTCASE( fwrite( "abc\ndef", 1, 7, fh ) == 7 );
+    TESTCASE( ftell( fh ) == 7l );
+    TESTCASE_NOREG( fh->pos.offset == 4l );
+    TESTCASE_NOREG( fh->bufidx == 3 );
+    /* Payload larger than the buffer */
+    TESTCASE( fwrite( message, 4, 5, fh ) == 5 );
+    TESTCASE( ftell( fh ) == 27l );
+    TESTCASE_NOREG( fh->pos.offset == 27l );
+    TESTCASE_NOREG( fh->bufidx == 0 );
+    rewind( fh );
+    TESTCASE( fread( buffer, 1, 27, fh ) == 27 );
+    TESTCASE( memcmp( buffer, "abc\ndef", 7 ) == 0 );
+    TESTCASE( memcmp( buffer + 7, message, 20 ) == 0 );
+    TESTCASE( fclose( fh ) == 0 );
     return TEST_RESULTS;
 }
 
@@ -0,0 +1,31 @@
+/* fwrite_unlocked( const void *, size_t, size_t, FILE * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+/* For the regression test; glibc declares fwrite_unlocked() as extension */
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+
+#ifndef REGTEST
+
+size_t fwrite_unlocked( const void * _PDCLIB_restrict ptr, size_t size, size_t nmemb, struct _PDCLIB_file_t * _PDCLIB_restrict stream )
+{
+    return _PDCLIB_fwrite_unlocked( ptr, size, nmemb, stream );
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+    /* Testing covered by fread_unlocked.c */
+    return TEST_RESULTS;
+}
+
+#endif
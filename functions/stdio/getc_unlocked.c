@@ -0,0 +1,57 @@
+/* getc_unlocked( FILE * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_glue.h"
+
+#undef getc_unlocked
+
+int getc_unlocked( struct _PDCLIB_file_t * stream )
+{
+    if ( _PDCLIB_prepread( stream ) == EOF )
+    {
+        return EOF;
+    }
+
+    if ( _PDCLIB_CHECKBUFFER( stream ) == EOF )
+    {
+        return EOF;
+    }
+
+    return _PDCLIB_GETC( stream );
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+    FILE * fh;
+    TESTCASE( ( fh = tmpfile() ) != NULL );
+    TESTCASE( fputs( "abc", fh ) >= 0 );
+    rewind( fh );
+    flockfile( fh );
+    TESTCASE( getc_unlocked( fh ) == 'a' );
+    TESTCASE( ( getc_unlocked )( fh ) == 'b' );
+    /* Pushed-back characters come first */
+    TESTCASE( ungetc( 'x', fh ) == 'x' );
+    TESTCASE( getc_unlocked( fh ) == 'x' );
+    TESTCASE( getc_unlocked( fh ) == 'c' );
+    TESTCASE( getc_unlocked( fh ) == EOF );
+    TESTCASE( feof( fh ) );
+    funlockfile( fh );
+    TESTCASE( fclose( fh ) == 0 );
+    return TEST_RESULTS;
+}
+
+#endif
@@ -0,0 +1,31 @@
+/* getchar_unlocked( void )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+
+#ifndef REGTEST
+
+#undef getchar_unlocked
+
+int getchar_unlocked( void )
+{
+    return getc_unlocked( stdin );
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+    /* Testing covered by getc_unlocked.c */
+    return TEST_RESULTS;
+}
+
+#endif
@@ -0,0 +1,185 @@
+/* getdelim( char **, size_t *, int, FILE * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_glue.h"
+
+#ifndef __STDC_NO_THREADS__
+#include <threads.h>
+#endif
+
+/* Initial buffer size if the caller did not provide a buffer */
+#define GETDELIM_MIN 128
+
+ssize_t getdelim( char ** _PDCLIB_restrict lineptr, size_t * _PDCLIB_restrict n, int delimiter, struct _PDCLIB_file_t * _PDCLIB_restrict stream )
+{
+    size_t len = 0;
+    int rc = 0;
+    int done = 0;
+    int locked;
+
+    if ( lineptr == NULL || n == NULL )
+    {
+        *_PDCLIB_errno_func() = _PDCLIB_EINVAL;
+        return -1;
+    }
+
+    if ( *lineptr == NULL )
+    {
+        *n = 0;
+    }
+
+    locked = _PDCLIB_LOCKFILE( stream );
+
+    if ( _PDCLIB_prepread( stream ) == EOF )
+    {
+        _PDCLIB_UNLOCKFILE( stream, locked );
+        return -1;
+    }
+
+    while ( ! done )
+    {
+        const char * src;
+        const char * end;
+        size_t count;
+
+        if ( stream->ungetidx > 0 )
+        {
+            /* Characters pushed back by ungetc() come first. They are
+               stored in reverse order, so take them one at a time.
+            */
+            src = ( const char * )&stream->ungetbuf[ stream->ungetidx - 1 ];
+            count = 1;
+        }
+        else
+        {
+            if ( stream->bufidx == stream->bufend && _PDCLIB_fillbuffer( stream ) == EOF )
+            {
+                /* EOF / error, flags already set */
+                break;
+            }
+
+            src = stream->buffer + stream->bufidx;
+            count = stream->bufend - stream->bufidx;
+        }
+
+        /* Take up to (and including) the first delimiter in one go. */
+        if ( ( end = ( const char * )memchr( src, delimiter, count ) ) != NULL )
+        {
+            count = end - src + 1;
+            done = 1;
+        }
+
+        if ( count > ( size_t )_PDCLIB_PTRDIFF_MAX - len )
+        {
+            *_PDCLIB_errno_func() = _PDCLIB_EOVERFLOW;
+            stream->status |= _PDCLIB_ERRORFLAG;
+            rc = -1;
+            break;
+        }
+
+        if ( len + count >= *n )
+        {
+            /* Enlarge buffer (leaving room for the terminating '\0'),
+               doubling its size to keep the number of reallocations low.
+            */
+            size_t size = ( *n > 0 ) ? *n : GETDELIM_MIN;
+            char * buffer;
+
+            while ( size <= len + count )
+            {
+                size = ( size <= ( ( size_t )-1 ) / 2 ) ? size * 2 : len + count + 1;
+            }
+
+            if ( ( buffer = ( char * )realloc( *lineptr, size ) ) == NULL )
+            {
+                *_PDCLIB_errno_func() = _PDCLIB_ENOMEM;
+                stream->status |= _PDCLIB_ERRORFLAG;
+                rc = -1;
+                break;
+            }
+
+            *lineptr = buffer;
+            *n = size;
+        }
+
+        memcpy( *lineptr + len, src, count );
+        len += count;
+
+        if ( stream->ungetidx > 0 )
+        {
+            --stream->ungetidx;
+        }
+        else
+        {
+            stream->bufidx += count;
+        }
+    }
+
+    _PDCLIB_UNLOCKFILE( stream, locked );
+
+    if ( rc != 0 || len == 0 )
+    {
+        /* Error, or EOF without anything read */
+        return -1;
+    }
+
+    ( *lineptr )[ len ] = '\0';
+    return ( ssize_t )len;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+#include <errno.h>
+
+int main( void )
+{
+    FILE * fh;
+    char * line = NULL;
+    size_t n = 0;
+    size_t i;
+    TESTCASE( ( fh = tmpfile() ) != NULL );
+    TESTCASE( setvbuf( fh, NULL, _IOFBF, 4 ) == 0 );
+    TESTCASE( fputs( "foo:bar", fh ) >= 0 );
+
+    for ( i = 0; i < 200; ++i )
+    {
+        TESTCASE( fputc( 'x', fh ) == 'x' );
+    }
+
+    rewind( fh );
+    /* Allocating the buffer */
+    TESTCASE( getdelim( &line, &n, ':', fh ) == 4 );
+    TESTCASE( line != NULL && n > 4 );
+    TESTCASE( strcmp( line, "foo:" ) == 0 );
+    /* Delimiter spanning buffer refills, ungetc() */
+    TESTCASE( ungetc( 'a', fh ) == 'a' );
+    TESTCASE( getdelim( &line, &n, 'r', fh ) == 4 );
+    TESTCASE( strcmp( line, "abar" ) == 0 );
+    /* Growing the buffer, EOF without delimiter */
+    TESTCASE( getdelim( &line, &n, '\n', fh ) == 200 );
+    TESTCASE( n > 200 );
+    TESTCASE( strlen( line ) == 200 );
+    TESTCASE( feof( fh ) );
+    TESTCASE( getdelim( &line, &n, '\n', fh ) == -1 );
+    TESTCASE( getdelim( NULL, &n, '\n', fh ) == -1 );
+    TESTCASE( errno == EINVAL );
+    free( line );
+    TESTCASE( fclose( fh ) == 0 );
+    return TEST_RESULTS;
+}
+
+#endif
@@ -0,0 +1,47 @@
+/* getline( char **, size_t *, FILE * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+
+#ifndef REGTEST
+
+ssize_t getline( char ** _PDCLIB_restrict lineptr, size_t * _PDCLIB_restrict n, struct _PDCLIB_file_t * _PDCLIB_restrict stream )
+{
+    return getdelim( lineptr, n, '\n', stream );
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+int main( void )
+{
+    FILE * fh;
+    char * line = NULL;
+    size_t n = 0;
+    TESTCASE( ( fh = tmpfile() ) != NULL );
+    TESTCASE( fputs( "foo\n\nbar", fh ) >= 0 );
+    rewind( fh );
+    TESTCASE( getline( &line, &n, fh ) == 4 );
+    TESTCASE( strcmp( line, "foo\n" ) == 0 );
+    TESTCASE( getline( &line, &n, fh ) == 1 );
+    TESTCASE( strcmp( line, "\n" ) == 0 );
+    TESTCASE( getline( &line, &n, fh ) == 3 );
+    TESTCASE( strcmp( line, "bar" ) == 0 );
+    TESTCASE( getline( &line, &n, fh ) == -1 );
+    TESTCASE( feof( fh ) );
+    free( line );
+    TESTCASE( fclose( fh ) == 0 );
+    return TEST_RESULTS;
+}
+
+#endif
@@ -0,0 +1,122 @@
+/* open_memstream( char **, size_t * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_glue.h"
+
+/* Initial buffer size */
+#define MEMSTREAM_MIN 128
+
+struct _PDCLIB_file_t * open_memstream( char ** bufp, size_t * sizep )
+{
+    struct _PDCLIB_file_t * rc;
+    struct _PDCLIB_memfile_t * mem;
+    cookie_io_functions_t funcs = { _PDCLIB_memread, _PDCLIB_memwrite, _PDCLIB_memseek, _PDCLIB_memclose };
+
+    if ( bufp == NULL || sizep == NULL )
+    {
+        *_PDCLIB_errno_func() = _PDCLIB_EINVAL;
+        return NULL;
+    }
+
+    if ( ( mem = (struct _PDCLIB_memfile_t *)malloc( sizeof( struct _PDCLIB_memfile_t ) ) ) == NULL )
+    {
+        /* No memory */
+        *_PDCLIB_errno_func() = _PDCLIB_ENOMEM;
+        return NULL;
+    }
+
+    if ( ( mem->data = (char *)malloc( MEMSTREAM_MIN ) ) == NULL )
+    {
+        /* No memory */
+        free( mem );
+        *_PDCLIB_errno_func() = _PDCLIB_ENOMEM;
+        return NULL;
+    }
+
+    mem->data[ 0 ] = '\0';
+    mem->size = 0;
+    mem->capacity = MEMSTREAM_MIN;
+    mem->pos = 0;
+    mem->bufp = bufp;
+    mem->sizep = sizep;
+    mem->append = 0;
+    /* The buffer belongs to the caller */
+    mem->freedata = 0;
+
+    if ( ( rc = fopencookie( mem, "w", funcs ) ) == NULL )
+    {
+        /* errno already set */
+        free( mem->data );
+        free( mem );
+        return NULL;
+    }
+
+    *bufp = mem->data;
+    *sizep = 0;
+    return rc;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+#include <stdlib.h>
+
+int main( void )
+{
+    char big[ 3000 ];
+    char * buf;
+    size_t size;
+    FILE * fh;
+    int i;
+    /* Character-wise writing */
+    TESTCASE( ( fh = open_memstream( &buf, &size ) ) != NULL );
+    TESTCASE( fprintf( fh, "hello" ) == 5 );
+    TESTCASE( fflush( fh ) == 0 );
+    TESTCASE( size == 5 );
+    TESTCASE( strcmp( buf, "hello" ) == 0 );
+
+    for ( i = 0; i < 1000; ++i )
+    {
+        TESTCASE( fputc( 'a' + i % 26, fh ) == 'a' + i % 26 );
+    }
+
+    TESTCASE( fclose( fh ) == 0 );
+    TESTCASE( size == 1005 );
+    TESTCASE( strlen( buf ) == 1005 );
+    TESTCASE( buf[ 1004 ] == 'a' + 999 % 26 );
+    free( buf );
+    /* Writing larger than the stream buffer, seeking */
+    memset( big, 'x', sizeof( big ) );
+    TESTCASE( ( fh = open_memstream( &buf, &size ) ) != NULL );
+    TESTCASE( fputc( 'a', fh ) == 'a' );
+    TESTCASE( fwrite( big, 1, sizeof( big ), fh ) == sizeof( big ) );
+    TESTCASE( fseek( fh, 10, SEEK_SET ) == 0 );
+    TESTCASE( fputc( 'X', fh ) == 'X' );
+    TESTCASE( fflush( fh ) == 0 );
+    TESTCASE_NOREG( size == 11 );
+    TESTCASE( buf[ 0 ] == 'a' );
+    TESTCASE( buf[ 10 ] == 'X' );
+    TESTCASE( buf[ 11 ] == 'x' );
+    TESTCASE( fseek( fh, 0, SEEK_END ) == 0 );
+    TESTCASE( fclose( fh ) == 0 );
+    TESTCASE_NOREG( size == sizeof( big ) + 1 );
+    TESTCASE_NOREG( buf[ size ] == '\0' );
+    free( buf );
+    /* Invalid arguments */
+    TESTCASE_NOREG( open_memstream( NULL, &size ) == NULL );
+    return TEST_RESULTS;
+}
+
+#endif
@@ -17,7 +17,7 @@
 /* TODO: Doing this via a static array is not the way to do it. */
 void perror( const char * s )
 {
-    _PDCLIB_LOCK( stderr->mtx );
+    _PDCLIB_FLOCK( stderr->lock );
 
     if ( ( s != NULL ) && ( s[0] != '\n' ) )
     {
@@ -33,7 +33,7 @@ void perror( const char * s )
         fprintf( stderr, "%s\n", _PDCLIB_lc_messages->errno_texts[errno] );
     }
 
-    _PDCLIB_UNLOCK( stderr->mtx );
+    _PDCLIB_FUNLOCK( stderr->lock );
     return;
 }
 
@@ -0,0 +1,72 @@
+/* putc_unlocked( int, FILE * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_glue.h"
+
+#undef putc_unlocked
+
+int putc_unlocked( int c, struct _PDCLIB_file_t * stream )
+{
+    if ( _PDCLIB_prepwrite( stream ) == EOF )
+    {
+        return EOF;
+    }
+
+    stream->buffer[stream->bufidx++] = ( char )c;
+
+    if ( ( stream->bufidx == stream->bufsize )                   /* _IOFBF */
+           || ( ( stream->status & _IOLBF ) && ( ( char )c == '\n' ) ) /* _IOLBF */
+           || ( stream->status & _IONBF )                        /* _IONBF */
+       )
+    {
+        /* buffer filled, unbuffered stream, or end-of-line. */
+        return ( _PDCLIB_flushbuffer( stream ) == 0 ) ? c : EOF;
+    }
+
+    return c;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+#include <string.h>
+
+int main( void )
+{
+    FILE * fh;
+    char buffer[ 6 ];
+    int i;
+    TESTCASE( ( fh = tmpfile() ) != NULL );
+    TESTCASE( setvbuf( fh, NULL, _IOFBF, 4 ) == 0 );
+    flockfile( fh );
+    /* Crossing buffer boundaries */
+    for ( i = 0; i < 5; ++i )
+    {
+        TESTCASE( putc_unlocked( 'a' + i, fh ) == 'a' + i );
+    }
+
+    TESTCASE( ( putc_unlocked )( '\n', fh ) == '\n' );
+    funlockfile( fh );
+    TESTCASE( ftell( fh ) == 6l );
+    rewind( fh );
+    TESTCASE( fread( buffer, 1, 6, fh ) == 6 );
+    TESTCASE( memcmp( buffer, "abcde\n", 6 ) == 0 );
+    /* Not on an input stream */
+    TESTCASE_NOREG( putc_unlocked( 'x', fh ) == EOF );
+    TESTCASE_NOREG( ferror( fh ) );
+    TESTCASE( fclose( fh ) == 0 );
+    return TEST_RESULTS;
+}
+
+#endif
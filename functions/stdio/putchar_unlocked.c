@@ -0,0 +1,31 @@
+/* putchar_unlocked( int )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+
+#ifndef REGTEST
+
+#undef putchar_unlocked
+
+int putchar_unlocked( int c )
+{
+    return putc_unlocked( c, stdout );
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+    /* Testing covered by putc_unlocked.c */
+    return TEST_RESULTS;
+}
+
+#endif
@@ -16,11 +16,11 @@
 
 int puts( const char * s )
 {
-    _PDCLIB_LOCK( stdout->mtx );
+    int locked = _PDCLIB_LOCKFILE( stdout );
 
     if ( _PDCLIB_prepwrite( stdout ) == EOF )
     {
-        _PDCLIB_UNLOCK( stdout->mtx );
+        _PDCLIB_UNLOCKFILE( stdout, locked );
         return EOF;
     }
 
@@ -32,7 +32,7 @@ int puts( const char * s )
         {
             if ( _PDCLIB_flushbuffer( stdout ) == EOF )
             {
-                _PDCLIB_UNLOCK( stdout->mtx );
+                _PDCLIB_UNLOCKFILE( stdout, locked );
                 return EOF;
             }
         }
@@ -44,12 +44,12 @@ int puts( const char * s )
          ( stdout->status & ( _IOLBF | _IONBF ) ) )
     {
         int rc = _PDCLIB_flushbuffer( stdout );
-        _PDCLIB_UNLOCK( stdout->mtx );
+        _PDCLIB_UNLOCKFILE( stdout, locked );
         return rc;
     }
     else
     {
-        _PDCLIB_UNLOCK( stdout->mtx );
+        _PDCLIB_UNLOCKFILE( stdout, locked );
         return 0;
     }
 }
@@ -23,7 +23,7 @@ int setvbuf( struct _PDCLIB_file_t * _PDCLIB_restrict stream, char * _PDCLIB_res
                we don't want to e.g. flush the stream for every character of a
                stream being printed.
             */
-            _PDCLIB_LOCK( stream->mtx );
+            _PDCLIB_FLOCK( stream->lock );
             break;
 
         case _IOFBF:
@@ -36,6 +36,22 @@ int setvbuf( struct _PDCLIB_file_t * _PDCLIB_restrict stream, char * _PDCLIB_res
                 return -1;
             }
 
+            _PDCLIB_FLOCK( stream->lock );
+
+            if ( stream->status & _PDCLIB_FMMAP )
+            {
+                /* Explicit buffering requested for a stream opened with
+                   mode "rm". Too late if the file is mapped already.
+                */
+                if ( stream->buffer != NULL )
+                {
+                    _PDCLIB_FUNLOCK( stream->lock );
+                    return -1;
+                }
+
+                stream->status &= ~_PDCLIB_FMMAP;
+            }
+
             if ( buf != NULL )
             {
                 /* User provided buffer. Deallocate existing buffer, and mark
@@ -58,16 +74,19 @@ int setvbuf( struct _PDCLIB_file_t * _PDCLIB_restrict stream, char * _PDCLIB_res
                    over twice as big (and wasting memory space), we use the
                    current buffer (i.e., do nothing), to save the malloc() /
                    free() overhead.
+                   If no buffer has been allocated yet, we only record the
+                   requested size, and leave allocation to the first read /
+                   write (see _PDCLIB_allocbuffer()).
                 */
-                _PDCLIB_LOCK( stream->mtx );
+                buf = stream->buffer;
 
-                if ( ( stream->bufsize < size ) || ( stream->bufsize > ( size << 1 ) ) )
+                if ( ( buf != NULL ) && ( ( stream->bufsize < size ) || ( stream->bufsize > ( size << 1 ) ) ) )
                 {
                     /* Buffer too small, or much too large - allocate. */
                     if ( ( buf = ( char * ) malloc( size ) ) == NULL )
                     {
                         /* Out of memory error. */
-                        _PDCLIB_UNLOCK( stream->mtx );
+                        _PDCLIB_FUNLOCK( stream->lock );
                         return -1;
                     }
 
@@ -94,7 +113,7 @@ int setvbuf( struct _PDCLIB_file_t * _PDCLIB_restrict stream, char * _PDCLIB_res
     stream->status &= ~( _IOFBF | _IOLBF | _IONBF );
     /* Set user-defined mode */
     stream->status |= mode;
-    _PDCLIB_UNLOCK( stream->mtx );
+    _PDCLIB_FUNLOCK( stream->lock );
     return 0;
 }
 
@@ -120,18 +139,35 @@ int main( void )
     TESTCASE( fh->bufsize == BUFFERSIZE );
     TESTCASE( ( fh->status & ( _IOFBF | _IONBF | _IOLBF ) ) == _IOFBF );
     TESTCASE( fclose( fh ) == 0 );
-    /* line buffered, lib-supplied buffer */
+    /* line buffered, lib-supplied buffer (allocated on first use) */
     TESTCASE( ( fh = tmpfile() ) != NULL );
     TESTCASE( setvbuf( fh, NULL, _IOLBF, BUFFERSIZE ) == 0 );
-    TESTCASE( fh->buffer != NULL );
+    TESTCASE( fh->buffer == NULL );
     TESTCASE( fh->bufsize == BUFFERSIZE );
     TESTCASE( ( fh->status & ( _IOFBF | _IONBF | _IOLBF ) ) == _IOLBF );
+    TESTCASE( fputc( 'x', fh ) == 'x' );
+    TESTCASE( fh->buffer != NULL );
+    TESTCASE( fh->bufsize == BUFFERSIZE );
     TESTCASE( fclose( fh ) == 0 );
     /* not buffered, user-supplied buffer */
     TESTCASE( ( fh = tmpfile() ) != NULL );
     TESTCASE( setvbuf( fh, buffer, _IONBF, BUFFERSIZE ) == 0 );
     TESTCASE( ( fh->status & ( _IOFBF | _IONBF | _IOLBF ) ) == _IONBF );
     TESTCASE( fclose( fh ) == 0 );
+#ifndef __STDC_NO_THREADS__
+    /* user-supplied buffer, stream locked by the caller (as by flockfile()):
+       the lock must still be held afterwards
+    */
+    TESTCASE( ( fh = tmpfile() ) != NULL );
+    _PDCLIB_FLOCK( fh->lock );
+    TESTCASE( setvbuf( fh, buffer, _IOFBF, BUFFERSIZE ) == 0 );
+    TESTCASE( fh->lock.state != 0 );
+    TESTCASE( fh->lock.count == 1 );
+    TESTCASE( thrd_equal( fh->lock.owner, thrd_current() ) );
+    _PDCLIB_FUNLOCK( fh->lock );
+    TESTCASE( fh->lock.state == 0 );
+    TESTCASE( fclose( fh ) == 0 );
+#endif
 #else
     puts( " NOTEST setvbuf() test driver is PDCLib-specific." );
 #endif
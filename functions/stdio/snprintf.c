@@ -40,6 +40,10 @@ int main( void )
 #include "printf_testcases.h"
     TESTCASE( snprintf( NULL, 0, "foo" ) == 3 );
     TESTCASE( snprintf( NULL, 0, "%d", 100 ) == 3 );
+    TESTCASE( snprintf( target, 3, "foo" ) == 3 );
+    TESTCASE( strcmp( target, "fo" ) == 0 );
+    TESTCASE( snprintf( target, 3, "%s", "bar" ) == 3 );
+    TESTCASE( strcmp( target, "ba" ) == 0 );
     return TEST_RESULTS;
 }
 
@@ -15,19 +15,11 @@
 int ungetc( int c, struct _PDCLIB_file_t * stream )
 {
     int rc;
+    int locked = _PDCLIB_LOCKFILE( stream );
 
-    _PDCLIB_LOCK( stream->mtx );
+    rc = _PDCLIB_ungetc_unlocked( c, stream );
 
-    if ( c == EOF || stream->ungetidx == _PDCLIB_UNGETCBUFSIZE )
-    {
-        rc = -1;
-    }
-    else
-    {
-        rc = stream->ungetbuf[stream->ungetidx++] = ( unsigned char ) c;
-    }
-
-    _PDCLIB_UNLOCK( stream->mtx );
+    _PDCLIB_UNLOCKFILE( stream, locked );
 
     return rc;
 }
@@ -86,6 +78,31 @@ int main( void )
     TESTCASE( fsetpos( fh, &pos ) == 0 );
     TESTCASE( ftell( fh ) == 0 );
     TESTCASE( fgetc( fh ) == '1' );
+    /* Pushing back what was read steps back in the buffer */
+    TESTCASE( fgetc( fh ) == '2' );
+    TESTCASE( ungetc( '2', fh ) == '2' );
+    TESTCASE_NOREG( fh->ungetidx == 0 );
+    TESTCASE( ftell( fh ) == 1 );
+    TESTCASE( ungetc( '1', fh ) == '1' );
+    TESTCASE_NOREG( fh->ungetidx == 0 );
+    TESTCASE( ftell( fh ) == 0 );
+    TESTCASE( fgetc( fh ) == '1' );
+    TESTCASE( fgetc( fh ) == '2' );
+    /* Pushing back something else, or more than one character */
+    TESTCASE( ungetc( 'a', fh ) == 'a' );
+    TESTCASE_NOREG( fh->ungetidx == 1 );
+    TESTCASE_NOREG( ungetc( 'b', fh ) == 'b' );
+    TESTCASE_NOREG( ftell( fh ) == 0 );
+    TESTCASE_NOREG( fgetc( fh ) == 'b' );
+    TESTCASE( fgetc( fh ) == 'a' );
+    TESTCASE( fgetc( fh ) == '3' );
+    /* Pushing back clears end-of-file */
+    TESTCASE( fgetc( fh ) == EOF );
+    TESTCASE( feof( fh ) );
+    TESTCASE( ungetc( '3', fh ) == '3' );
+    TESTCASE( ! feof( fh ) );
+    TESTCASE( fgetc( fh ) == '3' );
+    TESTCASE( ungetc( EOF, fh ) == EOF );
     TESTCASE( fclose( fh ) == 0 );
     return TEST_RESULTS;
 }
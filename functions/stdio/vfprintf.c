@@ -11,6 +11,7 @@
 #ifndef REGTEST
 
 #include "pdclib/_PDCLIB_glue.h"
+#include "pdclib/_PDCLIB_print.h"
 
 #ifndef __STDC_NO_THREADS__
 #include <threads.h>
@@ -20,6 +21,7 @@ int vfprintf( struct _PDCLIB_file_t * _PDCLIB_restrict stream, const char * _PDC
 {
     /* TODO: This function should interpret format as multibyte characters.  */
     struct _PDCLIB_status_t status;
+    int locked;
     status.base = 0;
     status.flags = 0;
     status.n = SIZE_MAX;
@@ -30,11 +32,11 @@ int vfprintf( struct _PDCLIB_file_t * _PDCLIB_restrict stream, const char * _PDC
     status.prec = EOF;
     status.stream = stream;
 
-    _PDCLIB_LOCK( stream->mtx );
+    locked = _PDCLIB_LOCKFILE( stream );
 
     if ( _PDCLIB_prepwrite( stream ) == EOF )
     {
-        _PDCLIB_UNLOCK( stream->mtx );
+        _PDCLIB_UNLOCKFILE( stream, locked );
         return EOF;
     }
 
@@ -46,33 +48,30 @@ int vfprintf( struct _PDCLIB_file_t * _PDCLIB_restrict stream, const char * _PDC
 
         if ( ( *format != '%' ) || ( ( rc = _PDCLIB_print( format, &status ) ) == format ) )
         {
-            /* No conversion specifier, print verbatim */
-            stream->buffer[ stream->bufidx++ ] = *format;
+            /* No conversion specifier, print verbatim -- up to the next one */
+            rc = format + 1;
 
-            if ( ( stream->bufidx == stream->bufsize )
-                 || ( ( stream->status & _IOLBF ) && ( *format == '\n' ) )
-                 || ( stream->status & _IONBF )
-               )
+            while ( *rc != '\0' && *rc != '%' )
             {
-                if ( _PDCLIB_flushbuffer( stream ) != 0 )
-                {
-                    _PDCLIB_UNLOCK( stream->mtx );
-                    return EOF;
-                }
+                ++rc;
             }
 
-            ++format;
-            status.i++;
+            _PDCLIB_print_span( format, rc - format, &status );
         }
-        else
+
+        if ( stream->status & _PDCLIB_ERRORFLAG )
         {
-            /* Continue parsing after conversion specifier */
-            format = rc;
+            va_end( status.arg );
+            _PDCLIB_UNLOCKFILE( stream, locked );
+            return EOF;
         }
+
+        /* Continue parsing after conversion specifier / verbatim text */
+        format = rc;
     }
 
     va_end( status.arg );
-    _PDCLIB_UNLOCK( stream->mtx );
+    _PDCLIB_UNLOCKFILE( stream, locked );
     return status.i;
 }
 
@@ -20,6 +20,7 @@ int vfscanf( FILE * _PDCLIB_restrict stream, const char * _PDCLIB_restrict forma
 {
     /* TODO: This function should interpret format as multibyte characters.  */
     struct _PDCLIB_status_t status;
+    int locked;
     status.base = 0;
     status.flags = 0;
     status.n = 0;
@@ -30,11 +31,11 @@ int vfscanf( FILE * _PDCLIB_restrict stream, const char * _PDCLIB_restrict forma
     status.prec = EOF;
     status.stream = stream;
 
-    _PDCLIB_LOCK( stream->mtx );
+    locked = _PDCLIB_LOCKFILE( stream );
 
     if ( _PDCLIB_prepread( stream ) == EOF || _PDCLIB_CHECKBUFFER( stream ) == EOF )
     {
-        _PDCLIB_UNLOCK( stream->mtx );
+        _PDCLIB_UNLOCKFILE( stream, locked );
         return EOF;
     }
 
@@ -75,11 +76,11 @@ int vfscanf( FILE * _PDCLIB_restrict stream, const char * _PDCLIB_restrict forma
                     }
                     else if ( status.n == 0 )
                     {
-                        _PDCLIB_UNLOCK( stream->mtx );
+                        _PDCLIB_UNLOCKFILE( stream, locked );
                         return EOF;
                     }
 
-                    _PDCLIB_UNLOCK( stream->mtx );
+                    _PDCLIB_UNLOCKFILE( stream, locked );
                     return status.n;
                 }
                 else
@@ -104,7 +105,7 @@ int vfscanf( FILE * _PDCLIB_restrict stream, const char * _PDCLIB_restrict forma
     }
 
     va_end( status.arg );
-    _PDCLIB_UNLOCK( stream->mtx );
+    _PDCLIB_UNLOCKFILE( stream, locked );
     return status.n;
 }
 
@@ -9,6 +9,8 @@
 
 #ifndef REGTEST
 
+#include "pdclib/_PDCLIB_print.h"
+
 int vsnprintf( char * _PDCLIB_restrict s, size_t n, const char * _PDCLIB_restrict format, _PDCLIB_va_list arg )
 {
     /* TODO: This function should interpret format as multibyte characters.  */
@@ -30,26 +32,30 @@ int vsnprintf( char * _PDCLIB_restrict s, size_t n, const char * _PDCLIB_restric
 
         if ( ( *format != '%' ) || ( ( rc = _PDCLIB_print( format, &status ) ) == format ) )
         {
-            /* No conversion specifier, print verbatim */
-            if ( status.i < n )
+            /* No conversion specifier, print verbatim -- up to the next one */
+            rc = format + 1;
+
+            while ( *rc != '\0' && *rc != '%' )
             {
-                s[ status.i ] = *format;
+                ++rc;
             }
 
-            status.i++;
-            format++;
-        }
-        else
-        {
-            /* Continue parsing after conversion specifier */
-            format = rc;
+            _PDCLIB_print_span( format, rc - format, &status );
         }
+
+        /* Continue parsing after conversion specifier / verbatim text */
+        format = rc;
     }
 
     if ( status.i  < n )
     {
         s[ status.i ] = '\0';
     }
+    else if ( n > 0 )
+    {
+        /* Output truncated */
+        s[ n - 1 ] = '\0';
+    }
 
     va_end( status.arg );
     return status.i;
@@ -0,0 +1,28 @@
+/* atof( const char * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#include <stdlib.h>
+
+#ifndef REGTEST
+
+double atof( const char * s )
+{
+    return strtod( s, NULL );
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+    /* no tests for a simple wrapper */
+    return TEST_RESULTS;
+}
+
+#endif
@@ -0,0 +1,204 @@
+/* strtod( const char *, char ** )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef REGTEST
+
+#include <stdint.h>
+
+double strtod( const char * _PDCLIB_restrict nptr, char ** _PDCLIB_restrict endptr )
+{
+    double rc;
+    double factor;
+    uint_least64_t mant[ 2 ];
+    int exp;
+    char sign = '+';
+    const char * p = _PDCLIB_strtod_main( nptr, _PDCLIB_DBL_MANT_DIG, _PDCLIB_DBL_MIN_EXP, _PDCLIB_DBL_MAX_EXP, mant, &exp, &sign );
+
+    if ( endptr != NULL )
+    {
+        *endptr = ( p != NULL ) ? ( char * ) p : ( char * ) nptr;
+    }
+
+    if ( exp == INT_MIN )
+    {
+        unsigned char bytes[ sizeof( double ) ];
+
+        /* 0 / 0 has the sign bit set on some platforms (x86) */
+        rc = 0.0 / 0.0;
+        memcpy( bytes, &rc, sizeof( double ) );
+
+        if ( _PDCLIB_DBL_SIGN( bytes ) )
+        {
+            rc = -rc;
+        }
+    }
+    else if ( exp == INT_MAX )
+    {
+        rc = 1.0 / 0.0;
+    }
+    else
+    {
+        rc = ( double )mant[ 0 ] * 18446744073709551616.0 + ( double )mant[ 1 ];
+
+        /* Scaling by 2^exp, squaring the factor. The intermediate results
+           are the mantissa times powers of two between 1 and 2^exp, all of
+           them exact.
+        */
+        factor = ( exp > 0 ) ? 2.0 : 0.5;
+
+        for ( exp = ( exp > 0 ) ? exp : -exp; exp != 0; exp /= 2 )
+        {
+            if ( exp % 2 != 0 )
+            {
+                rc *= factor;
+            }
+
+            factor *= factor;
+        }
+    }
+
+    return ( sign == '-' ) ? -rc : rc;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+#include <errno.h>
+#include <float.h>
+#include <stddef.h>
+#include <string.h>
+
+/* signbit() without <math.h>: test the bit that differs between 0.0 and
+   -0.0.
+*/
+static int negative( double d )
+{
+    double pos = 0.0;
+    double neg = -0.0;
+    unsigned char bytes[ sizeof( double ) ];
+    unsigned char posbytes[ sizeof( double ) ];
+    unsigned char negbytes[ sizeof( double ) ];
+    size_t i;
+
+    memcpy( bytes, &d, sizeof( double ) );
+    memcpy( posbytes, &pos, sizeof( double ) );
+    memcpy( negbytes, &neg, sizeof( double ) );
+
+    for ( i = 0; i < sizeof( double ); ++i )
+    {
+        if ( bytes[i] & ( posbytes[i] ^ negbytes[i] ) )
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+int main( void )
+{
+    char * endptr;
+    unsigned i;
+    char const * tests[] =
+    {
+        "0.0", "+0.0", "-0.0",
+        "0", "+0", "-0",
+        "inf", "+inf", "-inf",
+        "3.14", "+3.14", "-3.14",
+        "45.1237e6", "+45.1237e+6", "-45.1237e-6",
+        "0xa.bcdp+6", "+0x000.001p-1", "-0x12p4", "0x.123p-6", "0x123.p-5",
+        ".123e-4", "123.e-4",
+        ".e", ".", "",
+        "foo",
+        "0x", "0x.p1", "0x.8p1", "1e", "1e+", " -.5e-1x", "-INFINITx"
+    };
+    double expected_doubles[] =
+    {
+        0x0p+0, 0x0p+0, -0x0p+0,
+        0.0, 0.0, 0.0,
+        ( 1.0 / 0.0 ), ( 1.0 / 0.0 ), ( -1.0 / 0.0 ),
+        0x1.91eb851eb851fp+1, 0x1.91eb851eb851fp+1, -0x1.91eb851eb851fp+1,
+        0x1.58443ap+25, 0x1.58443ap+25, -0x1.7a86686b4c9fep-15,
+        0x1.579ap+9, 0x1p-13, -0x1.2p+8, 0x1.23p-10, 0x1.23p+3,
+        0x1.9cb8320b1507p-17, 0x1.930be0ded288dp-7,
+        0x0p+0, 0x0p+0, 0x0p+0,
+        0.0,
+        0.0, 0.0, 1.0, 1.0, 1.0, -0.05, ( -1.0 / 0.0 )
+    };
+    ptrdiff_t expected_endptr[] =
+    {
+        3, 4, 4,
+        1, 2, 2,
+        3, 4, 4,
+        4, 5, 5,
+        9, 11, 11,
+        10, 13, 7, 9, 9,
+        7, 7,
+        0, 0, 0,
+        0,
+        1, 1, 6, 1, 1, 7, 4
+    };
+    char const * nan_tests[] =
+    {
+        "nan", "+nan", "-nan",
+        "nan(foo)", "nan(foo", "nan(foo42bar)",
+        "nan()", "nan(42)", "nan( )"
+    };
+    ptrdiff_t nan_expected_endptr[] =
+    {
+        3, 4, 4,
+        8, 3, 13,
+        5, 7, 3
+    };
+
+    for ( i = 0; i < sizeof( tests ) / sizeof( tests[0] ); ++i )
+    {
+        double d = strtod( tests[i], &endptr );
+        TESTCASE( d == expected_doubles[i] );
+        TESTCASE( ( endptr - tests[i] ) == expected_endptr[i] );
+    }
+
+    for ( i = 0; i < sizeof( nan_tests ) / sizeof( nan_tests[0] ); ++i )
+    {
+        double d = strtod( nan_tests[i], &endptr );
+        TESTCASE( d != d );
+        TESTCASE( negative( d ) == ( nan_tests[i][0] == '-' ) );
+        TESTCASE( ( endptr - nan_tests[i] ) == nan_expected_endptr[i] );
+    }
+
+    /* Correct rounding, including hard cases */
+    TESTCASE( strtod( "0.1", NULL ) == 0.1 );
+    TESTCASE( strtod( "1e23", NULL ) == 1e23 );
+    TESTCASE( strtod( "8.98846567431158e307", NULL ) == 8.98846567431158e307 );
+    TESTCASE( strtod( "9007199254740993", NULL ) == 9007199254740992.0 );
+    TESTCASE( strtod( "9007199254740993.00000000000000000000000000000000000000001", NULL ) == 9007199254740994.0 );
+    TESTCASE( strtod( "2.2250738585072011e-308", NULL ) == 0x0.fffffffffffffp-1022 );
+    TESTCASE( strtod( "0x1.fffffffffffff7p1023", NULL ) == DBL_MAX );
+    /* Range errors */
+    errno = 0;
+    TESTCASE( strtod( "1.7976931348623157e308", NULL ) == DBL_MAX );
+    TESTCASE( strtod( "0x1p-1022", NULL ) == DBL_MIN );
+    TESTCASE( strtod( "0x1p-1074", NULL ) == DBL_MIN / 4503599627370496.0 );
+    TESTCASE( errno == 0 );
+    TESTCASE( strtod( "-1e400", NULL ) == ( -1.0 / 0.0 ) );
+    TESTCASE( errno == ERANGE );
+    errno = 0;
+    TESTCASE( strtod( "4.94e-324", NULL ) == DBL_MIN / 4503599627370496.0 );
+    TESTCASE( errno == ERANGE );
+    errno = 0;
+    TESTCASE( strtod( "1e-400", NULL ) == 0.0 );
+    TESTCASE( errno == ERANGE );
+    return TEST_RESULTS;
+}
+
+#endif
@@ -0,0 +1,112 @@
+/* strtof( const char *, char ** )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef REGTEST
+
+#include <stdint.h>
+
+float strtof( const char * _PDCLIB_restrict nptr, char ** _PDCLIB_restrict endptr )
+{
+    float rc;
+    float factor;
+    uint_least64_t mant[ 2 ];
+    int exp;
+    char sign = '+';
+    const char * p = _PDCLIB_strtod_main( nptr, _PDCLIB_FLT_MANT_DIG, _PDCLIB_FLT_MIN_EXP, _PDCLIB_FLT_MAX_EXP, mant, &exp, &sign );
+
+    if ( endptr != NULL )
+    {
+        *endptr = ( p != NULL ) ? ( char * ) p : ( char * ) nptr;
+    }
+
+    if ( exp == INT_MIN )
+    {
+        unsigned char bytes[ sizeof( double ) ];
+        double nan;
+
+        /* 0 / 0 has the sign bit set on some platforms (x86); the
+           conversion to float keeps the sign.
+        */
+        nan = 0.0 / 0.0;
+        memcpy( bytes, &nan, sizeof( double ) );
+
+        if ( _PDCLIB_DBL_SIGN( bytes ) )
+        {
+            nan = -nan;
+        }
+
+        rc = ( float )nan;
+    }
+    else if ( exp == INT_MAX )
+    {
+        rc = 1.0f / 0.0f;
+    }
+    else
+    {
+        rc = ( float )mant[ 0 ] * 18446744073709551616.0f + ( float )mant[ 1 ];
+
+        /* Scaling by 2^exp, squaring the factor. The intermediate results
+           are the mantissa times powers of two between 1 and 2^exp, all of
+           them exact.
+        */
+        factor = ( exp > 0 ) ? 2.0f : 0.5f;
+
+        for ( exp = ( exp > 0 ) ? exp : -exp; exp != 0; exp /= 2 )
+        {
+            if ( exp % 2 != 0 )
+            {
+                rc *= factor;
+            }
+
+            factor *= factor;
+        }
+    }
+
+    return ( sign == '-' ) ? -rc : rc;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+#include <errno.h>
+#include <float.h>
+
+int main( void )
+{
+    char * endptr;
+    char const * s = " -0x1.8p1x";
+
+    TESTCASE( strtof( s, &endptr ) == -3.0f );
+    TESTCASE( endptr == s + 9 );
+    TESTCASE( strtof( "foo", &endptr ) == 0.0f );
+    TESTCASE( strtof( "nan", NULL ) != strtof( "nan", NULL ) );
+    /* Rounded to float directly, not through double */
+    TESTCASE( strtof( "0.1", NULL ) == 0.1f );
+    TESTCASE( strtof( "1.00000005960464477539062500001", NULL ) == 1.00000012f );
+    TESTCASE( strtof( "1.000000059604644775390625", NULL ) == 1.0f );
+    TESTCASE( strtof( "16777217", NULL ) == 16777216.0f );
+    /* Range errors */
+    errno = 0;
+    TESTCASE( strtof( "3.40282347e38", NULL ) == FLT_MAX );
+    TESTCASE( strtof( "1.17549435e-38", NULL ) == FLT_MIN );
+    TESTCASE( strtof( "0x1p-149", NULL ) == FLT_MIN / 8388608.0f );
+    TESTCASE( errno == 0 );
+    TESTCASE( strtof( "3.5e38", NULL ) == ( 1.0f / 0.0f ) );
+    TESTCASE( errno == ERANGE );
+    errno = 0;
+    TESTCASE( strtof( "1e-40", NULL ) > 0.0f );
+    TESTCASE( errno == ERANGE );
+    return TEST_RESULTS;
+}
+
+#endif
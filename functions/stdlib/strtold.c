@@ -0,0 +1,104 @@
+/* strtold( const char *, char ** )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef REGTEST
+
+#include <stdint.h>
+
+long double strtold( const char * _PDCLIB_restrict nptr, char ** _PDCLIB_restrict endptr )
+{
+    long double rc;
+    long double factor;
+    uint_least64_t mant[ 2 ];
+    int exp;
+    char sign = '+';
+    const char * p = _PDCLIB_strtod_main( nptr, _PDCLIB_LDBL_MANT_DIG, _PDCLIB_LDBL_MIN_EXP, _PDCLIB_LDBL_MAX_EXP, mant, &exp, &sign );
+
+    if ( endptr != NULL )
+    {
+        *endptr = ( p != NULL ) ? ( char * ) p : ( char * ) nptr;
+    }
+
+    if ( exp == INT_MIN )
+    {
+        unsigned char bytes[ sizeof( long double ) ];
+
+        /* 0 / 0 has the sign bit set on some platforms (x86) */
+        rc = 0.0L / 0.0L;
+        memcpy( bytes, &rc, sizeof( long double ) );
+
+        if ( _PDCLIB_LDBL_SIGN( bytes ) )
+        {
+            rc = -rc;
+        }
+    }
+    else if ( exp == INT_MAX )
+    {
+        rc = 1.0L / 0.0L;
+    }
+    else
+    {
+        rc = ( long double )mant[ 0 ] * 18446744073709551616.0L + ( long double )mant[ 1 ];
+
+        /* Scaling by 2^exp, squaring the factor. The intermediate results
+           are the mantissa times powers of two between 1 and 2^exp, all of
+           them exact.
+        */
+        factor = ( exp > 0 ) ? 2.0L : 0.5L;
+
+        for ( exp = ( exp > 0 ) ? exp : -exp; exp != 0; exp /= 2 )
+        {
+            if ( exp % 2 != 0 )
+            {
+                rc *= factor;
+            }
+
+            factor *= factor;
+        }
+    }
+
+    return ( sign == '-' ) ? -rc : rc;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+#include <errno.h>
+#include <float.h>
+
+int main( void )
+{
+    char * endptr;
+    char const * s = " -0x1.8p1x";
+
+    TESTCASE( strtold( s, &endptr ) == -3.0L );
+    TESTCASE( endptr == s + 9 );
+    TESTCASE( strtold( "foo", &endptr ) == 0.0L );
+    TESTCASE( strtold( "nan", NULL ) != strtold( "nan", NULL ) );
+    TESTCASE( strtold( "0.1", NULL ) == 0.1L );
+    TESTCASE( strtold( "3.14159265358979323846264338327950288", NULL ) == 3.14159265358979323846264338327950288L );
+    TESTCASE( strtold( "1e300", NULL ) == 1e300L );
+    TESTCASE( strtold( "1e-300", NULL ) == 1e-300L );
+    /* Range errors */
+    errno = 0;
+    TESTCASE( strtold( "0x1p-1", NULL ) == 0.5L );
+    TESTCASE( errno == 0 );
+    TESTCASE( strtold( "1e99999", NULL ) == ( 1.0L / 0.0L ) );
+    TESTCASE( errno == ERANGE );
+    errno = 0;
+    TESTCASE( strtold( "1e-99999", NULL ) == 0.0L );
+    TESTCASE( errno == ERANGE );
+    return TEST_RESULTS;
+}
+
+#endif
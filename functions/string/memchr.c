@@ -8,10 +8,38 @@
 
 #ifndef REGTEST
 
+/* Checks a word at a time where possible (see _PDCLIB_wordhasbyte(), also
+   used by _PDCLIB_fwrite_unlocked.c).
+*/
 void * memchr( const void * s, int c, size_t n )
 {
     const unsigned char * p = ( const unsigned char * ) s;
 
+    /* Byte-wise until p is word-aligned. */
+    while ( n > 0 && ( ( _PDCLIB_uintptr_t )p % sizeof( size_t ) ) != 0 )
+    {
+        if ( *p == ( unsigned char ) c )
+        {
+            return ( void * ) p;
+        }
+
+        ++p;
+        --n;
+    }
+
+    /* Word-wise, skipping words that do not contain c. */
+    while ( n >= sizeof( size_t ) )
+    {
+        if ( _PDCLIB_wordhasbyte( p, ( unsigned char ) c ) )
+        {
+            break;
+        }
+
+        p += sizeof( size_t );
+        n -= sizeof( size_t );
+    }
+
+    /* Byte-wise through the word holding c (or the remains). */
     while ( n-- )
     {
         if ( *p == ( unsigned char ) c )
@@ -33,11 +61,23 @@ void * memchr( const void * s, int c, size_t n )
 
 int main( void )
 {
+    const char * text = "The quick brown fox jumps over the lazy dog\n";
+    size_t i;
     TESTCASE( memchr( abcde, 'c', 5 ) == &abcde[2] );
     TESTCASE( memchr( abcde, 'a', 1 ) == &abcde[0] );
     TESTCASE( memchr( abcde, 'a', 0 ) == NULL );
     TESTCASE( memchr( abcde, '\0', 5 ) == NULL );
     TESTCASE( memchr( abcde, '\0', 6 ) == &abcde[5] );
+    /* Different alignments, spanning several words */
+    for ( i = 0; i < 16; ++i )
+    {
+        TESTCASE( memchr( text + i, '\n', 44 - i ) == text + 43 );
+        TESTCASE( memchr( text + i, '\n', 43 - i ) == NULL );
+        TESTCASE( memchr( text + i, 'z', 44 - i ) == text + 37 );
+    }
+
+    TESTCASE( memchr( text, 'T' + 256, 44 ) == text );
+    TESTCASE( memchr( text, '\xff', 44 ) == NULL );
     return TEST_RESULTS;
 }
 
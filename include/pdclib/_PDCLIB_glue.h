@@ -33,6 +33,8 @@ _PDCLIB_LOCAL _PDCLIB_Noreturn void _PDCLIB_Exit( int status ) _PDCLIB_NORETURN;
 /* A system call that opens a file identified by name in a given mode. Return
    a file descriptor uniquely identifying that file.
    (The mode is the return value of the _PDCLIB_filemode() function.)
+   If _PDCLIB_FDIRECT is set, the file is opened for direct I/O if supported
+   for it (and regularly if not).
 */
 _PDCLIB_LOCAL _PDCLIB_fd_t _PDCLIB_open( const char * const filename, unsigned int mode );
 
@@ -42,17 +44,132 @@ _PDCLIB_LOCAL _PDCLIB_fd_t _PDCLIB_open( const char * const filename, unsigned i
 */
 _PDCLIB_LOCAL int _PDCLIB_flushbuffer( struct _PDCLIB_file_t * stream );
 
+/* A system call that writes a stream's buffer, followed by the iovcnt memory
+   areas described by iov (at most _PDCLIB_IOV_MAX), as one gathered write.
+   Used by fwrite() for payloads too large to go through the buffer, saving
+   both the copy into the buffer and a separate system call for the flush.
+   Returns the number of characters written from the memory areas; a value
+   less than their total size indicates a write error, with any unwritten
+   buffer contents moved to the beginning of the buffer.
+   Sets stream error flags and errno appropriately on error.
+*/
+_PDCLIB_LOCAL _PDCLIB_size_t _PDCLIB_writev( struct _PDCLIB_file_t * stream, const struct _PDCLIB_iovec_t * iov, int iovcnt );
+
 /* A system call that fills a stream's buffer.
    Returns 0 on success, EOF on read error / EOF.
    Sets stream EOF / error flags and errno appropriately on error.
 */
 _PDCLIB_LOCAL int _PDCLIB_fillbuffer( struct _PDCLIB_file_t * stream );
 
+/* A system call that reads up to size characters from a stream's file into
+   the given memory, bypassing the stream's buffer (which is expected to be
+   empty). Used by fread() for requests too large to go through the buffer.
+   Returns the number of characters read, which might be less than requested;
+   zero on read error / EOF.
+   Sets stream EOF / error flags and errno appropriately on error.
+*/
+_PDCLIB_LOCAL _PDCLIB_size_t _PDCLIB_read( struct _PDCLIB_file_t * stream, char * buffer, _PDCLIB_size_t size );
+
+#ifndef __STDC_NO_THREADS__
+/* Fills a stream's buffer like _PDCLIB_fillbuffer(), for streams opened with
+   mode "rp". On first call, a second buffer and a worker thread are set up
+   (see struct _PDCLIB_async_t); if that fails, the stream falls back to
+   regular buffering. The worker reads the block following the current
+   buffer contents into the second buffer while the caller consumes the
+   current one; the buffers are then swapped. Reads are positioned (i.e.,
+   do not use or change the file descriptor's offset), with pos.offset the
+   authoritative file position.
+   Returns 0 on success, EOF on read error / EOF.
+   Sets stream EOF / error flags and errno appropriately on error.
+*/
+_PDCLIB_LOCAL int _PDCLIB_readahead( struct _PDCLIB_file_t * stream );
+
+/* Writes a stream's buffer like _PDCLIB_flushbuffer(), for fully buffered
+   streams opened with mode "wd" / "ad". On first call, a second buffer and a
+   worker thread are set up (see struct _PDCLIB_async_t); if that fails, the
+   stream falls back to regular buffering. The buffer is handed over to the
+   worker, and the stream continues with the second buffer; the caller only
+   blocks if the previous buffer is still being written.
+   Returns 0 on success, EOF on write error. As writing is deferred, errors
+   are reported by a later call (or _PDCLIB_waitasync()), with the affected
+   data lost.
+   Sets stream error flags and errno appropriately on error.
+*/
+_PDCLIB_LOCAL int _PDCLIB_writebehind( struct _PDCLIB_file_t * stream );
+
+/* Sets up second buffer and worker thread for _PDCLIB_readahead() /
+   _PDCLIB_writebehind(). Requires a buffer allocated by the library.
+   Returns 0 on success, EOF if resources are not available.
+*/
+_PDCLIB_LOCAL int _PDCLIB_initasync( struct _PDCLIB_file_t * stream, int ( *worker )( void * ) );
+
+/* Waits for the worker thread of a stream (if any) to complete the request
+   in progress. Used by fflush(), fclose(), fseek() etc. to make sure data
+   handed over by _PDCLIB_writebehind() has actually been written.
+   Returns 0 on success, EOF if a deferred error occurred.
+   Sets stream error flags and errno appropriately on error.
+*/
+_PDCLIB_LOCAL int _PDCLIB_waitasync( struct _PDCLIB_file_t * stream );
+
+/* Stops the worker thread of a stream (if any), and releases the resources
+   set up for it. Called by fclose() / freopen() before closing the file.
+*/
+_PDCLIB_LOCAL void _PDCLIB_endasync( struct _PDCLIB_file_t * stream );
+
+/* A system call that puts the calling thread to sleep if *addr equals val,
+   until woken by _PDCLIB_futex_wake() on the same address. May return
+   spuriously; callers re-check their condition. Used by the stream lock
+   (see _PDCLIB_flock_wait()).
+*/
+_PDCLIB_LOCAL void _PDCLIB_futex_wait( int volatile * addr, int val );
+
+/* A system call that wakes one thread sleeping in _PDCLIB_futex_wait() on
+   the given address, if any.
+*/
+_PDCLIB_LOCAL void _PDCLIB_futex_wake( int volatile * addr );
+#endif
+
+/* A system call that maps the whole file associated with a read-only stream
+   into memory, making the mapping the stream's buffer (buffer and bufsize
+   set to the mapping, bufidx and bufend to zero). Called on first read for
+   streams opened with mode "rm". _PDCLIB_fillbuffer() and _PDCLIB_seek()
+   then only move the window within the mapping (bufidx / bufend / pos).
+   Returns 0 on success, EOF if the file cannot be mapped (e.g. because it
+   is not a regular file, or empty), in which case the stream falls back to
+   regular buffering.
+*/
+_PDCLIB_LOCAL int _PDCLIB_mapfile( struct _PDCLIB_file_t * stream );
+
+/* A system call that releases a mapping set up by _PDCLIB_mapfile(), if any.
+*/
+_PDCLIB_LOCAL void _PDCLIB_unmapfile( struct _PDCLIB_file_t * stream );
+
+/* A system call that ends direct I/O for a stream (see _PDCLIB_FDIRECT), when
+   a transfer cannot be aligned to _PDCLIB_DIRECT_ALIGN. Subsequent transfers
+   go through the system's cache. Reads of a direct I/O stream are positioned,
+   so the file descriptor's offset is set to pos.offset.
+*/
+_PDCLIB_LOCAL void _PDCLIB_nodirect( struct _PDCLIB_file_t * stream );
+
 /* A system call that repositions within a file. Returns new offset on success,
    -1 / errno on error.
 */
 _PDCLIB_LOCAL _PDCLIB_int_least64_t _PDCLIB_seek( struct _PDCLIB_file_t * stream, _PDCLIB_int_least64_t offset, int whence );
 
+/* A system call that returns the preferred size for the buffer of a stream
+   associated with the file identified by given file descriptor. This is
+   called when a stream's buffer is allocated on first read / write, unless
+   a buffer size has been set with setvbuf() before. Return at least BUFSIZ,
+   and at most INT_MAX.
+*/
+_PDCLIB_LOCAL _PDCLIB_size_t _PDCLIB_bufsize( _PDCLIB_fd_t fd );
+
+/* A system call that returns nonzero if the file identified by given file
+   descriptor is an interactive device (e.g. a terminal), zero otherwise.
+   Streams are line buffered if interactive, fully buffered if not.
+*/
+_PDCLIB_LOCAL int _PDCLIB_isinteractive( _PDCLIB_fd_t fd );
+
 /* A system call that closes a file identified by given file descriptor. Return
    zero on success, non-zero otherwise.
 */
@@ -69,10 +186,20 @@ _PDCLIB_LOCAL int _PDCLIB_close( _PDCLIB_fd_t fd );
 */
 _PDCLIB_LOCAL int _PDCLIB_changemode( struct _PDCLIB_file_t * stream, unsigned int mode );
 
-/* A system call that returns a canonicalized absolute filename in
-   dynamically allocated memory, or NULL if the file does not exist.
+/* A system call that returns the canonicalized absolute filename of the file
+   identified by given file descriptor in dynamically allocated memory, or
+   NULL if it cannot be determined. Called by freopen() only when a stream
+   is to be reopened under its current name (filename NULL), so opening a
+   file does not pay for it.
+*/
+_PDCLIB_LOCAL char * _PDCLIB_realpath( _PDCLIB_fd_t fd );
+
+#ifdef _PDCLIB_STREAMSTATS
+/* A system call that returns the value of a monotonic clock, in nanoseconds.
+   Used for timing system calls (see _PDCLIB_STATS_START()).
 */
-_PDCLIB_LOCAL char * _PDCLIB_realpath( const char * path );
+_PDCLIB_LOCAL _PDCLIB_uint_least64_t _PDCLIB_nanotime( void );
+#endif
 
 /* A system call that removes a file. Return zero on success, non-zero
    otherwise.
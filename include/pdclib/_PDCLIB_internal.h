@@ -81,6 +81,13 @@ extern "C" {
 /* _PDCLIB_TYPE_SIGNED( type ) resolves to true if type is signed.            */
 /* _PDCLIB_LOCK( mtx ) lock a mutex if library has threads support.           */
 /* _PDCLIB_UNLOCK( mtx ) unlock a mutex if library has threads support.       */
+/* _PDCLIB_FLOCK( lock ) acquire a stream lock (struct _PDCLIB_flock_t).      */
+/* _PDCLIB_FUNLOCK( lock ) release a stream lock.                             */
+/* _PDCLIB_LOCKFILE( fh ) lock a stream if library has threads support, and   */
+/*                        a thread has been created. Returns nonzero if the   */
+/*                        stream has been locked.                             */
+/* _PDCLIB_UNLOCKFILE( fh, locked ) unlock a stream if locked (the value      */
+/*                                  returned by _PDCLIB_LOCKFILE( fh )).      */
 /* _PDCLIB_CONSTRAINT_VIOLATION( e ) expand errno number e to parameter list  */
 /*                                   fit for Annex K constraint violation     */
 /*                                   handler.                                 */
@@ -96,15 +103,53 @@ extern "C" {
 #ifndef __STDC_NO_THREADS__
 #define _PDCLIB_LOCK( mtx ) mtx_lock( &mtx )
 #define _PDCLIB_UNLOCK( mtx ) mtx_unlock( &mtx )
+/* The uncontended case takes a single compare-and-swap. Recursive locking and
+   contention are handled by _PDCLIB_flock_wait(); _PDCLIB_flock_wake() is
+   only called if there are threads waiting for the lock.
+*/
+#define _PDCLIB_FLOCK( lock ) ( _PDCLIB_ATOMIC_CAS( &( lock ).state, 0, 1 ) ? ( void )( ( lock ).owner = thrd_current(), ( lock ).count = 1 ) : _PDCLIB_flock_wait( &( lock ) ) )
+#define _PDCLIB_FUNLOCK( lock ) ( ( --( lock ).count == 0 ) ? ( void )( ( lock ).owner = 0, ( _PDCLIB_ATOMIC_SWAP( &( lock ).state, 0 ) == 2 ) ? _PDCLIB_flock_wake( &( lock ) ) : ( void )0 ) : ( void )0 )
+#ifdef _PDCLIB_STREAMSTATS
+#define _PDCLIB_FLOCK_INIT { 0, 0, 0, 0 }
+#else
+#define _PDCLIB_FLOCK_INIT { 0, 0, 0 }
+#endif
+/* Set by thrd_create(). As long as a process is single-threaded, there is no
+   need for stream functions to lock. Whether the lock was taken is recorded
+   by the caller, as the flag might change while the stream is "locked" (a
+   thread created by the locking thread).
+*/
+extern int _PDCLIB_threaded;
+#define _PDCLIB_LOCKFILE( fh ) ( _PDCLIB_threaded ? ( _PDCLIB_FLOCK( ( fh )->lock ), 1 ) : 0 )
+#define _PDCLIB_UNLOCKFILE( fh, locked ) ( ( locked ) ? _PDCLIB_FUNLOCK( ( fh )->lock ) : ( void )0 )
 #else
 #define _PDCLIB_LOCK( mtx )
 #define _PDCLIB_UNLOCK( mtx )
+#define _PDCLIB_FLOCK( lock )
+#define _PDCLIB_FUNLOCK( lock )
+#define _PDCLIB_LOCKFILE( fh ) 0
+#define _PDCLIB_UNLOCKFILE( fh, locked ) ( ( void )( locked ) )
 #endif
 
 #define _PDCLIB_CONSTRAINT_VIOLATION( e ) _PDCLIB_lc_messages->errno_texts[e], NULL, e
 
 #define _PDCLIB_GETC( fh ) ( ( fh->ungetidx == 0 ) ? ( unsigned char )fh->buffer[ fh->bufidx++ ] : ( unsigned char )fh->ungetbuf[ --fh->ungetidx ] )
 
+/* Keeping of stream statistics (see _PDCLIB_STREAMSTATS in _PDCLIB_config.h).
+   _PDCLIB_STATS_START() / _PDCLIB_STATS_STOP() bracket a system call (or wait
+   for a worker thread), adding the time spent to the stream's syscall_ns.
+   Without _PDCLIB_STREAMSTATS, these expand to nothing.
+*/
+#ifdef _PDCLIB_STREAMSTATS
+#define _PDCLIB_STATS_ADD( fh, member, n ) ( ( fh )->stats.member += ( n ) )
+#define _PDCLIB_STATS_START( fh ) ( ( fh )->statstart = _PDCLIB_nanotime() )
+#define _PDCLIB_STATS_STOP( fh ) ( ( fh )->stats.syscall_ns += _PDCLIB_nanotime() - ( fh )->statstart )
+#else
+#define _PDCLIB_STATS_ADD( fh, member, n ) ( ( void )0 )
+#define _PDCLIB_STATS_START( fh ) ( ( void )0 )
+#define _PDCLIB_STATS_STOP( fh ) ( ( void )0 )
+#endif
+
 #define _PDCLIB_CHECKBUFFER( fh ) ( ( ( fh->bufidx == fh->bufend ) && ( fh->ungetidx == 0 ) ) ? _PDCLIB_fillbuffer( fh ) : 0 )
 
 /* -------------------------------------------------------------------------- */
@@ -310,6 +355,25 @@ extern "C" {
 #define _PDCLIB_BYTESTREAM  (1u<<12)
 /* file associated with stream should be remove()d on closing (tmpfile()) */
 #define _PDCLIB_DELONCLOSE  (1u<<13)
+/* buffer is a read-only mapping of the file (fopen() mode "rm") */
+#define _PDCLIB_FMMAP       (1u<<14)
+/* buffer is filled by a read-ahead thread (fopen() mode "rp") */
+#define _PDCLIB_FAHEAD      (1u<<15)
+/* buffer is written by a write-behind thread (fopen() mode "wd" / "ad") */
+#define _PDCLIB_FBEHIND     (1u<<16)
+/* stream does I/O through the functions of a cookie instead of a file
+   (fopencookie(), fmemopen(), open_memstream()); see struct _PDCLIB_cookie_t */
+#define _PDCLIB_FCOOKIE     (1u<<17)
+/* file is opened for direct I/O, bypassing the system's cache (fopen() mode
+   "ru" / "wu"); buffer, file offsets and transfer sizes are aligned to
+   _PDCLIB_DIRECT_ALIGN */
+#define _PDCLIB_FDIRECT     (1u<<18)
+/* stream has been closed, but not yet removed from the list of open files
+   (fclose()) */
+#define _PDCLIB_FCLOSED     (1u<<19)
+
+/* Value of the tag field of streams on the list of open files. */
+#define _PDCLIB_FILE_TAG 0x46494c45u
 
 /* Position / status structure for getpos() / fsetpos(). */
 struct _PDCLIB_fpos_t
@@ -318,10 +382,113 @@ struct _PDCLIB_fpos_t
     int                    status; /* Multibyte parsing state (unused, reserved) */
 };
 
+/* I/O functions of a cookie stream (cookie_io_functions_t, see fopencookie()).
+   read returns the number of characters read, zero on end-of-file, -1 on error.
+   write returns the number of characters written, zero on error. seek
+   repositions to *offset relative to whence, storing the resulting position in
+   *offset; returns zero on success, -1 on error. close returns zero on success,
+   EOF on error. Any of them may be NULL.
+*/
+struct _PDCLIB_cookie_io_functions_t
+{
+    _PDCLIB_ptrdiff_t ( *read )( void * cookie, char * buf, _PDCLIB_size_t size );
+    _PDCLIB_ptrdiff_t ( *write )( void * cookie, const char * buf, _PDCLIB_size_t size );
+    int ( *seek )( void * cookie, _PDCLIB_int_least64_t * offset, int whence );
+    int ( *close )( void * cookie );
+};
+
+/* I/O backend of a cookie stream, taking the place of the OS file handle. The
+   OS glue functions hand over to _PDCLIB_cookieread(), _PDCLIB_cookiewrite()
+   and _PDCLIB_cookieseek() for streams with _PDCLIB_FCOOKIE set instead of
+   making system calls.
+*/
+struct _PDCLIB_cookie_t
+{
+    void *                               cookie; /* Passed to the functions */
+    struct _PDCLIB_cookie_io_functions_t io;     /* I/O functions */
+};
+
+/* In-memory file of a stream opened by fmemopen() / open_memstream(), used as
+   cookie by the I/O functions _PDCLIB_memread(), _PDCLIB_memwrite(),
+   _PDCLIB_memseek() and _PDCLIB_memclose().
+   For open_memstream(), data grows as needed (always keeping a terminating
+   zero byte beyond size), and *bufp / *sizep are updated on every write or
+   reposition. For fmemopen(), data is the (fixed size) buffer given by, or
+   allocated for, the user.
+*/
+struct _PDCLIB_memfile_t
+{
+    char *           data;     /* File contents */
+    _PDCLIB_size_t   size;     /* Size of file contents */
+    _PDCLIB_size_t   capacity; /* Size of data memory */
+    _PDCLIB_size_t   pos;      /* Current position */
+    char **          bufp;     /* open_memstream(): user's buffer pointer */
+    _PDCLIB_size_t * sizep;    /* open_memstream(): user's size */
+    int              append;   /* Writing always at end of contents */
+    int              freedata; /* data is to be free()d on close */
+};
+
+#ifdef _PDCLIB_STREAMSTATS
+/* I/O statistics of a stream (see _PDCLIB_STREAMSTATS in _PDCLIB_config.h,
+   and _PDCLIB_streamstats() in <stdio.h>). Counted by the OS glue functions,
+   using _PDCLIB_STATS_ADD(), _PDCLIB_STATS_START() and _PDCLIB_STATS_STOP().
+*/
+struct _PDCLIB_streamstats_t
+{
+    _PDCLIB_uint_least64_t bytes_read;    /* Characters read from the file */
+    _PDCLIB_uint_least64_t bytes_written; /* Characters written to the file */
+    _PDCLIB_uint_least64_t fills;         /* Calls of _PDCLIB_fillbuffer() */
+    _PDCLIB_uint_least64_t flushes;       /* Calls of _PDCLIB_flushbuffer() */
+    _PDCLIB_uint_least64_t seeks;         /* Calls of _PDCLIB_seek() */
+    _PDCLIB_uint_least64_t contentions;   /* Lock found held by another thread */
+    _PDCLIB_uint_least64_t syscall_ns;    /* Nanoseconds spent in system calls */
+};
+#endif
+
 /* FILE structure */
+#ifndef __STDC_NO_THREADS__
+/* Stream lock. Unlike _PDCLIB_mtx_t, which is sized for a full (recursive)
+   pthread mutex, this is just a futex word plus owner / recursion count.
+   Locked by _PDCLIB_FLOCK(), unlocked by _PDCLIB_FUNLOCK(); an all-zero
+   lock is unlocked.
+*/
+struct _PDCLIB_flock_t
+{
+    int volatile            state;  /* 0 unlocked, 1 locked, 2 contended */
+    unsigned int            count;  /* Recursion count */
+    _PDCLIB_thrd_t volatile owner;  /* Thread holding the lock */
+#ifdef _PDCLIB_STREAMSTATS
+    _PDCLIB_uint_least64_t  contentions; /* Times found held by another thread */
+#endif
+};
+
+/* State shared between a stream and its worker thread doing I/O in the
+   background (see _PDCLIB_readahead(), _PDCLIB_writebehind()). Protected by
+   mtx, with cnd signalling changes of state.
+*/
+struct _PDCLIB_async_t
+{
+    _PDCLIB_thrd_t         thread;  /* Worker thread */
+    _PDCLIB_mtx_t          mtx;     /* Protecting the members below */
+    _PDCLIB_cnd_t          cnd;     /* Signalling changes of state */
+    char *                 buffer;  /* Second buffer, used by worker */
+    _PDCLIB_size_t         len;     /* Characters requested / done */
+    _PDCLIB_uint_least64_t offset;  /* File offset of buffer contents */
+    int                    state;   /* _PDCLIB_ASYNC_* */
+    int                    error;   /* errno of a failed request */
+};
+
+/* States of struct _PDCLIB_async_t */
+#define _PDCLIB_ASYNC_IDLE      0
+#define _PDCLIB_ASYNC_REQUESTED 1
+#define _PDCLIB_ASYNC_DONE      2
+#define _PDCLIB_ASYNC_QUIT      3
+#endif
+
 struct _PDCLIB_file_t
 {
     _PDCLIB_fd_t            handle;   /* OS file handle */
+    struct _PDCLIB_cookie_t * cookie; /* Cookie stream (if _PDCLIB_FCOOKIE) */
     char *                  buffer;   /* Pointer to buffer memory */
     _PDCLIB_size_t          bufsize;  /* Size of buffer */
     _PDCLIB_size_t          bufidx;   /* Index of current position in buffer */
@@ -332,10 +499,18 @@ struct _PDCLIB_file_t
     unsigned int            status;   /* Status flags; see above */
     /* multibyte parsing status to be added later */
 #ifndef __STDC_NO_THREADS__
-    _PDCLIB_mtx_t           mtx;      /* Multithreading safety */
+    struct _PDCLIB_flock_t  lock;     /* Multithreading safety */
+    struct _PDCLIB_async_t * async;   /* Worker thread state */
 #endif
     char *                  filename; /* Name the current stream has been opened with */
     struct _PDCLIB_file_t * next;     /* Pointer to next struct (internal) */
+    struct _PDCLIB_file_t * prev;     /* Pointer to previous struct (internal) */
+    unsigned int            tag;      /* _PDCLIB_FILE_TAG while on the list */
+    unsigned int            refs;     /* References by _PDCLIB_refstreams() */
+#ifdef _PDCLIB_STREAMSTATS
+    struct _PDCLIB_streamstats_t stats; /* I/O statistics */
+    _PDCLIB_uint_least64_t  statstart; /* Start of system call being timed */
+#endif
 };
 
 /* -------------------------------------------------------------------------- */
@@ -366,6 +541,30 @@ struct _PDCLIB_status_t
     _PDCLIB_va_list  arg;    /* argument stack                               */
 };
 
+/* A conversion specifier parsed by _PDCLIB_print_parse(), or a run of
+   literal text (if text is not NULL).
+*/
+struct _PDCLIB_printop_t
+{
+    const char *     text;   /* literal text                                 */
+    _PDCLIB_size_t   length; /* number of characters of literal text         */
+    int              base;   /* base to which the value shall be converted   */
+    _PDCLIB_int_fast32_t flags; /* flags and length modifiers                */
+    _PDCLIB_size_t   width;  /* specified field width                        */
+    int              prec;   /* specified field precision                    */
+    char             conversion; /* conversion specifier character           */
+};
+
+/* A format string compiled by _PDCLIB_compileformat() (see <stdio.h>). The
+   ops and the literal text they refer to are allocated along with the
+   structure.
+*/
+struct _PDCLIB_format_t
+{
+    _PDCLIB_size_t             count; /* number of ops                       */
+    struct _PDCLIB_printop_t * ops;   /* literal text / conversion specifiers */
+};
+
 /* -------------------------------------------------------------------------- */
 /* Declaration of helper functions (implemented in functions/_PDCLIB).        */
 /* -------------------------------------------------------------------------- */
@@ -377,9 +576,20 @@ _PDCLIB_LOCAL _PDCLIB_intmax_t _PDCLIB_atomax( const char * s );
 _PDCLIB_LOCAL const char * _PDCLIB_strtox_prelim( const char * p, char * sign, int * base );
 _PDCLIB_LOCAL _PDCLIB_uintmax_t _PDCLIB_strtox_main( const char ** p, unsigned int base, _PDCLIB_uintmax_t error, _PDCLIB_uintmax_t limval, int limdigit, char * sign );
 
-/* A helper function used by strtof(), strtod(), and strtold().               */
+/* Two helper functions used by strtof(), strtod(), and strtold().           */
 _PDCLIB_LOCAL void _PDCLIB_strtod_scan( const char * s, const char ** dec, const char ** frac, const char ** exp, int base );
 
+/* Converts the string at nptr, correctly rounded (to nearest) to a floating
+   point format of mant_dig bits, and min_exp / max_exp as for <float.h>.
+   The result is ( mant[0] * 2^64 + mant[1] ) * 2^exp, the sign stored at
+   sign ('+' or '-'), with exp INT_MAX for infinity (setting errno to
+   ERANGE on overflow) or INT_MIN for NaN. Sets errno to ERANGE as well if
+   the result is subnormal (or zero) and inexact.
+   Returns a pointer to the first character not converted, or NULL (with a
+   zero result, sign '+') if no conversion could be performed.
+*/
+_PDCLIB_LOCAL const char * _PDCLIB_strtod_main( const char * nptr, _PDCLIB_size_t mant_dig, int min_exp, int max_exp, _PDCLIB_uint_least64_t mant[ 2 ], int * exp, char * sign );
+
 /* Digits arrays used by various integer conversion functions */
 extern const char _PDCLIB_digits[];
 extern const char _PDCLIB_Xdigits[];
@@ -409,6 +619,7 @@ _PDCLIB_LOCAL unsigned int _PDCLIB_filemode( const char * mode );
 
 /* Initialize a FILE structure. If the parameter is NULL, a new FILE structure
    is malloc'ed. Returns a pointer to the stream if successful, NULL otherwise.
+   The stream buffer is not allocated here, see _PDCLIB_allocbuffer().
 */
 _PDCLIB_LOCAL struct _PDCLIB_file_t * _PDCLIB_init_file_t( struct _PDCLIB_file_t * stream );
 
@@ -426,6 +637,103 @@ _PDCLIB_LOCAL int _PDCLIB_prepread( struct _PDCLIB_file_t * stream );
 */
 _PDCLIB_LOCAL int _PDCLIB_prepwrite( struct _PDCLIB_file_t * stream );
 
+/* Allocating a stream's buffer on first use, sized as requested by setvbuf()
+   or, lacking that, as suggested by _PDCLIB_bufsize(). Streams opened with
+   mode "rm" get the file mapped as buffer instead, if _PDCLIB_mapfile()
+   succeeds. Also sets the buffer mode if none has been set yet (standard
+   streams). Called by _PDCLIB_prepread() and _PDCLIB_prepwrite(); a no-op if
+   the stream already has a buffer and buffer mode.
+   Returns 0 on success, EOF on error.
+   On error, error flags and errno are set appropriately.
+*/
+_PDCLIB_LOCAL int _PDCLIB_allocbuffer( struct _PDCLIB_file_t * stream );
+
+/* The workings of fread() / fwrite(), without locking the stream. Called by
+   those functions (with the stream locked), and by fread_unlocked() /
+   fwrite_unlocked().
+*/
+_PDCLIB_LOCAL _PDCLIB_size_t _PDCLIB_fread_unlocked( void * _PDCLIB_restrict ptr, _PDCLIB_size_t size, _PDCLIB_size_t nmemb, struct _PDCLIB_file_t * _PDCLIB_restrict stream );
+_PDCLIB_LOCAL _PDCLIB_size_t _PDCLIB_fwrite_unlocked( const void * _PDCLIB_restrict ptr, _PDCLIB_size_t size, _PDCLIB_size_t nmemb, struct _PDCLIB_file_t * _PDCLIB_restrict stream );
+
+/* Checks whether the size_t-sized word at p (which need not be aligned)
+   contains the byte c. Used for scanning memory a word at a time.
+   Returns nonzero if it does, zero otherwise.
+*/
+_PDCLIB_LOCAL int _PDCLIB_wordhasbyte( const void * p, unsigned char c );
+
+/* The workings of ungetc(), without locking the stream. Called by ungetc()
+   (with the stream locked), and by _PDCLIB_scan() for its lookahead. If c is
+   the character last read from the stream buffer, and nothing else has been
+   pushed back, this just steps back in the buffer; otherwise, c is stored in
+   the stream's ungetbuf (if there is room).
+   Returns c (converted to unsigned char), or EOF if c is EOF or could not be
+   pushed back.
+*/
+_PDCLIB_LOCAL int _PDCLIB_ungetc_unlocked( int c, struct _PDCLIB_file_t * stream );
+
+#ifndef __STDC_NO_THREADS__
+/* Slow paths of _PDCLIB_FLOCK() / _PDCLIB_FUNLOCK(). _PDCLIB_flock_wait()
+   increments the recursion count if the calling thread already holds the
+   lock; otherwise it spins for _PDCLIB_FLOCK_SPINS attempts before marking
+   the lock contended and waiting with _PDCLIB_futex_wait().
+   _PDCLIB_flock_wake() wakes one thread waiting for the lock.
+*/
+_PDCLIB_LOCAL void _PDCLIB_flock_wait( struct _PDCLIB_flock_t * lock );
+_PDCLIB_LOCAL void _PDCLIB_flock_wake( struct _PDCLIB_flock_t * lock );
+#endif
+
+/* Returns an array of all streams on the internal list of open files (their
+   number stored in *count), to be released with _PDCLIB_unrefstreams().
+   Each stream's refs is incremented, keeping fclose() from freeing it, so the
+   streams can be processed without holding _PDCLIB_filelist_mtx (fflush(),
+   _PDCLIB_closeall()). Streams might have been closed meanwhile, which has
+   to be checked with _PDCLIB_isstream() (with the stream locked).
+   Returns NULL if memory could not be allocated.
+*/
+_PDCLIB_LOCAL struct _PDCLIB_file_t ** _PDCLIB_refstreams( _PDCLIB_size_t * count );
+
+/* Releases an array returned by _PDCLIB_refstreams(), freeing any streams that
+   have been closed while referenced.
+*/
+_PDCLIB_LOCAL void _PDCLIB_unrefstreams( struct _PDCLIB_file_t ** streams, _PDCLIB_size_t count );
+
+/* I/O of a cookie stream (see struct _PDCLIB_cookie_t), used by the OS glue
+   functions in place of system calls for streams with _PDCLIB_FCOOKIE set.
+   These update the stream's position, and set its error / EOF flags as
+   appropriate (errno being set by the cookie's I/O functions).
+   _PDCLIB_cookieread() reads up to size characters into buffer, returning the
+   number of characters read; zero on read error / EOF.
+   _PDCLIB_cookiewrite() writes size characters from buffer, returning the
+   number of characters written; a value less than size indicates an error.
+   _PDCLIB_cookieseek() repositions like _PDCLIB_seek(), returning the new
+   offset, or EOF on error.
+   _PDCLIB_cookieclose() calls the cookie's close function, and releases the
+   struct _PDCLIB_cookie_t. Returns zero on success, EOF on error.
+*/
+_PDCLIB_LOCAL _PDCLIB_size_t _PDCLIB_cookieread( struct _PDCLIB_file_t * stream, char * buffer, _PDCLIB_size_t size );
+_PDCLIB_LOCAL _PDCLIB_size_t _PDCLIB_cookiewrite( struct _PDCLIB_file_t * stream, const char * buffer, _PDCLIB_size_t size );
+_PDCLIB_LOCAL _PDCLIB_int_least64_t _PDCLIB_cookieseek( struct _PDCLIB_file_t * stream, _PDCLIB_int_least64_t offset, int whence );
+_PDCLIB_LOCAL int _PDCLIB_cookieclose( struct _PDCLIB_file_t * stream );
+
+/* Cookie I/O functions (see struct _PDCLIB_cookie_io_functions_t) operating on
+   a struct _PDCLIB_memfile_t, for fmemopen() / open_memstream().
+   _PDCLIB_memwrite() fails with ENOSPC if a fmemopen() buffer is full (writing
+   what fits before), ENOMEM if an open_memstream() buffer cannot grow.
+   _PDCLIB_memseek() fails with EINVAL for positions before the beginning, or
+   beyond the end of a fmemopen() buffer.
+   _PDCLIB_memclose() releases the in-memory file (but not an open_memstream()
+   buffer, which belongs to the user).
+*/
+_PDCLIB_LOCAL _PDCLIB_ptrdiff_t _PDCLIB_memread( void * cookie, char * buf, _PDCLIB_size_t size );
+_PDCLIB_LOCAL _PDCLIB_ptrdiff_t _PDCLIB_memwrite( void * cookie, const char * buf, _PDCLIB_size_t size );
+_PDCLIB_LOCAL int _PDCLIB_memseek( void * cookie, _PDCLIB_int_least64_t * offset, int whence );
+_PDCLIB_LOCAL int _PDCLIB_memclose( void * cookie );
+
+#ifdef _PDCLIB_STREAMSTATS
+/* Adds the stream statistics in stats to those in total. */
+_PDCLIB_LOCAL void _PDCLIB_addstreamstats( struct _PDCLIB_streamstats_t * total, const struct _PDCLIB_streamstats_t * stats );
+#endif
+
 /* Closing all streams on program exit */
 _PDCLIB_LOCAL void _PDCLIB_closeall( void );
 
@@ -444,20 +752,28 @@ _PDCLIB_LOCAL char * _PDCLIB_load_lines( struct _PDCLIB_file_t * stream, _PDCLIB
 _PDCLIB_LOCAL char * _PDCLIB_geterrtext( int errnum );
 
 /* Returns non-zero if the given stream is on the internal list of open files,
-   zero otherwise. Sets the second paramenter (if not NULL) to the previous
-   stream on the list (or NULL if the given stream is the first on the list).
+   zero otherwise. This checks the stream's tag (set while the stream is on
+   the list, cleared when it is removed) instead of walking the list, so it
+   takes constant time.
    This function does not lock _PDCLIB_filelist_mtx, this needs to be done by
    the calling function (_PDCLIB_getstream() or freopen()).
 */
-_PDCLIB_LOCAL int _PDCLIB_isstream( struct _PDCLIB_file_t * stream, struct _PDCLIB_file_t ** previous );
+_PDCLIB_LOCAL int _PDCLIB_isstream( struct _PDCLIB_file_t * stream );
 
-/* Removes the given stream from the internal list of open files. Returns zero
-   if successful, non-zero otherwise. In case of error, sets errno to EBADF.
+/* Removes the given stream from the internal list of open files (a doubly
+   linked list, so in constant time). Returns zero if successful, non-zero
+   otherwise. In case of error, sets errno to EBADF.
    This function does not lock _PDCLIB_filelist_mtx, this needs to be done by
-   the calling function (fclose()).
+   the calling function (fclose(), freopen()).
 */
 _PDCLIB_LOCAL int _PDCLIB_getstream( struct _PDCLIB_file_t * stream );
 
+/* Adds the given stream to the front of the internal list of open files.
+   This function does not lock _PDCLIB_filelist_mtx, this needs to be done by
+   the calling function (fopen(), freopen(), tmpfile()).
+*/
+_PDCLIB_LOCAL void _PDCLIB_putstream( struct _PDCLIB_file_t * stream );
+
 /* Backend for strtok and strtok_s (plus potential extensions like strtok_r). */
 _PDCLIB_LOCAL char * _PDCLIB_strtok( char * _PDCLIB_restrict s1, _PDCLIB_size_t * _PDCLIB_restrict s1max, const char * _PDCLIB_restrict s2, char ** _PDCLIB_restrict ptr );
 
@@ -747,6 +1063,182 @@ _PDCLIB_LOCAL int _PDCLIB_double_split( double value, unsigned * exponent, _PDCL
 */
 _PDCLIB_LOCAL int _PDCLIB_long_double_split( long double value, unsigned * exponent, _PDCLIB_bigint_t * significand );
 
+/* -------------------------------------------------------------------------- */
+/* _PDCLIB_decimal_t support (decimal floating point conversions)             */
+/* -------------------------------------------------------------------------- */
+
+/* Every binary floating point value has a terminating decimal expansion. A
+   _PDCLIB_decimal_t holds that expansion exactly, as N * 10^-scale, with N an
+   integer in base 10^9 "limbs". With a binary exponent e < 0, N is the
+   mantissa times 5^-e (scale -e); otherwise, N is the mantissa times 2^e
+   (scale 0). No division is involved, and the effort only grows with the
+   magnitude of the exponent.
+   (A _PDCLIB_bigint_t is too small for this, as the exact value of subnormal
+   doubles, or of most long doubles, takes several thousand bits.)
+   As most conversions need only a few leading digits, N can instead be
+   computed from its leading limbs only (see _PDCLIB_decimal_fp()), which
+   keeps values of large magnitude cheap. Rounding such an approximation is
+   correct unless it is too close to a tie, in which case the exact value
+   is computed as fallback.
+*/
+
+/* Decimal digits per limb, and the limb base. */
+#define _PDCLIB_DECIMAL_LIMB_DIGITS 9
+#define _PDCLIB_DECIMAL_LIMB_BASE _PDCLIB_UINT_LEAST32_C( 1000000000 )
+
+/* Limbs needed for the largest N, i.e. the smallest subnormal long double:
+   mantissa digits * log10( 2 ) + ( bias + mantissa digits ) * log10( 5 ),
+   rounded up, plus one limb for a carry on rounding.
+*/
+#define _PDCLIB_DECIMAL_LIMBS ( ( ( _PDCLIB_LDBL_MANT_DIG * 31 ) / 100 + ( ( _PDCLIB_LDBL_BIAS + _PDCLIB_LDBL_MANT_DIG ) * 7 ) / 10 + 2 ) / _PDCLIB_DECIMAL_LIMB_DIGITS + 2 )
+
+typedef _PDCLIB_uint_least32_t _PDCLIB_decimal_limb_t;
+
+typedef struct
+{
+    /* Least significant limb first */
+    _PDCLIB_decimal_limb_t data[ _PDCLIB_DECIMAL_LIMBS ];
+    /* Number of limbs used; zero value == zero size */
+    _PDCLIB_size_t size;
+    /* Number of decimal digits in N; zero value == zero digits */
+    long digits;
+    /* Value is N * 10^-scale */
+    long scale;
+    /* Nonzero if lower limbs have been dropped, making the two least
+       significant limbs approximate (too small)
+    */
+    int inexact;
+} _PDCLIB_decimal_t;
+
+/* Least significant digits of an inexact decimal that are not reliable. */
+#define _PDCLIB_DECIMAL_GUARD ( 2 * _PDCLIB_DECIMAL_LIMB_DIGITS )
+
+/* Sets a decimal to the exact value of a floating point number, given by
+   exponent (unbiased), decimal (1 - normalized, 0 - subnormal), the most
+   significant byte of the mantissa, and the number of mantissa digits
+   (including the decimal), as used by _PDCLIB_print_fp.c. The sign is not
+   part of the decimal.
+   If need is positive, only the leading need digits are required: limbs
+   beyond those (plus _PDCLIB_DECIMAL_GUARD) are dropped as the value is
+   computed, and the result may be inexact. If need is zero or less, the
+   result is exact.
+*/
+_PDCLIB_LOCAL _PDCLIB_decimal_t * _PDCLIB_decimal_fp( _PDCLIB_decimal_t * decimal, int exp, int dec, unsigned char const * mant, _PDCLIB_size_t mant_dig, long need );
+
+/* The steps of _PDCLIB_decimal_fp(), for callers that need to work on the
+   mantissa before scaling it.
+   _PDCLIB_decimal_mant() sets N to the integer mantissa (decimal, mant, and
+   mant_dig as for _PDCLIB_decimal_fp()), with scale zero.
+   _PDCLIB_decimal_muladd() sets N to N * factor + addend (both less than
+   2^31).
+   _PDCLIB_decimal_scale() sets the decimal to N * 2^exp, with need as for
+   _PDCLIB_decimal_fp().
+*/
+_PDCLIB_LOCAL _PDCLIB_decimal_t * _PDCLIB_decimal_mant( _PDCLIB_decimal_t * decimal, int dec, unsigned char const * mant, _PDCLIB_size_t mant_dig );
+_PDCLIB_LOCAL _PDCLIB_decimal_t * _PDCLIB_decimal_muladd( _PDCLIB_decimal_t * decimal, _PDCLIB_decimal_limb_t factor, _PDCLIB_decimal_limb_t addend );
+_PDCLIB_LOCAL _PDCLIB_decimal_t * _PDCLIB_decimal_scale( _PDCLIB_decimal_t * decimal, int exp, long need );
+
+/* Returns the decimal exponent of the most significant digit of a given
+   decimal, i.e. digits - 1 - scale (zero for a zero value).
+*/
+#define _PDCLIB_decimal_exp( decimal ) ( ( decimal )->digits > 0 ? ( decimal )->digits - 1 - ( decimal )->scale : 0 )
+
+/* Rounds a given decimal to the given number of leading digits, to nearest,
+   ties to even. A count of zero or less rounds to the power of ten above the
+   most significant digit (giving either that power of ten or zero).
+   Returns NULL, leaving the decimal unchanged, if it is inexact and either
+   too close to a tie to decide, or keep leaves unreliable digits.
+*/
+_PDCLIB_LOCAL _PDCLIB_decimal_t * _PDCLIB_decimal_round( _PDCLIB_decimal_t * decimal, long keep );
+
+/* Writes count digit characters of a given decimal to the given buffer,
+   starting with the digit at the given index (0 being the most significant
+   digit). Indices outside of 0 .. digits - 1 give '0'.
+*/
+_PDCLIB_LOCAL void _PDCLIB_decimal_tostring( _PDCLIB_decimal_t const * _PDCLIB_restrict decimal, long index, long count, char * _PDCLIB_restrict buffer );
+
+/* Returns the number of significant digits of a given decimal, i.e. digits
+   without trailing zeroes.
+*/
+_PDCLIB_LOCAL long _PDCLIB_decimal_sig( _PDCLIB_decimal_t const * decimal );
+
+/* Writes the shortest decimal representation of a floating point number that
+   identifies it uniquely among those of the same type to the given buffer
+   of n characters, without terminating it (see _PDCLIB_dtoa()). Exponent,
+   decimal, mantissa, and mantissa digits as for _PDCLIB_decimal_fp(), with
+   exp INT_MIN for NaN and INT_MAX for infinity; min_exp is the exponent of
+   the smallest normalized value. Tries _PDCLIB_grisu_shortest() first if
+   the mantissa is small enough.
+   Returns the number of characters written, zero if they would exceed n.
+*/
+_PDCLIB_LOCAL _PDCLIB_size_t _PDCLIB_fptoa( char * s, _PDCLIB_size_t n, int sign, int exp, int dec, unsigned char const * mant, _PDCLIB_size_t mant_dig, int min_exp );
+
+/* -------------------------------------------------------------------------- */
+/* _PDCLIB_diyfp_t support (Grisu fast paths for decimal conversions)         */
+/* -------------------------------------------------------------------------- */
+
+/* The cost of the exact _PDCLIB_decimal_t arithmetic grows with the magnitude
+   of the exponent. Values with a mantissa of no more than
+   _PDCLIB_DIYFP_MANT_DIG digits (i.e. double) are first converted with
+   Grisu (Florian Loitsch, "Printing Floating-Point Numbers Quickly and
+   Accurately with Integers", 2010): the value is scaled by a 64-bit
+   approximation of a power of ten, and digits are generated from the scaled
+   value, keeping track of the error. In the rare cases where the error
+   leaves the result undecided, the decimal engine is used as fallback.
+*/
+
+/* Mantissa digits handled by the fast paths; the remaining bits of the
+   64-bit f are needed for the error bounds.
+*/
+#define _PDCLIB_DIYFP_MANT_DIG 53
+
+/* Range of binary exponents of scaled values (see _PDCLIB_diyfp_pow10()) */
+#define _PDCLIB_DIYFP_ALPHA -60
+#define _PDCLIB_DIYFP_GAMMA -32
+
+/* Value is f * 2^e */
+typedef struct
+{
+    _PDCLIB_uint_least64_t f;
+    int e;
+} _PDCLIB_diyfp_t;
+
+/* Sets a diyfp to the value of a floating point number (exponent, decimal,
+   mantissa, and mantissa digits as for _PDCLIB_decimal_fp(), with mant_dig
+   at most _PDCLIB_DIYFP_MANT_DIG), with f the integer mantissa.
+*/
+_PDCLIB_LOCAL _PDCLIB_diyfp_t * _PDCLIB_diyfp_fp( _PDCLIB_diyfp_t * diyfp, int exp, int dec, unsigned char const * mant, _PDCLIB_size_t mant_dig );
+
+/* Sets a diyfp to its product with another, rounded to 64 bits. */
+_PDCLIB_LOCAL _PDCLIB_diyfp_t * _PDCLIB_diyfp_mul( _PDCLIB_diyfp_t * diyfp, _PDCLIB_diyfp_t const * factor );
+
+/* Sets power to a cached approximation of 10^k (normalized, off by at most
+   half a unit of f), such that a normalized diyfp of exponent e multiplied
+   with it has an exponent in _PDCLIB_DIYFP_ALPHA .. _PDCLIB_DIYFP_GAMMA,
+   and stores k.
+   Returns NULL if e is out of the range of the cache.
+*/
+_PDCLIB_LOCAL _PDCLIB_diyfp_t * _PDCLIB_diyfp_pow10( _PDCLIB_diyfp_t * power, int e, int * k );
+
+/* Writes the shortest digits identifying a floating point number (as for
+   _PDCLIB_fptoa()), given as a nonzero diyfp from _PDCLIB_diyfp_fp(), to
+   the given buffer of at least _PDCLIB_DBL_DECIMAL_DIG characters, and
+   stores the decimal exponent of the first digit in x. Asymmetric is
+   nonzero if the mantissa is a power of two above the subnormal range
+   (with the lower neighbour closer than the upper one).
+   Returns the number of digits written, zero if undecided.
+*/
+_PDCLIB_LOCAL int _PDCLIB_grisu_shortest( _PDCLIB_diyfp_t const * v, int asymmetric, char * digits, long * x );
+
+/* Writes the first count digits of a floating point number, rounded to
+   nearest, given as a nonzero diyfp from _PDCLIB_diyfp_fp(), to the given
+   buffer, and stores the decimal exponent of the first digit in x (after
+   rounding). Count is 1 .. _PDCLIB_DBL_DECIMAL_DIG.
+   Returns zero if the error of the approximation leaves the digits or the
+   rounding undecided (which includes all ties), nonzero otherwise.
+*/
+_PDCLIB_LOCAL int _PDCLIB_grisu_counted( _PDCLIB_diyfp_t const * v, int count, char * digits, long * x );
+
 /* -------------------------------------------------------------------------- */
 /* Sanity checks                                                              */
 /* -------------------------------------------------------------------------- */
@@ -19,17 +19,16 @@
    i - pointer to number of characters already delivered in this call
    n - pointer to maximum number of characters to be delivered in this call
    s - the buffer into which the character shall be delivered
+   Streams are written through _PDCLIB_print_span(), which expects the
+   stream to be locked and prepared for writing by the caller.
 */
 #define PUT( x ) \
     do { \
-        int character = x; \
-        if ( status->i < status->n ) { \
-            if ( status->stream != NULL ) \
-                putc( character, status->stream ); \
-            else \
-                status->s[status->i] = character; \
-        } \
-        ++(status->i); \
+        char character = x; \
+        if ( status->stream != NULL ) \
+            _PDCLIB_print_span( &character, 1, status ); \
+        else if ( status->i++ < status->n ) \
+            status->s[status->i - 1] = character; \
     } while ( 0 )
 
 
@@ -60,9 +59,30 @@
 #define E_generic  (INT32_C(1)<<20)
 #define E_hexa     (INT32_C(1)<<21)
 
+#define E_widtharg (INT32_C(1)<<22)
+#define E_precarg  (INT32_C(1)<<23)
+
 #define E_lower    (INT32_C(1)<<16)
 #define E_unsigned (INT32_C(1)<<17)
 
+/* Delivers the n characters at s (_PDCLIB_print_span()), or n copies of c
+   (_PDCLIB_print_fill()), the same way as PUT() but as a single run.
+*/
+void _PDCLIB_print_span( const char * s, size_t n, struct _PDCLIB_status_t * status );
+void _PDCLIB_print_fill( char c, size_t n, struct _PDCLIB_status_t * status );
+
+/* Parses the conversion specifier pointed to by spec (at the introducing '%')
+   into op. Does not check for invalid flag combinations.
+   Returns a pointer to the first character not parsed as conversion
+   specifier, which is spec itself if it is not a valid one.
+*/
+const char * _PDCLIB_print_parse( const char * spec, struct _PDCLIB_printop_t * op );
+
+/* Does the output for a conversion specifier parsed by _PDCLIB_print_parse(),
+   taking its values from the argument stack in status (see _PDCLIB_print()).
+*/
+void _PDCLIB_print_conversion( const struct _PDCLIB_printop_t * op, struct _PDCLIB_status_t * status );
+
 void _PDCLIB_print_integer( struct _PDCLIB_imaxdiv_t div, struct _PDCLIB_status_t * status );
 void _PDCLIB_print_string( const char * s, struct _PDCLIB_status_t * status );
 void _PDCLIB_print_double( double value, struct _PDCLIB_status_t * status );
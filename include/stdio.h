@@ -151,8 +151,18 @@ _PDCLIB_PUBLIC int fflush( FILE * stream );
 
    If the mode string begins with but is longer than one of the above sequences
    the implementation is at liberty to ignore the additional characters, or do
-   implementation-defined things. This implementation only accepts the exact
-   modes above.
+   implementation-defined things. This implementation accepts the modes above,
+   optionally followed by any of these (each at most once), and nothing else:
+   'm' - read-only streams: map the file into memory instead of reading it
+         through a buffer, if possible.
+   'p' - read-only streams: read the next block in a background thread while
+         the current one is consumed, if possible.
+   'd' - write-only streams: write full buffers in a background thread, if
+         possible. Write errors are reported on later writes, or fflush() /
+         fclose().
+   'u' - "r" and "w" streams: bypass the system's cache (direct
+         I/O), if possible. Takes precedence over 'm', 'p' and 'd'.
+   Where not applicable, these are ignored.
 
    Returns a pointer to the stream handle if successfull, NULL otherwise.
 */
@@ -790,6 +800,147 @@ _PDCLIB_PUBLIC int ferror( FILE * stream );
 */
 _PDCLIB_PUBLIC void perror( const char * s );
 
+/* POSIX extensions */
+
+#if ( _POSIX_C_SOURCE + 0 ) >= 199506L
+
+/* Lock the given stream for exclusive use by the calling thread, waiting for
+   any other thread holding the lock to release it. Locks are recursive; each
+   call of flockfile() (and each successful call of ftrylockfile()) must be
+   matched by a call of funlockfile(). All other stream functions acquire the
+   same lock, so a sequence of calls made while holding it is not interleaved
+   with calls made by other threads.
+*/
+_PDCLIB_PUBLIC void flockfile( FILE * stream );
+
+/* As flockfile(), but do not wait if the stream is locked by another thread.
+   Returns zero if the lock was acquired, nonzero otherwise.
+*/
+_PDCLIB_PUBLIC int ftrylockfile( FILE * stream );
+
+/* Release a lock acquired by flockfile() or ftrylockfile(). */
+_PDCLIB_PUBLIC void funlockfile( FILE * stream );
+
+/* Equivalent to getc( stream ), getchar(), putc( c, stream ) and
+   putchar( c ), respectively, except that the stream is not locked. These
+   are only safe to use if the calling thread holds the lock for the stream
+   (see flockfile()), or if the stream is not used by other threads.
+   This implementation provides them as macros, operating on the stream
+   buffer directly where possible; these may evaluate stream more than once.
+*/
+_PDCLIB_PUBLIC int getc_unlocked( FILE * stream );
+_PDCLIB_PUBLIC int getchar_unlocked( void );
+_PDCLIB_PUBLIC int putc_unlocked( int c, FILE * stream );
+_PDCLIB_PUBLIC int putchar_unlocked( int c );
+
+/* Equivalent to fread() and fwrite(), respectively, except that the stream
+   is not locked (see getc_unlocked()). These are not specified by POSIX, but
+   are a common extension.
+*/
+_PDCLIB_PUBLIC size_t fread_unlocked( void * _PDCLIB_restrict ptr, size_t size, size_t nmemb, FILE * _PDCLIB_restrict stream );
+_PDCLIB_PUBLIC size_t fwrite_unlocked( const void * _PDCLIB_restrict ptr, size_t size, size_t nmemb, FILE * _PDCLIB_restrict stream );
+
+/* Read from the buffer if it holds characters, and nothing has been pushed
+   back by ungetc().
+*/
+#define getc_unlocked( stream ) \
+    ( ( ( stream )->bufidx < ( stream )->bufend && ( stream )->ungetidx == 0 && \
+        !( ( stream )->status & ( _PDCLIB_ERRORFLAG | _PDCLIB_EOFFLAG | _PDCLIB_WIDESTREAM ) ) ) \
+      ? ( unsigned char )( stream )->buffer[ ( stream )->bufidx++ ] \
+      : ( getc_unlocked )( stream ) )
+
+/* Write to the buffer if the stream is a fully buffered byte output stream,
+   and the character does not fill the buffer (which would require a flush).
+*/
+#define putc_unlocked( c, stream ) \
+    ( ( ( ( stream )->status & ( _PDCLIB_FREAD | _PDCLIB_FWRITE | _PDCLIB_BYTESTREAM | _PDCLIB_WIDESTREAM | _PDCLIB_ERRORFLAG | _PDCLIB_EOFFLAG | _IOLBF | _IONBF ) ) == ( _PDCLIB_FWRITE | _PDCLIB_BYTESTREAM ) && \
+        ( stream )->bufidx + 1 < ( stream )->bufsize && ( stream )->ungetidx == 0 ) \
+      ? ( unsigned char )( ( stream )->buffer[ ( stream )->bufidx++ ] = ( char )( c ) ) \
+      : ( putc_unlocked )( ( c ), ( stream ) ) )
+
+#define getchar_unlocked() getc_unlocked( stdin )
+#define putchar_unlocked( c ) putc_unlocked( ( c ), stdout )
+
+#if ( _POSIX_C_SOURCE + 0 ) >= 200809L
+
+#ifndef _PDCLIB_SSIZE_T_DEFINED
+#define _PDCLIB_SSIZE_T_DEFINED _PDCLIB_SSIZE_T_DEFINED
+typedef _PDCLIB_ptrdiff_t ssize_t;
+#endif
+
+/* Read characters from the given stream up to and including the given
+   delimiter (converted to unsigned char), or end-of-file, into the buffer
+   pointed to by *lineptr, and zero-terminate them. The buffer, of size *n,
+   must have been allocated by malloc() (or *lineptr be NULL); it is
+   enlarged with realloc() as required, with *lineptr and *n updated
+   accordingly. The buffer is the caller's to free() in any case.
+   Returns the number of characters read (including the delimiter, but not
+   the terminating zero), or -1 on error / end-of-file before any character
+   was read. Sets errno to EINVAL if lineptr or n is NULL, to ENOMEM if the
+   buffer could not be enlarged, and to EOVERFLOW if the number of
+   characters would exceed the range of ssize_t.
+*/
+_PDCLIB_PUBLIC ssize_t getdelim( char ** _PDCLIB_restrict lineptr, size_t * _PDCLIB_restrict n, int delimiter, FILE * _PDCLIB_restrict stream );
+
+/* Equivalent to getdelim( lineptr, n, '\n', stream ). */
+_PDCLIB_PUBLIC ssize_t getline( char ** _PDCLIB_restrict lineptr, size_t * _PDCLIB_restrict n, FILE * _PDCLIB_restrict stream );
+
+/* Cookie stream I/O functions, see fopencookie(). */
+typedef ssize_t cookie_read_function_t( void * cookie, char * buf, size_t size );
+typedef ssize_t cookie_write_function_t( void * cookie, const char * buf, size_t size );
+typedef int cookie_seek_function_t( void * cookie, _PDCLIB_int_least64_t * offset, int whence );
+typedef int cookie_close_function_t( void * cookie );
+
+typedef struct _PDCLIB_cookie_io_functions_t cookie_io_functions_t;
+
+/* Open a stream doing its I/O through the given functions instead of a file,
+   in the given mode (as for fopen(); "m", "p", "d" and "u" are ignored). Each
+   of the functions is passed the given cookie as first argument:
+   - read( cookie, buf, size ) reads up to size characters into buf, and
+     returns the number of characters read, zero on end-of-file, or -1 on
+     error. If NULL, reading gives end-of-file.
+   - write( cookie, buf, size ) writes up to size characters from buf, and
+     returns the number of characters written, or zero on error. If NULL,
+     output is discarded.
+   - seek( cookie, offset, whence ) repositions to *offset relative to whence
+     (as for fseek()), stores the resulting position in *offset, and returns
+     zero on success, -1 on error. If NULL, repositioning fails with ESPIPE.
+   - close( cookie ) is called on fclose(), and returns zero on success, EOF
+     on error. May be NULL.
+   The functions are to set errno on error. The stream is fully buffered.
+   This is not specified by POSIX, but a common extension.
+   Returns a pointer to the stream, or NULL (with errno set to EINVAL for an
+   invalid mode, ENOMEM if memory could not be allocated).
+*/
+_PDCLIB_PUBLIC FILE * fopencookie( void * _PDCLIB_restrict cookie, const char * _PDCLIB_restrict mode, cookie_io_functions_t io_funcs );
+
+/* Open a stream associated with the given memory buffer of size characters
+   instead of a file, in the given mode (as for fopen(); "m", "p", "d" and "u"
+   are ignored). If buf is a NULL pointer, a buffer of size zero-initialized
+   characters is allocated, and freed on fclose(). The file contents are
+   the whole buffer for mode "r", empty for mode "w", and the buffer up to
+   the first zero character for mode "a" (which writes at the end of the
+   contents only). Writes beyond the buffer fail with ENOSPC. After writing,
+   a zero character is put behind the contents if there is room for it.
+   Returns a pointer to the stream, or NULL (with errno set to EINVAL for
+   size zero or an invalid mode, ENOMEM if memory could not be allocated).
+*/
+_PDCLIB_PUBLIC FILE * fmemopen( void * _PDCLIB_restrict buf, size_t size, const char * _PDCLIB_restrict mode );
+
+/* Open a stream for writing to a dynamically allocated buffer, which grows
+   as required. After each fflush() and fclose(), *bufp points to the buffer
+   (holding the contents written so far, zero-terminated), and *sizep is the
+   smaller of the size of the contents and the current file position. The
+   buffer is the caller's to free() after fclose().
+   Returns a pointer to the stream, or NULL (with errno set to EINVAL if
+   bufp or sizep is NULL, ENOMEM if memory could not be allocated).
+*/
+_PDCLIB_PUBLIC FILE * open_memstream( char ** bufp, size_t * sizep );
+
+#endif
+
+#endif
+
 /* Annex K -- Bounds-checking interfaces */
 
 #if ( __STDC_WANT_LIB_EXT1__ + 0 ) != 0
@@ -867,8 +1018,18 @@ _PDCLIB_PUBLIC errno_t tmpfile_s( FILE * _PDCLIB_restrict * _PDCLIB_restrict str
 
    If the mode string begins with but is longer than one of the above sequences
    the implementation is at liberty to ignore the additional characters, or do
-   implementation-defined things. This implementation only accepts the exact
-   modes above.
+   implementation-defined things. This implementation accepts the modes above,
+   optionally followed by any of these (each at most once), and nothing else:
+   'm' - read-only streams: map the file into memory instead of reading it
+         through a buffer, if possible.
+   'p' - read-only streams: read the next block in a background thread while
+         the current one is consumed, if possible.
+   'd' - write-only streams: write full buffers in a background thread, if
+         possible. Write errors are reported on later writes, or fflush() /
+         fclose().
+   'u' - "r" and "w" streams: bypass the system's cache (direct
+         I/O), if possible. Takes precedence over 'm', 'p' and 'd'.
+   Where not applicable, these are ignored.
 
    The following conditions will be considered runtime constraint violations:
    - streamptr being NULL.
@@ -921,6 +1082,53 @@ _PDCLIB_PUBLIC char * gets_s( char * s, rsize_t n );
 
 #endif
 
+/* PDCLib extensions: Precompiled format strings. */
+
+/* Parses the given printf() format string once, into a form that the
+   functions below can use repeatedly without parsing it again. The format
+   string is not referenced afterwards.
+   Returns a pointer to the compiled format, to be released by
+   _PDCLIB_freeformat(), or NULL (with errno set to EINVAL if the format
+   string holds an invalid conversion specifier, ENOMEM if memory could not
+   be allocated).
+*/
+_PDCLIB_PUBLIC struct _PDCLIB_format_t * _PDCLIB_compileformat( const char * format );
+
+/* Releases a format compiled by _PDCLIB_compileformat(). If format is a NULL
+   pointer, no action occurs.
+*/
+_PDCLIB_PUBLIC void _PDCLIB_freeformat( struct _PDCLIB_format_t * format );
+
+/* Equivalent to fprintf(), vfprintf(), snprintf() and vsnprintf(),
+   respectively, except that the format is one compiled by
+   _PDCLIB_compileformat() instead of a format string.
+*/
+_PDCLIB_PUBLIC int _PDCLIB_fprintf_format( FILE * _PDCLIB_restrict stream, const struct _PDCLIB_format_t * _PDCLIB_restrict format, ... );
+_PDCLIB_PUBLIC int _PDCLIB_vfprintf_format( FILE * _PDCLIB_restrict stream, const struct _PDCLIB_format_t * _PDCLIB_restrict format, _PDCLIB_va_list arg );
+_PDCLIB_PUBLIC int _PDCLIB_snprintf_format( char * _PDCLIB_restrict s, size_t n, const struct _PDCLIB_format_t * _PDCLIB_restrict format, ... );
+_PDCLIB_PUBLIC int _PDCLIB_vsnprintf_format( char * _PDCLIB_restrict s, size_t n, const struct _PDCLIB_format_t * _PDCLIB_restrict format, _PDCLIB_va_list arg );
+
+#ifdef _PDCLIB_STREAMSTATS
+
+/* PDCLib extensions, available if stream statistics are enabled (see
+   _PDCLIB_STREAMSTATS in _PDCLIB_config.h).
+*/
+
+/* Stores the I/O statistics of the given stream in *stats. If stream is a NULL
+   pointer, the statistics of all streams of the process (including those
+   closed already) are summed up instead.
+   Returns zero.
+*/
+_PDCLIB_PUBLIC int _PDCLIB_streamstats( FILE * stream, struct _PDCLIB_streamstats_t * stats );
+
+/* Writes the I/O statistics of all open streams, followed by the totals for
+   the process, to the given stream in human-readable form.
+   Returns zero if successful, EOF if a write error occurred.
+*/
+_PDCLIB_PUBLIC int _PDCLIB_dumpstreamstats( FILE * stream );
+
+#endif
+
 /* Extension hook for downstream projects that want to have non-standard
    extensions to standard headers.
 */
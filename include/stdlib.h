@@ -26,8 +26,25 @@ typedef _PDCLIB_size_t size_t;
 
 /* Numeric conversion functions */
 
-/* TODO: atof(), strtof(), strtod(), strtold() */
-
+/* Separate the character array nptr into three parts: A (possibly empty)
+   sequence of whitespace characters, a character representation of a floating
+   point number, and trailing invalid characters (including the terminating
+   null character). The representation is a decimal (with optional exponent
+   introduced by 'e' / 'E') or hexadecimal (starting with 0x / 0X, with
+   optional binary exponent introduced by 'p' / 'P') number, "INF" or
+   "INFINITY", or "NAN" optionally followed by "(...)", with an optional
+   leading '+' or '-' sign, and ignoring case.
+   The representation is converted, correctly rounded, into the return type
+   of the function. If endptr is not a NULL pointer, a pointer to the first
+   trailing invalid character is returned in *endptr.
+   If no conversion could be performed, zero is returned (and nptr in *endptr,
+   if endptr is not a NULL pointer). If the converted value is too large for
+   the return type, the functions return (signed) infinity; if it is too small
+   to be represented exactly (as a normalized value), the rounded value is
+   returned. In both cases, errno is set to ERANGE.
+   atof( nptr ) is equivalent to strtod( nptr, NULL ), save for not
+   necessarily setting errno.
+*/
 _PDCLIB_PUBLIC double atof( const char * nptr );
 _PDCLIB_PUBLIC double strtod( const char * _PDCLIB_restrict nptr, char ** _PDCLIB_restrict endptr );
 _PDCLIB_PUBLIC float strtof( const char * _PDCLIB_restrict nptr, char ** _PDCLIB_restrict endptr );
@@ -365,6 +382,37 @@ _PDCLIB_PUBLIC errno_t qsort_s( void * base, rsize_t nmemb, rsize_t size, int (
 
 #endif
 
+/* PDCLib extensions */
+
+/* Floating point to string conversion, for serialization.
+   Writes the shortest decimal representation that converts back (e.g. with
+   strtod()) to exactly the given value to the character array pointed to by
+   s, which has room for n characters. If several representations of that
+   length exist, the one closest to the value is written.
+   The representation uses fixed notation ("123.45", "0.001") or scientific
+   notation ("1e+22", "1.5e-07"), whichever is shorter, fixed notation if
+   they are of equal length. It is not affected by the current locale, and
+   not terminated by a null character. Infinity gives "inf", NaN gives "nan",
+   both signed like other values ("-inf", "-0").
+   Returns the number of characters written; zero if the representation does
+   not fit into n characters, in which case the contents of the array are
+   unchanged.
+   _PDCLIB_DTOA_CHARS and _PDCLIB_LDTOA_CHARS are sufficient for n in any
+   case.
+   Doubles are converted with 64-bit integer arithmetic (Grisu), at a cost
+   independent of the exponent. The few values that leaves undecided, and
+   long doubles with a wider mantissa than double, take exact multi-precision
+   arithmetic, which is an order of magnitude slower for values of large
+   magnitude, and two orders of magnitude slower for values close to the
+   smallest subnormal.
+*/
+_PDCLIB_PUBLIC size_t _PDCLIB_dtoa( char * s, size_t n, double value );
+_PDCLIB_PUBLIC size_t _PDCLIB_ldtoa( char * s, size_t n, long double value );
+
+/* Sign, digits, decimal point, "e", exponent sign, exponent digits. */
+#define _PDCLIB_DTOA_CHARS ( _PDCLIB_DBL_DECIMAL_DIG + 7 )
+#define _PDCLIB_LDTOA_CHARS ( _PDCLIB_LDBL_DECIMAL_DIG + 8 )
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,59 @@
+/* _PDCLIB_bufsize( _PDCLIB_fd_t )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+/* This is an example implementation of _PDCLIB_bufsize() fit for use with
+   POSIX kernels.
+*/
+
+#include <stdio.h>
+#include <limits.h>
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_glue.h"
+#include "pdclib/_PDCLIB_defguard.h"
+
+#include "sys/stat.h"
+
+_PDCLIB_size_t _PDCLIB_bufsize( _PDCLIB_fd_t fd )
+{
+    struct stat st;
+    _PDCLIB_size_t size;
+
+    if ( fstat( fd, &st ) != 0 || ! S_ISREG( st.st_mode ) )
+    {
+        /* Pipes, terminals, sockets etc. deliver / accept data in small
+           amounts, a large buffer would just waste memory.
+        */
+        return BUFSIZ;
+    }
+
+    /* Regular file. Use a multiple of the file system's preferred I/O
+       block size, but no less than _PDCLIB_FILE_BUFSIZ.
+    */
+    size = ( st.st_blksize > 0 ) ? ( _PDCLIB_size_t )st.st_blksize : BUFSIZ;
+
+    while ( size < _PDCLIB_FILE_BUFSIZ && size <= ( INT_MAX >> 1 ) )
+    {
+        size <<= 1;
+    }
+
+    return ( size > INT_MAX ) ? BUFSIZ : size;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+    /* Testing covered by _PDCLIB_allocbuffer.c */
+    return TEST_RESULTS;
+}
+
+#endif
@@ -0,0 +1,64 @@
+/* _PDCLIB_endasync( struct _PDCLIB_file_t * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifndef REGTEST
+
+#ifndef __STDC_NO_THREADS__
+
+#include <threads.h>
+
+#include "pdclib/_PDCLIB_glue.h"
+
+void _PDCLIB_endasync( struct _PDCLIB_file_t * stream )
+{
+    struct _PDCLIB_async_t * async = stream->async;
+
+    if ( async == NULL )
+    {
+        return;
+    }
+
+    mtx_lock( &async->mtx );
+
+    /* A request in progress has to be completed, as the worker would
+       overwrite the state otherwise.
+    */
+    while ( async->state == _PDCLIB_ASYNC_REQUESTED )
+    {
+        cnd_wait( &async->cnd, &async->mtx );
+    }
+
+    async->state = _PDCLIB_ASYNC_QUIT;
+    cnd_broadcast( &async->cnd );
+    mtx_unlock( &async->mtx );
+
+    thrd_join( async->thread, NULL );
+
+    cnd_destroy( &async->cnd );
+    mtx_destroy( &async->mtx );
+    free( async->buffer );
+    free( async );
+    stream->async = NULL;
+}
+
+#endif
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+    /* Testing covered by _PDCLIB_readahead.c */
+    return TEST_RESULTS;
+}
+
+#endif
@@ -22,6 +22,7 @@ extern "C" {
 
 typedef long ssize_t;
 extern ssize_t read( int fd, void * buf, size_t count );
+extern ssize_t pread64( int fd, void * buf, size_t count, _PDCLIB_int_least64_t offset );
 
 #ifdef __cplusplus
 }
@@ -29,8 +30,113 @@ extern ssize_t read( int fd, void * buf, size_t count );
 
 int _PDCLIB_fillbuffer( struct _PDCLIB_file_t * stream )
 {
+    ssize_t rc;
+
+    _PDCLIB_STATS_ADD( stream, fills, 1 );
+
+    if ( stream->status & _PDCLIB_FMMAP )
+    {
+        /* Memory-mapped stream (see _PDCLIB_mapfile()); the buffer holds
+           the whole file already. Move the window to the current position.
+        */
+        if ( stream->pos.offset >= stream->bufsize )
+        {
+            /* End-of-File */
+            stream->status |= _PDCLIB_EOFFLAG;
+            return EOF;
+        }
+
+        _PDCLIB_STATS_ADD( stream, bytes_read, stream->bufsize - stream->pos.offset );
+        stream->bufidx = stream->pos.offset;
+        stream->bufend = stream->bufsize;
+        stream->pos.offset = stream->bufsize;
+        return 0;
+    }
+
+#ifndef __STDC_NO_THREADS__
+
+    if ( stream->status & _PDCLIB_FAHEAD )
+    {
+        /* Read-ahead stream; buffer is filled by worker thread. */
+        return _PDCLIB_readahead( stream );
+    }
+
+#endif
+
+    if ( stream->status & _PDCLIB_FCOOKIE )
+    {
+        /* Cookie stream (see fopencookie()); flags already set on error. */
+        if ( ( rc = ( ssize_t )_PDCLIB_cookieread( stream, stream->buffer, stream->bufsize ) ) == 0 )
+        {
+            return EOF;
+        }
+
+        _PDCLIB_STATS_ADD( stream, bytes_read, rc );
+        stream->bufend = rc;
+        stream->bufidx = 0;
+        return 0;
+    }
+
+    if ( ( stream->status & _PDCLIB_FDIRECT ) && ( ( ( _PDCLIB_uintptr_t )stream->buffer | stream->bufsize ) & ( _PDCLIB_DIRECT_ALIGN - 1 ) ) )
+    {
+        /* Buffer provided by setvbuf() not fit for direct I/O */
+        _PDCLIB_nodirect( stream );
+    }
+
+    if ( stream->status & _PDCLIB_FDIRECT )
+    {
+        /* Direct I/O requires an aligned file offset, so the block holding
+           the current position is read, and the part before it skipped.
+           Reads are positioned, with pos the authoritative position.
+        */
+        _PDCLIB_size_t skip = stream->pos.offset & ( _PDCLIB_DIRECT_ALIGN - 1 );
+
+        _PDCLIB_STATS_START( stream );
+        rc = pread64( stream->handle, stream->buffer, stream->bufsize, stream->pos.offset - skip );
+        _PDCLIB_STATS_STOP( stream );
+
+        if ( rc > ( ssize_t )skip )
+        {
+            /* Reading successful. */
+            if ( !( stream->status & _PDCLIB_FBIN ) )
+            {
+                /* TODO: Text stream conversion here */
+            }
+
+            _PDCLIB_STATS_ADD( stream, bytes_read, rc );
+            stream->pos.offset += rc - skip;
+            stream->bufend = rc;
+            stream->bufidx = skip;
+            return 0;
+        }
+
+        if ( rc < 0 && errno == EINVAL )
+        {
+            /* Alignment not accepted by the file system after all. */
+            _PDCLIB_nodirect( stream );
+            return _PDCLIB_fillbuffer( stream );
+        }
+
+        if ( rc < 0 )
+        {
+            /* The 1:1 mapping done in _PDCLIB_config.h ensures
+               this works.
+            */
+            *_PDCLIB_errno_func() = errno;
+            /* Flag the stream */
+            stream->status |= _PDCLIB_ERRORFLAG;
+            return EOF;
+        }
+
+        /* End-of-File */
+        stream->status |= _PDCLIB_EOFFLAG;
+        return EOF;
+    }
+
     /* No need to handle buffers > INT_MAX, as PDCLib doesn't allow them */
-    ssize_t rc = read( stream->handle, stream->buffer, stream->bufsize );
+    _PDCLIB_STATS_START( stream );
+    rc = read( stream->handle, stream->buffer, stream->bufsize );
+    _PDCLIB_STATS_STOP( stream );
 
     if ( rc > 0 )
     {
@@ -40,6 +146,7 @@ int _PDCLIB_fillbuffer( struct _PDCLIB_file_t * stream )
             /* TODO: Text stream conversion here */
         }
 
+        _PDCLIB_STATS_ADD( stream, bytes_read, rc );
         stream->pos.offset += rc;
         stream->bufend = rc;
         stream->bufidx = 0;
@@ -68,9 +175,88 @@ int _PDCLIB_fillbuffer( struct _PDCLIB_file_t * stream )
 
 #include "_PDCLIB_test.h"
 
+#include <string.h>
+
 int main( void )
 {
-    /* Testing covered by ftell.c */
+#ifndef REGTEST
+    /* Memory-mapped streams; regular buffered reading is covered by
+       ftell.c.
+    */
+    FILE * fh;
+    char buffer[ 50 ];
+    int i;
+    TESTCASE( ( fh = fopen( testfile, "wb" ) ) != NULL );
+    TESTCASE( fputs( "abcdef\nghi\n", fh ) >= 0 );
+    TESTCASE( fclose( fh ) == 0 );
+    TESTCASE( ( fh = fopen( testfile, "rbm" ) ) != NULL );
+    TESTCASE( fh->status & _PDCLIB_FMMAP );
+    TESTCASE( fgetc( fh ) == 'a' );
+    TESTCASE( fh->status & _PDCLIB_FMMAP );
+    TESTCASE( fh->bufsize == 11 );
+    TESTCASE( ! ( fh->status & _PDCLIB_FREEBUFFER ) );
+    TESTCASE( ftell( fh ) == 1 );
+    TESTCASE( fgets( buffer, 50, fh ) == buffer );
+    TESTCASE( strcmp( buffer, "bcdef\n" ) == 0 );
+    TESTCASE( ftell( fh ) == 7 );
+    TESTCASE( fseek( fh, -2, SEEK_END ) == 0 );
+    TESTCASE( ftell( fh ) == 9 );
+    TESTCASE( fgetc( fh ) == 'i' );
+    TESTCASE( fseek( fh, -6, SEEK_CUR ) == 0 );
+    TESTCASE( fread( buffer, 1, 5, fh ) == 5 );
+    TESTCASE( memcmp( buffer, "ef\ngh", 5 ) == 0 );
+    TESTCASE( ungetc( 'x', fh ) == 'x' );
+    TESTCASE( fgetc( fh ) == 'x' );
+    TESTCASE( fseek( fh, 20, SEEK_SET ) == 0 );
+    TESTCASE( fgetc( fh ) == EOF );
+    TESTCASE( feof( fh ) );
+    TESTCASE( fseek( fh, -1, SEEK_SET ) != 0 );
+    TESTCASE( fclose( fh ) == 0 );
+    /* Empty files cannot be mapped, regular buffering is used */
+    TESTCASE( ( fh = fopen( testfile, "wb" ) ) != NULL );
+    TESTCASE( fclose( fh ) == 0 );
+    TESTCASE( ( fh = fopen( testfile, "rm" ) ) != NULL );
+    TESTCASE( fgetc( fh ) == EOF );
+    TESTCASE( ! ( fh->status & _PDCLIB_FMMAP ) );
+    TESTCASE( fclose( fh ) == 0 );
+    /* Direct I/O; writing full (aligned) buffers, and a tail */
+    TESTCASE( ( fh = fopen( testfile, "wbu" ) ) != NULL );
+    TESTCASE( fh->status & _PDCLIB_FDIRECT );
+
+    for ( i = 0; i < 70000; ++i )
+    {
+        TESTCASE_NOREG( fputc( i % 251, fh ) == i % 251 );
+    }
+
+    TESTCASE( ( ( _PDCLIB_uintptr_t )fh->buffer & ( _PDCLIB_DIRECT_ALIGN - 1 ) ) == 0 );
+    TESTCASE( ( fh->bufsize & ( _PDCLIB_DIRECT_ALIGN - 1 ) ) == 0 );
+    TESTCASE( fclose( fh ) == 0 );
+    /* Reading, from unaligned positions as well */
+    TESTCASE( ( fh = fopen( testfile, "rbu" ) ) != NULL );
+    TESTCASE( fh->status & _PDCLIB_FDIRECT );
+    TESTCASE( fgetc( fh ) == 0 );
+    TESTCASE( fh->status & _PDCLIB_FDIRECT );
+    TESTCASE( fseek( fh, 69990, SEEK_SET ) == 0 );
+    TESTCASE( fgetc( fh ) == 69990 % 251 );
+    TESTCASE( ftell( fh ) == 69991 );
+    TESTCASE( fseek( fh, -64000, SEEK_CUR ) == 0 );
+    TESTCASE( ftell( fh ) == 5991 );
+    TESTCASE( fread( buffer, 1, 50, fh ) == 50 );
+    TESTCASE( ( unsigned char )buffer[ 0 ] == 5991 % 251 );
+    TESTCASE( ( unsigned char )buffer[ 49 ] == 6040 % 251 );
+    TESTCASE( fseek( fh, 65530, SEEK_SET ) == 0 );
+
+    for ( i = 65530; i < 70000; ++i )
+    {
+        TESTCASE_NOREG( fgetc( fh ) == i % 251 );
+    }
+
+    TESTCASE( fgetc( fh ) == EOF );
+    TESTCASE( feof( fh ) );
+    TESTCASE( ftell( fh ) == 70000 );
+    TESTCASE( fclose( fh ) == 0 );
+    TESTCASE( remove( testfile ) == 0 );
+#endif
     return TEST_RESULTS;
 }
 
@@ -28,13 +28,6 @@ extern ssize_t write( int fd, const void * buf, size_t count );
 }
 #endif
 
-/* The number of attempts of output buffer flushing before giving up.         */
-#define _PDCLIB_IO_RETRIES 1
-
-/* What the system should do after an I/O operation did not succeed, before   */
-/* trying again. (Empty by default.)                                          */
-#define _PDCLIB_IO_RETRY_OP( stream )
-
 int _PDCLIB_flushbuffer( struct _PDCLIB_file_t * stream )
 {
     /* No need to handle buffers > INT_MAX, as PDCLib doesn't allow them */
@@ -42,17 +35,67 @@ int _PDCLIB_flushbuffer( struct _PDCLIB_file_t * stream )
     int rc;
     unsigned int retries;
 
+    _PDCLIB_STATS_ADD( stream, flushes, 1 );
+
+#ifndef __STDC_NO_THREADS__
+
+    if ( stream->status & _PDCLIB_FBEHIND )
+    {
+        if ( stream->status & _IOFBF )
+        {
+            /* Write-behind stream; buffer is written by worker thread. */
+            return _PDCLIB_writebehind( stream );
+        }
+
+        /* Line buffered / unbuffered streams are written directly (as
+           partial flushes keep using the buffer), but after anything
+           handed over before.
+        */
+        if ( _PDCLIB_waitasync( stream ) == EOF )
+        {
+            return EOF;
+        }
+    }
+
+#endif
+
     if ( !( stream->status & _PDCLIB_FBIN ) )
     {
         /* TODO: Text stream conversion here */
     }
 
+    if ( stream->status & _PDCLIB_FCOOKIE )
+    {
+        /* Cookie stream (see fopencookie()); flags already set on error.
+           As there is no telling whether the write function would succeed
+           later (e.g. a full fmemopen() buffer will not), unwritten remains
+           are discarded.
+        */
+        written = _PDCLIB_cookiewrite( stream, stream->buffer, stream->bufidx );
+        _PDCLIB_STATS_ADD( stream, bytes_written, written );
+        rc = ( written < stream->bufidx ) ? EOF : 0;
+        stream->bufidx = 0;
+        return rc;
+    }
+
+    if ( ( stream->status & _PDCLIB_FDIRECT ) && ( ( ( _PDCLIB_uintptr_t )stream->buffer | stream->pos.offset | stream->bufidx ) & ( _PDCLIB_DIRECT_ALIGN - 1 ) ) )
+    {
+        /* Direct I/O requires aligned memory, offset and size. A full
+           buffer allocated by the library meets that; a partial one (e.g.
+           the tail of the file on fclose()) is written through the system's
+           cache, as are writes after it.
+        */
+        _PDCLIB_nodirect( stream );
+    }
+
     /* Keep trying to write data until everything is written, an error
        occurs, or the configured number of retries is exceeded.
     */
     for ( retries = _PDCLIB_IO_RETRIES; retries > 0; --retries )
     {
+        _PDCLIB_STATS_START( stream );
         rc = ( int )write( stream->handle, stream->buffer + written, stream->bufidx - written );
+        _PDCLIB_STATS_STOP( stream );
 
         if ( rc < 0 )
         {
@@ -68,6 +111,7 @@ int _PDCLIB_flushbuffer( struct _PDCLIB_file_t * stream )
             return EOF;
         }
 
+        _PDCLIB_STATS_ADD( stream, bytes_written, rc );
         written += ( _PDCLIB_size_t )rc;
         stream->pos.offset += rc;
 
@@ -0,0 +1,69 @@
+/* _PDCLIB_futex_wait( int volatile *, int )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+/* This is an example implementation of _PDCLIB_futex_wait() fit for use with
+   Linux kernels. On other POSIX kernels, it falls back to yielding the CPU,
+   turning the stream lock into a spinlock under contention.
+*/
+
+#include <stdio.h>
+
+#ifndef REGTEST
+
+#ifndef __STDC_NO_THREADS__
+
+#include "pdclib/_PDCLIB_glue.h"
+#include "pdclib/_PDCLIB_defguard.h"
+
+#ifdef __linux__
+#include "sys/syscall.h"
+#include "linux/futex.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef __linux__
+extern long syscall( long number, ... );
+#else
+extern int sched_yield( void );
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+void _PDCLIB_futex_wait( int volatile * addr, int val )
+{
+#ifdef __linux__
+    /* Returns immediately (EAGAIN) if *addr no longer equals val, or on
+       EINTR; either way, the caller re-checks the lock.
+    */
+    syscall( SYS_futex, addr, FUTEX_WAIT_PRIVATE, val, NULL, NULL, 0 );
+#else
+    if ( *addr == val )
+    {
+        sched_yield();
+    }
+#endif
+}
+
+#endif
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+    /* Testing covered by _PDCLIB_flock_wait.c */
+    return TEST_RESULTS;
+}
+
+#endif
@@ -0,0 +1,59 @@
+/* _PDCLIB_futex_wake( int volatile * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+/* This is an example implementation of _PDCLIB_futex_wake() fit for use with
+   Linux kernels. On other POSIX kernels, _PDCLIB_futex_wait() does not sleep,
+   so there is nobody to wake.
+*/
+
+#include <stdio.h>
+
+#ifndef REGTEST
+
+#ifndef __STDC_NO_THREADS__
+
+#include "pdclib/_PDCLIB_glue.h"
+#include "pdclib/_PDCLIB_defguard.h"
+
+#ifdef __linux__
+#include "sys/syscall.h"
+#include "linux/futex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern long syscall( long number, ... );
+
+#ifdef __cplusplus
+}
+#endif
+#endif
+
+void _PDCLIB_futex_wake( int volatile * addr )
+{
+#ifdef __linux__
+    syscall( SYS_futex, addr, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0 );
+#else
+    ( void )addr;
+#endif
+}
+
+#endif
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+    /* Testing covered by _PDCLIB_flock_wait.c */
+    return TEST_RESULTS;
+}
+
+#endif
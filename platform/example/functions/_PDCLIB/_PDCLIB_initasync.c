@@ -0,0 +1,87 @@
+/* _PDCLIB_initasync( struct _PDCLIB_file_t *, thrd_start_t )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifndef REGTEST
+
+#ifndef __STDC_NO_THREADS__
+
+#include <threads.h>
+
+#include "pdclib/_PDCLIB_glue.h"
+
+int _PDCLIB_initasync( struct _PDCLIB_file_t * stream, int ( *worker )( void * ) )
+{
+    struct _PDCLIB_async_t * async;
+
+    if ( ! ( stream->status & _PDCLIB_FREEBUFFER ) )
+    {
+        /* User-supplied buffer (setvbuf()), which cannot be swapped. */
+        return EOF;
+    }
+
+    if ( ( async = ( struct _PDCLIB_async_t * )malloc( sizeof( struct _PDCLIB_async_t ) ) ) == NULL )
+    {
+        return EOF;
+    }
+
+    if ( ( async->buffer = ( char * )malloc( stream->bufsize ) ) == NULL )
+    {
+        free( async );
+        return EOF;
+    }
+
+    if ( mtx_init( &async->mtx, mtx_plain ) != thrd_success )
+    {
+        free( async->buffer );
+        free( async );
+        return EOF;
+    }
+
+    if ( cnd_init( &async->cnd ) != thrd_success )
+    {
+        mtx_destroy( &async->mtx );
+        free( async->buffer );
+        free( async );
+        return EOF;
+    }
+
+    async->len = 0;
+    async->offset = 0;
+    async->state = _PDCLIB_ASYNC_IDLE;
+    async->error = 0;
+    stream->async = async;
+
+    if ( thrd_create( &async->thread, worker, stream ) != thrd_success )
+    {
+        stream->async = NULL;
+        cnd_destroy( &async->cnd );
+        mtx_destroy( &async->mtx );
+        free( async->buffer );
+        free( async );
+        return EOF;
+    }
+
+    return 0;
+}
+
+#endif
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+    /* Testing covered by _PDCLIB_readahead.c and _PDCLIB_writebehind.c */
+    return TEST_RESULTS;
+}
+
+#endif
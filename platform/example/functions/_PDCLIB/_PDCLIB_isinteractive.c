@@ -0,0 +1,65 @@
+/* _PDCLIB_isinteractive( _PDCLIB_fd_t )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+/* This is an example implementation of _PDCLIB_isinteractive() fit for use
+   with POSIX kernels.
+*/
+
+#include <stdio.h>
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_glue.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern int isatty( int fd );
+
+#ifdef __cplusplus
+}
+#endif
+
+int _PDCLIB_isinteractive( _PDCLIB_fd_t fd )
+{
+    /* Terminals are interactive, everything else (regular files, pipes,
+       sockets, ...) is not. The errno set by isatty() for non-terminals
+       is of no interest to the caller.
+    */
+    int errno_save = *_PDCLIB_errno_func();
+    int rc = isatty( fd );
+    *_PDCLIB_errno_func() = errno_save;
+    return rc;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+#ifndef REGTEST
+    FILE * fh;
+    TESTCASE( ( fh = tmpfile() ) != NULL );
+    TESTCASE( _PDCLIB_isinteractive( fh->handle ) == 0 );
+    TESTCASE( fclose( fh ) == 0 );
+    /* Regular files are fully buffered */
+    TESTCASE( ( fh = fopen( testfile, "w" ) ) != NULL );
+    TESTCASE( ( fh->status & ( _IOFBF | _IONBF | _IOLBF ) ) == _IOFBF );
+    TESTCASE( fclose( fh ) == 0 );
+    TESTCASE( remove( testfile ) == 0 );
+    /* Standard streams are resolved on first use */
+    TESTCASE( ( stderr->status & ( _IOFBF | _IONBF | _IOLBF ) ) == _IONBF );
+    TESTCASE( fputs( "", stdout ) >= 0 );
+    TESTCASE( ( stdout->status & ( _IOFBF | _IONBF | _IOLBF ) ) == ( _PDCLIB_isinteractive( 1 ) ? _IOLBF : _IOFBF ) );
+#endif
+    return TEST_RESULTS;
+}
+
+#endif
@@ -0,0 +1,68 @@
+/* _PDCLIB_mapfile( struct _PDCLIB_file_t * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+/* This is an example implementation of _PDCLIB_mapfile() fit for use with
+   POSIX kernels.
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_glue.h"
+#include "pdclib/_PDCLIB_defguard.h"
+
+#include "sys/mman.h"
+#include "sys/stat.h"
+
+int _PDCLIB_mapfile( struct _PDCLIB_file_t * stream )
+{
+    struct stat st;
+    void * map;
+
+    if ( fstat( stream->handle, &st ) != 0 || ! S_ISREG( st.st_mode ) )
+    {
+        /* Only regular files can be mapped. */
+        return EOF;
+    }
+
+    if ( st.st_size <= 0 || ( _PDCLIB_uintmax_t )st.st_size > SIZE_MAX )
+    {
+        /* Empty files cannot be mapped; huge ones do not fit. */
+        return EOF;
+    }
+
+    map = mmap( NULL, ( _PDCLIB_size_t )st.st_size, PROT_READ, MAP_PRIVATE, stream->handle, 0 );
+
+    if ( map == MAP_FAILED )
+    {
+        return EOF;
+    }
+
+    /* The whole mapping is the buffer; _PDCLIB_fillbuffer() will set the
+       window at the current position.
+    */
+    stream->buffer = ( char * )map;
+    stream->bufsize = ( _PDCLIB_size_t )st.st_size;
+    stream->bufidx = 0;
+    stream->bufend = 0;
+    return 0;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+    /* Testing covered by _PDCLIB_fillbuffer.c */
+    return TEST_RESULTS;
+}
+
+#endif
@@ -0,0 +1,67 @@
+/* _PDCLIB_nanotime( void )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+/* This is an example implementation of _PDCLIB_nanotime() fit for use with
+   POSIX kernels.
+*/
+
+#include <stdio.h>
+
+#ifndef REGTEST
+
+#ifdef _PDCLIB_STREAMSTATS
+
+#include "pdclib/_PDCLIB_glue.h"
+
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* PDCLib's struct timespec is laid out like the kernel's. */
+extern int clock_gettime( int clockid, struct timespec * tp );
+
+#ifdef __cplusplus
+}
+#endif
+
+/* Value used by Linux */
+#define CLOCK_MONOTONIC 1
+
+_PDCLIB_uint_least64_t _PDCLIB_nanotime( void )
+{
+    struct timespec ts;
+
+    if ( clock_gettime( CLOCK_MONOTONIC, &ts ) != 0 )
+    {
+        return 0;
+    }
+
+    return ( _PDCLIB_uint_least64_t )ts.tv_sec * 1000000000u + ( _PDCLIB_uint_least64_t )ts.tv_nsec;
+}
+
+#endif
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+#ifndef REGTEST
+#ifdef _PDCLIB_STREAMSTATS
+    _PDCLIB_uint_least64_t t = _PDCLIB_nanotime();
+    TESTCASE( t != 0 );
+    TESTCASE( _PDCLIB_nanotime() >= t );
+#endif
+#endif
+    return TEST_RESULTS;
+}
+
+#endif
@@ -0,0 +1,58 @@
+/* _PDCLIB_nodirect( struct _PDCLIB_file_t * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+/* This is an example implementation of _PDCLIB_nodirect() fit for use with
+   POSIX kernels.
+*/
+
+/* For O_DIRECT */
+#define _GNU_SOURCE
+
+#include <stdio.h>
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_glue.h"
+
+#include "pdclib/_PDCLIB_defguard.h"
+#include "fcntl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern _PDCLIB_int_least64_t lseek64( int fd, _PDCLIB_int_least64_t offset, int whence );
+
+#ifdef __cplusplus
+}
+#endif
+
+void _PDCLIB_nodirect( struct _PDCLIB_file_t * stream )
+{
+    int flags = fcntl( stream->handle, F_GETFL );
+
+    if ( flags != -1 && ( flags & O_DIRECT ) )
+    {
+        fcntl( stream->handle, F_SETFL, flags & ~O_DIRECT );
+    }
+
+    lseek64( stream->handle, stream->pos.offset, SEEK_SET );
+    stream->status &= ~_PDCLIB_FDIRECT;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+    /* Testing covered by _PDCLIB_fillbuffer.c */
+    return TEST_RESULTS;
+}
+
+#endif
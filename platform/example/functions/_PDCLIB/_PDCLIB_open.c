@@ -8,6 +8,9 @@
    kernels.
 */
 
+/* For O_DIRECT */
+#define _GNU_SOURCE
+
 #include <stdio.h>
 
 #ifndef REGTEST
@@ -60,6 +63,11 @@ _PDCLIB_fd_t _PDCLIB_open( const char * const filename, unsigned int mode )
             return _PDCLIB_NOHANDLE;
     }
 
+    if ( mode & _PDCLIB_FDIRECT )
+    {
+        osmode |= O_DIRECT;
+    }
+
     if ( osmode & O_CREAT )
     {
         rc = open( filename, osmode, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH );
@@ -69,6 +77,14 @@ _PDCLIB_fd_t _PDCLIB_open( const char * const filename, unsigned int mode )
         rc = open( filename, osmode );
     }
 
+    if ( rc == _PDCLIB_NOHANDLE && errno == EINVAL && ( osmode & O_DIRECT ) )
+    {
+        /* File system does not support direct I/O; as the stream still
+           uses aligned transfers, nothing else changes.
+        */
+        return _PDCLIB_open( filename, mode & ~_PDCLIB_FDIRECT );
+    }
+
     if ( rc == _PDCLIB_NOHANDLE )
     {
         /* The 1:1 mapping in _PDCLIB_config.h ensures this works. */
@@ -0,0 +1,87 @@
+/* _PDCLIB_read( struct _PDCLIB_file_t *, char *, size_t )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+/* This is an example implementation of _PDCLIB_read() fit for use with
+   POSIX kernels.
+*/
+
+#include <stdio.h>
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_glue.h"
+
+#include "/usr/include/errno.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef long ssize_t;
+extern ssize_t read( int fd, void * buf, size_t count );
+
+#ifdef __cplusplus
+}
+#endif
+
+_PDCLIB_size_t _PDCLIB_read( struct _PDCLIB_file_t * stream, char * buffer, _PDCLIB_size_t size )
+{
+    ssize_t rc;
+
+    if ( stream->status & _PDCLIB_FCOOKIE )
+    {
+        /* Cookie stream (see fopencookie()) */
+        rc = ( ssize_t )_PDCLIB_cookieread( stream, buffer, size );
+        _PDCLIB_STATS_ADD( stream, bytes_read, rc );
+        return ( _PDCLIB_size_t )rc;
+    }
+
+    _PDCLIB_STATS_START( stream );
+    rc = read( stream->handle, buffer, size );
+    _PDCLIB_STATS_STOP( stream );
+
+    if ( rc > 0 )
+    {
+        /* Reading successful. */
+        if ( !( stream->status & _PDCLIB_FBIN ) )
+        {
+            /* TODO: Text stream conversion here */
+        }
+
+        _PDCLIB_STATS_ADD( stream, bytes_read, rc );
+        stream->pos.offset += rc;
+        return ( _PDCLIB_size_t )rc;
+    }
+
+    if ( rc < 0 )
+    {
+        /* The 1:1 mapping done in _PDCLIB_config.h ensures
+           this works.
+        */
+        *_PDCLIB_errno_func() = errno;
+        /* Flag the stream */
+        stream->status |= _PDCLIB_ERRORFLAG;
+        return 0;
+    }
+
+    /* End-of-File */
+    stream->status |= _PDCLIB_EOFFLAG;
+    return 0;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+    /* Testing covered by fread.c */
+    return TEST_RESULTS;
+}
+
+#endif
@@ -0,0 +1,263 @@
+/* _PDCLIB_readahead( struct _PDCLIB_file_t * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+/* This is an example implementation of _PDCLIB_readahead() fit for use with
+   POSIX kernels.
+*/
+
+#include <stdio.h>
+
+#ifndef REGTEST
+
+#ifndef __STDC_NO_THREADS__
+
+#include <threads.h>
+
+#include "pdclib/_PDCLIB_glue.h"
+#include "pdclib/_PDCLIB_defguard.h"
+
+#include "sys/stat.h"
+
+#include "/usr/include/errno.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef long ssize_t;
+extern ssize_t pread64( int fd, void * buf, size_t count, _PDCLIB_int_least64_t offset );
+
+#ifdef __cplusplus
+}
+#endif
+
+/* Worker thread, reading the requested block into the second buffer. */
+static int worker( void * arg )
+{
+    struct _PDCLIB_file_t * stream = ( struct _PDCLIB_file_t * )arg;
+    struct _PDCLIB_async_t * async = stream->async;
+
+    for ( ;; )
+    {
+        _PDCLIB_size_t len;
+        _PDCLIB_uint_least64_t offset;
+        ssize_t rc;
+
+        mtx_lock( &async->mtx );
+
+        while ( async->state != _PDCLIB_ASYNC_REQUESTED && async->state != _PDCLIB_ASYNC_QUIT )
+        {
+            cnd_wait( &async->cnd, &async->mtx );
+        }
+
+        if ( async->state == _PDCLIB_ASYNC_QUIT )
+        {
+            mtx_unlock( &async->mtx );
+            return 0;
+        }
+
+        len = async->len;
+        offset = async->offset;
+        mtx_unlock( &async->mtx );
+
+        /* The buffer is not touched by the stream while the request is
+           pending, so reading need not (and must not) hold the lock.
+        */
+        rc = pread64( stream->handle, async->buffer, len, offset );
+
+        mtx_lock( &async->mtx );
+
+        if ( rc < 0 )
+        {
+            async->error = errno;
+            async->len = 0;
+        }
+        else
+        {
+            async->error = 0;
+            async->len = ( _PDCLIB_size_t )rc;
+        }
+
+        async->state = _PDCLIB_ASYNC_DONE;
+        cnd_broadcast( &async->cnd );
+        mtx_unlock( &async->mtx );
+    }
+}
+
+/* Setting up second buffer and worker thread. Returns 0 on success, EOF if
+   the stream is not fit for read-ahead or resources are not available.
+*/
+static int setup( struct _PDCLIB_file_t * stream )
+{
+    struct stat st;
+
+    if ( fstat( stream->handle, &st ) != 0 || ! S_ISREG( st.st_mode ) )
+    {
+        /* Positioned reads require a regular file. */
+        return EOF;
+    }
+
+    return _PDCLIB_initasync( stream, worker );
+}
+
+/* Requesting the block at the current position. Lock must be held. */
+static void request( struct _PDCLIB_file_t * stream )
+{
+    struct _PDCLIB_async_t * async = stream->async;
+
+    async->offset = stream->pos.offset;
+    async->len = stream->bufsize;
+    async->state = _PDCLIB_ASYNC_REQUESTED;
+    cnd_broadcast( &async->cnd );
+}
+
+int _PDCLIB_readahead( struct _PDCLIB_file_t * stream )
+{
+    struct _PDCLIB_async_t * async = stream->async;
+    char * buffer;
+
+    if ( async == NULL )
+    {
+        if ( setup( stream ) != 0 )
+        {
+            /* Fall back to regular buffering. */
+            stream->status &= ~_PDCLIB_FAHEAD;
+            return _PDCLIB_fillbuffer( stream );
+        }
+
+        async = stream->async;
+    }
+
+    mtx_lock( &async->mtx );
+
+    if ( async->state == _PDCLIB_ASYNC_IDLE || async->offset != stream->pos.offset )
+    {
+        /* Nothing read ahead for the current position (first read, read
+           after EOF / error, or after a seek). Wait out a stale request,
+           and request the block needed now.
+        */
+        while ( async->state == _PDCLIB_ASYNC_REQUESTED )
+        {
+            cnd_wait( &async->cnd, &async->mtx );
+        }
+
+        request( stream );
+    }
+
+    _PDCLIB_STATS_START( stream );
+
+    while ( async->state == _PDCLIB_ASYNC_REQUESTED )
+    {
+        cnd_wait( &async->cnd, &async->mtx );
+    }
+
+    _PDCLIB_STATS_STOP( stream );
+
+    async->state = _PDCLIB_ASYNC_IDLE;
+
+    if ( async->error != 0 )
+    {
+        /* The 1:1 mapping done in _PDCLIB_config.h ensures
+           this works.
+        */
+        *_PDCLIB_errno_func() = async->error;
+        /* Flag the stream */
+        stream->status |= _PDCLIB_ERRORFLAG;
+        mtx_unlock( &async->mtx );
+        return EOF;
+    }
+
+    if ( async->len == 0 )
+    {
+        /* End-of-File */
+        stream->status |= _PDCLIB_EOFFLAG;
+        mtx_unlock( &async->mtx );
+        return EOF;
+    }
+
+    if ( !( stream->status & _PDCLIB_FBIN ) )
+    {
+        /* TODO: Text stream conversion here */
+    }
+
+    /* Swap buffers... */
+    buffer = stream->buffer;
+    stream->buffer = async->buffer;
+    async->buffer = buffer;
+    stream->bufidx = 0;
+    stream->bufend = async->len;
+    stream->pos.offset += async->len;
+    _PDCLIB_STATS_ADD( stream, bytes_read, async->len );
+
+    /* ...and have the next block read while this one is consumed. */
+    request( stream );
+
+    mtx_unlock( &async->mtx );
+    return 0;
+}
+
+#endif
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+#include <string.h>
+
+int main( void )
+{
+#if ! defined( REGTEST ) && ! defined( __STDC_NO_THREADS__ )
+    FILE * fh;
+    char buffer[ 100 ];
+    size_t i;
+    size_t length = strlen( teststring );
+    TESTCASE( ( fh = fopen( testfile, "wb" ) ) != NULL );
+    TESTCASE( fwrite( teststring, 1, length, fh ) == length );
+    TESTCASE( fclose( fh ) == 0 );
+    /* Small buffer, so that read-ahead is exercised repeatedly */
+    TESTCASE( ( fh = fopen( testfile, "rbp" ) ) != NULL );
+    TESTCASE( setvbuf( fh, NULL, _IOFBF, 16 ) == 0 );
+    TESTCASE( fh->async == NULL );
+
+    for ( i = 0; i < length; ++i )
+    {
+        TESTCASE( fgetc( fh ) == teststring[ i ] );
+    }
+
+    TESTCASE( fh->async != NULL );
+    TESTCASE( fh->status & _PDCLIB_FAHEAD );
+    TESTCASE( ftell( fh ) == ( long )length );
+    TESTCASE( fgetc( fh ) == EOF );
+    TESTCASE( feof( fh ) );
+    /* Seek back, read across buffer boundaries */
+    TESTCASE( fseek( fh, 5, SEEK_SET ) == 0 );
+    TESTCASE( fread( buffer, 1, 30, fh ) == 30 );
+    TESTCASE( memcmp( buffer, teststring + 5, 30 ) == 0 );
+    TESTCASE( ftell( fh ) == 35 );
+    TESTCASE( fseek( fh, -10, SEEK_CUR ) == 0 );
+    TESTCASE( fgetc( fh ) == teststring[ 25 ] );
+    TESTCASE( ungetc( 'x', fh ) == 'x' );
+    TESTCASE( fgetc( fh ) == 'x' );
+    TESTCASE( fgetc( fh ) == teststring[ 26 ] );
+    TESTCASE( fseek( fh, -3, SEEK_END ) == 0 );
+    TESTCASE( fread( buffer, 1, 10, fh ) == 3 );
+    TESTCASE( memcmp( buffer, teststring + length - 3, 3 ) == 0 );
+    TESTCASE( fclose( fh ) == 0 );
+    /* User-supplied buffer cannot be swapped, regular buffering is used */
+    TESTCASE( ( fh = fopen( testfile, "rp" ) ) != NULL );
+    TESTCASE( setvbuf( fh, buffer, _IOFBF, 20 ) == 0 );
+    TESTCASE( fgetc( fh ) == teststring[ 0 ] );
+    TESTCASE( fh->async == NULL );
+    TESTCASE( ! ( fh->status & _PDCLIB_FAHEAD ) );
+    TESTCASE( fclose( fh ) == 0 );
+    TESTCASE( remove( testfile ) == 0 );
+#endif
+    return TEST_RESULTS;
+}
+
+#endif
@@ -1,4 +1,4 @@
-/* _PDCLIB_realpath( const char * path )
+/* _PDCLIB_realpath( _PDCLIB_fd_t fd )
 
    This file is part of the Public Domain C Library (PDCLib).
    Permission is granted to use, modify, and / or redistribute at will.
@@ -9,6 +9,7 @@
 #include "pdclib/_PDCLIB_glue.h"
 
 #include <stddef.h>
+#include <stdio.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -20,8 +21,15 @@ extern char * realpath( const char * file_name, char * resolved_name );
 }
 #endif
 
-char * _PDCLIB_realpath( const char * path )
+/* This is an example implementation of _PDCLIB_realpath() fit for use with
+   kernels providing /proc/self/fd (Linux, Cygwin), where each file
+   descriptor is represented by a symbolic link to its file.
+*/
+
+char * _PDCLIB_realpath( _PDCLIB_fd_t fd )
 {
+    char path[ 32 ];
+    sprintf( path, "/proc/self/fd/%d", fd );
     return realpath( path, NULL );
 }
 
@@ -33,7 +41,7 @@ char * _PDCLIB_realpath( const char * path )
 
 int main( void )
 {
-    /* No test drivers. */
+    /* Testing covered by freopen.c */
     return TEST_RESULTS;
 }
 
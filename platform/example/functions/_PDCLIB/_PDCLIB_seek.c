@@ -46,11 +46,61 @@ _PDCLIB_int_least64_t _PDCLIB_seek( struct _PDCLIB_file_t * stream, _PDCLIB_int_
             break;
     }
 
+    _PDCLIB_STATS_ADD( stream, seeks, 1 );
+
+    if ( stream->status & _PDCLIB_FMMAP )
+    {
+        /* Memory-mapped stream; the file position is only kept in pos,
+           and moving it is all there is to do. _PDCLIB_fillbuffer() will
+           move the buffer window accordingly.
+        */
+        switch ( whence )
+        {
+            case SEEK_CUR:
+                offset += stream->pos.offset;
+                break;
+
+            case SEEK_END:
+                offset += stream->bufsize;
+                break;
+        }
+
+        if ( offset < 0 )
+        {
+            *_PDCLIB_errno_func() = _PDCLIB_EINVAL;
+            return EOF;
+        }
+
+        stream->ungetidx = 0;
+        stream->bufidx = 0;
+        stream->bufend = 0;
+        stream->pos.offset = offset;
+        return offset;
+    }
+
+    if ( stream->status & _PDCLIB_FCOOKIE )
+    {
+        /* Cookie stream (see fopencookie()) */
+        return _PDCLIB_cookieseek( stream, offset, whence );
+    }
+
+    if ( ( stream->status & ( _PDCLIB_FAHEAD | _PDCLIB_FDIRECT ) ) && whence == SEEK_CUR )
+    {
+        /* Read-ahead or direct I/O stream; reads are positioned and do not
+           move the file descriptor's offset, so pos is the authoritative
+           position.
+        */
+        offset += stream->pos.offset;
+        whence = SEEK_SET;
+    }
+
+    _PDCLIB_STATS_START( stream );
 #ifdef __CYGWIN__
     rc = lseek( stream->handle, offset, whence );
 #else
     rc = lseek64( stream->handle, offset, whence );
 #endif
+    _PDCLIB_STATS_STOP( stream );
 
     if ( rc != EOF )
     {
@@ -20,39 +20,60 @@
 /* In a POSIX system, stdin / stdout / stderr are equivalent to the (int) file
    descriptors 0, 1, and 2 respectively.
 */
+/* stdin and stdout get their buffer mode on first use (see
+   _PDCLIB_allocbuffer()), depending on whether they refer to an interactive
+   device. stderr is always unbuffered.
+*/
 /* TODO: This is proof-of-concept, requires finetuning. */
 static char _PDCLIB_sin_buffer[BUFSIZ];
 static char _PDCLIB_sout_buffer[BUFSIZ];
 static char _PDCLIB_serr_buffer[BUFSIZ];
 
-static struct _PDCLIB_file_t _PDCLIB_serr = { 2, _PDCLIB_serr_buffer, BUFSIZ, 0, 0, { 0, 0 }, 0, { 0 }, _IONBF | _PDCLIB_FWRITE,
+/* The standard streams are the initial list of open files. They are kept in
+   an array so that they can refer to each other (next / prev) in their
+   initializers.
+*/
+static struct _PDCLIB_file_t _PDCLIB_sstreams[ 3 ] =
+{
+    { 0, NULL, _PDCLIB_sin_buffer, BUFSIZ, 0, 0, { 0, 0 }, 0, { 0 }, _PDCLIB_FREAD,
 #ifndef __STDC_NO_THREADS__
-    _PDCLIB_MTX_RECURSIVE_INIT,
+      _PDCLIB_FLOCK_INIT, NULL,
 #endif
-    NULL, NULL
-};
-static struct _PDCLIB_file_t _PDCLIB_sout = { 1, _PDCLIB_sout_buffer, BUFSIZ, 0, 0, { 0, 0 }, 0, { 0 }, _IOLBF | _PDCLIB_FWRITE,
+      NULL, &_PDCLIB_sstreams[ 1 ], NULL, _PDCLIB_FILE_TAG, 0
+#ifdef _PDCLIB_STREAMSTATS
+      , { 0, 0, 0, 0, 0, 0, 0 }, 0
+#endif
+    },
+    { 1, NULL, _PDCLIB_sout_buffer, BUFSIZ, 0, 0, { 0, 0 }, 0, { 0 }, _PDCLIB_FWRITE,
 #ifndef __STDC_NO_THREADS__
-    _PDCLIB_MTX_RECURSIVE_INIT,
+      _PDCLIB_FLOCK_INIT, NULL,
 #endif
-    NULL, &_PDCLIB_serr
-};
-static struct _PDCLIB_file_t _PDCLIB_sin  = { 0, _PDCLIB_sin_buffer, BUFSIZ, 0, 0, { 0, 0 }, 0, { 0 }, _IOLBF | _PDCLIB_FREAD,
+      NULL, &_PDCLIB_sstreams[ 2 ], &_PDCLIB_sstreams[ 0 ], _PDCLIB_FILE_TAG, 0
+#ifdef _PDCLIB_STREAMSTATS
+      , { 0, 0, 0, 0, 0, 0, 0 }, 0
+#endif
+    },
+    { 2, NULL, _PDCLIB_serr_buffer, BUFSIZ, 0, 0, { 0, 0 }, 0, { 0 }, _IONBF | _PDCLIB_FWRITE,
 #ifndef __STDC_NO_THREADS__
-    _PDCLIB_MTX_RECURSIVE_INIT,
+      _PDCLIB_FLOCK_INIT, NULL,
 #endif
-    NULL, &_PDCLIB_sout
+      NULL, NULL, &_PDCLIB_sstreams[ 1 ], _PDCLIB_FILE_TAG, 0
+#ifdef _PDCLIB_STREAMSTATS
+      , { 0, 0, 0, 0, 0, 0, 0 }, 0
+#endif
+    }
 };
 
-struct _PDCLIB_file_t * stdin  = &_PDCLIB_sin;
-struct _PDCLIB_file_t * stdout = &_PDCLIB_sout;
-struct _PDCLIB_file_t * stderr = &_PDCLIB_serr;
+struct _PDCLIB_file_t * stdin  = &_PDCLIB_sstreams[ 0 ];
+struct _PDCLIB_file_t * stdout = &_PDCLIB_sstreams[ 1 ];
+struct _PDCLIB_file_t * stderr = &_PDCLIB_sstreams[ 2 ];
 
 /* FIXME: This approach is a possible attack vector. */
-struct _PDCLIB_file_t * _PDCLIB_filelist = &_PDCLIB_sin;
+struct _PDCLIB_file_t * _PDCLIB_filelist = &_PDCLIB_sstreams[ 0 ];
 
 #ifndef __STDC_NO_THREADS__
 _PDCLIB_mtx_t _PDCLIB_filelist_mtx = _PDCLIB_MTX_PLAIN_INIT;
+int _PDCLIB_threaded = 0;
 _PDCLIB_mtx_t _PDCLIB_time_mtx = _PDCLIB_MTX_PLAIN_INIT;
 #endif
 
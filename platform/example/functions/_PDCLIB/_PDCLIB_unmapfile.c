@@ -0,0 +1,41 @@
+/* _PDCLIB_unmapfile( struct _PDCLIB_file_t * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+/* This is an example implementation of _PDCLIB_unmapfile() fit for use with
+   POSIX kernels.
+*/
+
+#include <stdio.h>
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_glue.h"
+#include "pdclib/_PDCLIB_defguard.h"
+
+#include "sys/mman.h"
+
+void _PDCLIB_unmapfile( struct _PDCLIB_file_t * stream )
+{
+    if ( stream->buffer != NULL )
+    {
+        munmap( stream->buffer, stream->bufsize );
+        stream->buffer = NULL;
+    }
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+    /* Testing covered by _PDCLIB_fillbuffer.c */
+    return TEST_RESULTS;
+}
+
+#endif
@@ -0,0 +1,69 @@
+/* _PDCLIB_waitasync( struct _PDCLIB_file_t * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+#include <stdio.h>
+
+#ifndef REGTEST
+
+#ifndef __STDC_NO_THREADS__
+
+#include <threads.h>
+
+#include "pdclib/_PDCLIB_glue.h"
+
+int _PDCLIB_waitasync( struct _PDCLIB_file_t * stream )
+{
+    struct _PDCLIB_async_t * async = stream->async;
+    int rc = 0;
+
+    if ( async == NULL )
+    {
+        return 0;
+    }
+
+    mtx_lock( &async->mtx );
+
+    _PDCLIB_STATS_START( stream );
+
+    while ( async->state == _PDCLIB_ASYNC_REQUESTED )
+    {
+        cnd_wait( &async->cnd, &async->mtx );
+    }
+
+    _PDCLIB_STATS_STOP( stream );
+
+    if ( async->error != 0 )
+    {
+        /* The 1:1 mapping done in _PDCLIB_config.h ensures
+           this works.
+        */
+        *_PDCLIB_errno_func() = async->error;
+        /* Flag the stream */
+        stream->status |= _PDCLIB_ERRORFLAG;
+        /* Reported now, so not again */
+        async->error = 0;
+        rc = EOF;
+    }
+
+    mtx_unlock( &async->mtx );
+    return rc;
+}
+
+#endif
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+    /* Testing covered by _PDCLIB_writebehind.c */
+    return TEST_RESULTS;
+}
+
+#endif
@@ -0,0 +1,231 @@
+/* _PDCLIB_writebehind( struct _PDCLIB_file_t * )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+/* This is an example implementation of _PDCLIB_writebehind() fit for use
+   with POSIX kernels.
+*/
+
+#include <stdio.h>
+
+#ifndef REGTEST
+
+#ifndef __STDC_NO_THREADS__
+
+#include <threads.h>
+
+#include "pdclib/_PDCLIB_glue.h"
+
+#include "/usr/include/errno.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef long ssize_t;
+extern ssize_t write( int fd, const void * buf, size_t count );
+
+#ifdef __cplusplus
+}
+#endif
+
+/* Worker thread, writing the buffers handed over by the stream. */
+static int worker( void * arg )
+{
+    struct _PDCLIB_file_t * stream = ( struct _PDCLIB_file_t * )arg;
+    struct _PDCLIB_async_t * async = stream->async;
+
+    for ( ;; )
+    {
+        _PDCLIB_size_t len;
+        _PDCLIB_size_t written = 0;
+        int error = 0;
+        unsigned int retries;
+
+        mtx_lock( &async->mtx );
+
+        while ( async->state != _PDCLIB_ASYNC_REQUESTED && async->state != _PDCLIB_ASYNC_QUIT )
+        {
+            cnd_wait( &async->cnd, &async->mtx );
+        }
+
+        if ( async->state == _PDCLIB_ASYNC_QUIT )
+        {
+            mtx_unlock( &async->mtx );
+            return 0;
+        }
+
+        len = async->len;
+        mtx_unlock( &async->mtx );
+
+        /* The buffer is not touched by the stream while the request is
+           pending, so writing need not (and must not) hold the lock.
+           Keep trying to write data until everything is written, an error
+           occurs, or the configured number of retries is exceeded (as
+           _PDCLIB_flushbuffer() does).
+        */
+        for ( retries = _PDCLIB_IO_RETRIES; retries > 0 && written < len; --retries )
+        {
+            ssize_t rc = write( stream->handle, async->buffer + written, len - written );
+
+            if ( rc < 0 )
+            {
+                if ( errno == EINTR )
+                {
+                    /* Interrupted before writing anything; try again. */
+                    continue;
+                }
+
+                error = errno;
+                break;
+            }
+
+            if ( rc == 0 )
+            {
+                /* No progress, and no error reported; would not finish. */
+                error = EIO;
+                break;
+            }
+
+            written += ( _PDCLIB_size_t )rc;
+        }
+
+        if ( error == 0 && written < len )
+        {
+            /* Number of retries exceeded. */
+            error = EAGAIN;
+        }
+
+        mtx_lock( &async->mtx );
+
+        if ( error != 0 && async->error == 0 )
+        {
+            /* Deferred, until reported by _PDCLIB_waitasync() */
+            async->error = error;
+        }
+
+        async->state = _PDCLIB_ASYNC_DONE;
+        cnd_broadcast( &async->cnd );
+        mtx_unlock( &async->mtx );
+    }
+}
+
+int _PDCLIB_writebehind( struct _PDCLIB_file_t * stream )
+{
+    struct _PDCLIB_async_t * async = stream->async;
+    char * buffer;
+
+    if ( async == NULL )
+    {
+        if ( _PDCLIB_initasync( stream, worker ) != 0 )
+        {
+            /* Fall back to regular buffering. */
+            stream->status &= ~_PDCLIB_FBEHIND;
+            return _PDCLIB_flushbuffer( stream );
+        }
+
+        async = stream->async;
+    }
+
+    /* Waits for the previous buffer to be written, reporting any deferred
+       error.
+    */
+    if ( _PDCLIB_waitasync( stream ) == EOF )
+    {
+        return EOF;
+    }
+
+    if ( stream->bufidx == 0 )
+    {
+        /* Nothing to write. */
+        return 0;
+    }
+
+    if ( !( stream->status & _PDCLIB_FBIN ) )
+    {
+        /* TODO: Text stream conversion here */
+    }
+
+    mtx_lock( &async->mtx );
+
+    /* Hand the buffer over to the worker, and continue with the other. */
+    buffer = stream->buffer;
+    stream->buffer = async->buffer;
+    async->buffer = buffer;
+    async->len = stream->bufidx;
+    async->offset = stream->pos.offset;
+    async->state = _PDCLIB_ASYNC_REQUESTED;
+    cnd_broadcast( &async->cnd );
+
+    stream->pos.offset += stream->bufidx;
+    _PDCLIB_STATS_ADD( stream, bytes_written, stream->bufidx );
+    stream->bufidx = 0;
+
+    mtx_unlock( &async->mtx );
+    return 0;
+}
+
+#endif
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+#include <string.h>
+
+int main( void )
+{
+#if ! defined( REGTEST ) && ! defined( __STDC_NO_THREADS__ )
+    FILE * fh;
+    char buffer[ 100 ];
+    size_t i;
+    size_t length = strlen( teststring );
+    /* Small buffer, so that write-behind is exercised repeatedly */
+    TESTCASE( ( fh = fopen( testfile, "wbd" ) ) != NULL );
+    TESTCASE( setvbuf( fh, NULL, _IOFBF, 16 ) == 0 );
+
+    for ( i = 0; i < length; ++i )
+    {
+        TESTCASE( fputc( teststring[ i ], fh ) == teststring[ i ] );
+    }
+
+    TESTCASE( fh->async != NULL );
+    TESTCASE( fh->status & _PDCLIB_FBEHIND );
+    TESTCASE( fwrite( teststring, 1, 40, fh ) == 40 );
+    TESTCASE( fprintf( fh, "%s", teststring + 40 ) == ( int )length - 40 );
+    TESTCASE( ftell( fh ) == ( long )( 2 * length ) );
+    TESTCASE( fflush( fh ) == 0 );
+    TESTCASE( fh->async->state != _PDCLIB_ASYNC_REQUESTED );
+    TESTCASE( fclose( fh ) == 0 );
+    TESTCASE( ( fh = fopen( testfile, "rb" ) ) != NULL );
+
+    for ( i = 0; i < 2; ++i )
+    {
+        TESTCASE( fread( buffer, 1, length, fh ) == length );
+        TESTCASE( memcmp( buffer, teststring, length ) == 0 );
+    }
+
+    TESTCASE( fgetc( fh ) == EOF );
+    TESTCASE( fclose( fh ) == 0 );
+    TESTCASE( remove( testfile ) == 0 );
+    /* Deferred errors are reported by fflush() */
+    if ( ( fh = fopen( "/dev/full", "wd" ) ) != NULL )
+    {
+        TESTCASE( setvbuf( fh, NULL, _IOFBF, 16 ) == 0 );
+        TESTCASE( fwrite( teststring, 1, 16, fh ) == 16 );
+        TESTCASE( ! ferror( fh ) );
+        TESTCASE( fflush( fh ) == EOF );
+        TESTCASE( ferror( fh ) );
+        TESTCASE( *_PDCLIB_errno_func() == _PDCLIB_ENOSPC );
+        clearerr( fh );
+        TESTCASE( fclose( fh ) == 0 );
+    }
+#endif
+    return TEST_RESULTS;
+}
+
+#endif
@@ -0,0 +1,188 @@
+/* _PDCLIB_writev( struct _PDCLIB_file_t *, const struct _PDCLIB_iovec_t *, int )
+
+   This file is part of the Public Domain C Library (PDCLib).
+   Permission is granted to use, modify, and / or redistribute at will.
+*/
+
+/* This is an example implementation of _PDCLIB_writev() fit for use with
+   POSIX kernels.
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#ifndef REGTEST
+
+#include "pdclib/_PDCLIB_glue.h"
+
+#include "/usr/include/errno.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* struct _PDCLIB_iovec_t is laid out like struct iovec (see _PDCLIB_config.h) */
+typedef long ssize_t;
+extern ssize_t writev( int fd, const struct _PDCLIB_iovec_t * iov, int iovcnt );
+
+#ifdef __cplusplus
+}
+#endif
+
+_PDCLIB_size_t _PDCLIB_writev( struct _PDCLIB_file_t * stream, const struct _PDCLIB_iovec_t * iov, int iovcnt )
+{
+    /* Stream buffer plus the memory areas passed by the caller */
+    struct _PDCLIB_iovec_t vec[ _PDCLIB_IOV_MAX + 1 ];
+    /* Characters written from the caller's memory areas */
+    _PDCLIB_size_t written = 0;
+    /* Whether vec[ 0 ] refers to the stream buffer */
+    int buffered = 0;
+    int first = 0;
+    int count = 0;
+    unsigned int retries;
+
+    if ( !( stream->status & _PDCLIB_FBIN ) )
+    {
+        /* TODO: Text stream conversion here */
+    }
+
+    if ( stream->status & _PDCLIB_FCOOKIE )
+    {
+        /* Cookie stream (see fopencookie()); no gathered write available,
+           write buffer and memory areas one by one.
+        */
+        if ( _PDCLIB_flushbuffer( stream ) == EOF )
+        {
+            return 0;
+        }
+
+        while ( iovcnt-- > 0 )
+        {
+            _PDCLIB_size_t done = _PDCLIB_cookiewrite( stream, iov->base, iov->len );
+            _PDCLIB_STATS_ADD( stream, bytes_written, done );
+            written += done;
+
+            if ( done < iov->len )
+            {
+                /* Flags already set */
+                break;
+            }
+
+            ++iov;
+        }
+
+        return written;
+    }
+
+    if ( stream->bufidx > 0 )
+    {
+        vec[ count ].base = stream->buffer;
+        vec[ count ].len = stream->bufidx;
+        buffered = 1;
+        ++count;
+    }
+
+    while ( iovcnt-- > 0 )
+    {
+        vec[ count++ ] = *iov++;
+    }
+
+    if ( count == 0 )
+    {
+        /* Nothing to write. */
+        return 0;
+    }
+
+    /* Keep trying to write data until everything is written, an error
+       occurs, or the configured number of retries is exceeded.
+    */
+    for ( retries = _PDCLIB_IO_RETRIES; retries > 0; --retries )
+    {
+        ssize_t rc;
+        _PDCLIB_size_t done;
+
+        _PDCLIB_STATS_START( stream );
+        rc = writev( stream->handle, vec + first, count - first );
+        _PDCLIB_STATS_STOP( stream );
+
+        if ( rc < 0 )
+        {
+            /* The 1:1 mapping done in _PDCLIB_config.h ensures
+               this works.
+            */
+            *_PDCLIB_errno_func() = errno;
+            /* Flag the stream */
+            stream->status |= _PDCLIB_ERRORFLAG;
+            break;
+        }
+
+        _PDCLIB_STATS_ADD( stream, bytes_written, rc );
+        done = ( _PDCLIB_size_t )rc;
+        stream->pos.offset += rc;
+
+        /* Skip the memory areas written completely... */
+        while ( first < count && done >= vec[ first ].len )
+        {
+            done -= vec[ first ].len;
+
+            if ( first > 0 || ! buffered )
+            {
+                written += vec[ first ].len;
+            }
+
+            ++first;
+        }
+
+        if ( first == count )
+        {
+            /* Buffer and memory areas written completely. */
+            stream->bufidx = 0;
+            return written;
+        }
+
+        /* ...and adjust the one written partially. */
+        vec[ first ].base += done;
+        vec[ first ].len -= done;
+
+        if ( first > 0 || ! buffered )
+        {
+            written += done;
+        }
+
+        _PDCLIB_IO_RETRY_OP( stream );
+    }
+
+    if ( retries == 0 )
+    {
+        /* Number of retries exceeded. */
+        *_PDCLIB_errno_func() = _PDCLIB_EAGAIN;
+        stream->status |= _PDCLIB_ERRORFLAG;
+    }
+
+    if ( first == 0 && buffered )
+    {
+        /* Move unwritten remains to begin of buffer. */
+        stream->bufidx = vec[ 0 ].len;
+        memmove( stream->buffer, vec[ 0 ].base, stream->bufidx );
+    }
+    else
+    {
+        stream->bufidx = 0;
+    }
+
+    return written;
+}
+
+#endif
+
+#ifdef TEST
+
+#include "_PDCLIB_test.h"
+
+int main( void )
+{
+    /* Testing covered by fwrite.c */
+    return TEST_RESULTS;
+}
+
+#endif
@@ -24,8 +24,6 @@ extern mtx_t _PDCLIB_filelist_mtx;
 #include "fcntl.h"
 #include "unistd.h"
 
-extern struct _PDCLIB_file_t * _PDCLIB_filelist;
-
 /* This is an example implementation of tmpfile() fit for use with POSIX
    kernels.
 */
@@ -86,7 +84,8 @@ struct _PDCLIB_file_t * tmpfile( void )
         return NULL;
     }
 
-    rc->status |= _PDCLIB_filemode( "wb+" ) | _IOLBF | _PDCLIB_DELONCLOSE;
+    /* A temporary file is never an interactive device, so fully buffered. */
+    rc->status |= _PDCLIB_filemode( "wb+" ) | _IOFBF | _PDCLIB_DELONCLOSE;
     rc->handle = fd;
 
     /* Filename (for potential freopen()) */
@@ -94,8 +93,7 @@ struct _PDCLIB_file_t * tmpfile( void )
 
     /* Adding to list of open files */
     _PDCLIB_LOCK( _PDCLIB_filelist_mtx );
-    rc->next = _PDCLIB_filelist;
-    _PDCLIB_filelist = rc;
+    _PDCLIB_putstream( rc );
     _PDCLIB_UNLOCK( _PDCLIB_filelist_mtx );
     return rc;
 }
@@ -21,6 +21,9 @@ extern int pthread_create( thrd_t *, const _PDCLIB_thrd_attr_t *, thrd_start_t,
 
 int thrd_create( thrd_t * thr, thrd_start_t func, void * arg )
 {
+    /* From now on, streams need locking (see _PDCLIB_LOCKFILE()). */
+    _PDCLIB_threaded = 1;
+
     if ( pthread_create( thr, NULL, func, arg ) == 0 )
     {
         return thrd_success;
@@ -55,6 +58,8 @@ int main( void )
 {
 #ifndef REGTEST
 
+    TESTCASE( _PDCLIB_threaded == 0 );
+
     for ( unsigned i = 0; i < COUNT; ++i )
     {
         TESTCASE( thrd_create( &g_thread[i], func, NULL ) == thrd_success );
@@ -66,6 +71,7 @@ int main( void )
     }
 
     TESTCASE( g_count == COUNT );
+    TESTCASE( _PDCLIB_threaded != 0 );
 #endif
     return TEST_RESULTS;
 }
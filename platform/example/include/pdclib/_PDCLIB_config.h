@@ -587,14 +587,42 @@ typedef int _PDCLIB_fd_t;
 /* failed.                                                                    */
 #define _PDCLIB_NOHANDLE ( (_PDCLIB_fd_t) -1 )
 
+/* Description of a memory area to be written by _PDCLIB_writev(). The member */
+/* layout matches POSIX struct iovec, so the example implementation can pass  */
+/* an array of these to writev() as-is.                                       */
+struct _PDCLIB_iovec_t
+{
+    const char *   base; /* Start of memory area */
+    _PDCLIB_size_t len;  /* Size of memory area */
+};
+
+/* The maximum number of memory areas passed to _PDCLIB_writev() in a single  */
+/* call (not counting the stream buffer, which _PDCLIB_writev() adds itself). */
+#define _PDCLIB_IOV_MAX 4
+
 /* The default size for file buffers. Must be at least 256.                   */
 #define _PDCLIB_BUFSIZ 1024
 
+/* The minimum size for buffers of streams associated with regular files (as  */
+/* opposed to pipes, terminals etc.), see _PDCLIB_bufsize(). Larger buffers   */
+/* mean fewer system calls for bulk I/O. Must be at least _PDCLIB_BUFSIZ.     */
+#define _PDCLIB_FILE_BUFSIZ 65536
+
+/* The alignment of buffer memory, file offsets and transfer sizes for        */
+/* streams doing direct I/O (fopen() mode "u"), bypassing the system's cache. */
+/* Must be a power of two, and a multiple of the logical block size of the    */
+/* devices used. Data not fitting that alignment (e.g. the tail of a file     */
+/* being written) is transferred through the system's cache instead.          */
+#define _PDCLIB_DIRECT_ALIGN 4096
+
 /* The minimum number of files the implementation guarantees can opened       */
 /* simultaneously.  Must be at least 8. Depends largely on how the platform   */
 /* does the bookkeeping in whatever is called by _PDCLIB_open(). PDCLib puts  */
 /* no further limits on the number of open files other than available memory. */
-#define _PDCLIB_FOPEN_MAX 8
+/* On POSIX kernels, that is the file descriptor limit (RLIMIT_NOFILE),       */
+/* usually defaulting to 1024; the value given here leaves room for           */
+/* descriptors used otherwise.                                                */
+#define _PDCLIB_FOPEN_MAX 256
 
 /* Length of the longest filename the implementation guarantees to support.   */
 #define _PDCLIB_FILENAME_MAX 128
@@ -616,7 +644,25 @@ typedef int _PDCLIB_fd_t;
 /* The number of characters that can be buffered with ungetc(). The standard  */
 /* guarantees only one (1); PDCLib supports larger values, but applications   */
 /* relying on this would rely on implementation-defined behaviour (not good). */
-#define _PDCLIB_UNGETCBUFSIZE 1
+/* Pushing back the character last read from the stream buffer does not use   */
+/* this buffer (see _PDCLIB_ungetc_unlocked()), so it is only the fallback.   */
+#define _PDCLIB_UNGETCBUFSIZE 4
+
+/* The number of attempts of output buffer flushing before giving up.         */
+#define _PDCLIB_IO_RETRIES 1
+
+/* What the system should do after an I/O operation did not succeed, before   */
+/* trying again. (Empty by default.)                                          */
+#define _PDCLIB_IO_RETRY_OP( stream )
+
+/* Define this to have I/O statistics kept for each stream: characters        */
+/* read / written, buffer fills / flushes, seeks, lock contentions, and time  */
+/* spent in (or waiting for) system calls. They can be queried with           */
+/* _PDCLIB_streamstats() and printed with _PDCLIB_dumpstreamstats() (see      */
+/* <stdio.h>); if the environment variable PDCLIB_STREAMSTATS is set, they    */
+/* are printed to stderr on exit. If not defined, no code is generated for    */
+/* this.                                                                      */
+/* #define _PDCLIB_STREAMSTATS */
 
 /* The number of functions that can be registered with atexit(). Needs to be  */
 /* at least 33 (32 guaranteed by the standard, plus _PDCLIB_closeall() which  */
@@ -863,6 +909,15 @@ typedef int _PDCLIB_once_flag;
 /* This one is actually hidden in <limits.h>, and only if __USE_POSIX is      */
 /* defined prior to #include <limits.h> (PTHREAD_DESTRUCTOR_ITERATIONS).      */
 #define _PDCLIB_TSS_DTOR_ITERATIONS 4
+/* Atomic operations on int, used by the stream lock (_PDCLIB_FLOCK()).       */
+/* _PDCLIB_ATOMIC_CAS( p, o, n ) sets *p to n if it equals o, and returns     */
+/* nonzero if it did. _PDCLIB_ATOMIC_SWAP( p, v ) sets *p to v, and returns   */
+/* the previous value. Both need to be full memory barriers.                  */
+#define _PDCLIB_ATOMIC_CAS( p, o, n ) __sync_bool_compare_and_swap( p, o, n )
+#define _PDCLIB_ATOMIC_SWAP( p, v ) __atomic_exchange_n( p, v, __ATOMIC_SEQ_CST )
+/* Number of attempts at acquiring a contended stream lock before the thread  */
+/* goes to sleep (_PDCLIB_futex_wait()).                                      */
+#define _PDCLIB_FLOCK_SPINS 100
 /* The following are not made public in any header, but used internally for   */
 /* interfacing with the pthread API.                                          */
 typedef union { unsigned char _PDCLIB_cnd_attr_t_data[ 4 ]; int _PDCLIB_cnd_attr_t_align; } _PDCLIB_cnd_attr_t;
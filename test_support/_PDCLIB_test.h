@@ -30,6 +30,10 @@ static const char testfile2[] = "test_support/testfile2";
 static int TEST_RESULTS = 0;
 
 /* TESTCASE() - generic test */
+/* The test drivers return from main() into the host's startup code, which
+   does not flush PDCLib's stdout. As stdout is fully buffered when it does
+   not refer to a terminal, failures are flushed explicitly.
+*/
 #define TESTCASE( x ) \
     if ( x ) \
     { \
@@ -39,6 +43,7 @@ static int TEST_RESULTS = 0;
     { \
        TEST_RESULTS += 1; \
        printf( "FAILED: " __FILE__ ", line %d - %s\n", __LINE__, #x ); \
+       fflush( stdout ); \
     }
 
 /* TESTCASE_NOREG() - PDCLib-only test */
@@ -165,6 +165,66 @@
     PRINTF_TEST( 11, "0xf.ffffp-3", "%.4La", 1.999998L );
     PRINTF_TEST( 12, "0xf.fffefp-3", "%.5La", 1.999998L );
 #endif
+    /* Decimal, double */
+    PRINTF_TEST( 8, "0.000000", "%f", 0.0 );
+    PRINTF_TEST( 9, "-0.000000", "%f", -0.0 );
+    PRINTF_TEST( 8, "1.000000", "%f", 1.0 );
+    PRINTF_TEST( 11, "1234.567800", "%f", 1234.5678 );
+    PRINTF_TEST( 9, "-0.100000", "%f", -0.1 );
+    PRINTF_TEST( 21, "0.1000000000000000056", "%.19f", 0.1 );
+    PRINTF_TEST( 1, "2", "%.0f", 2.5 );
+    PRINTF_TEST( 1, "4", "%.0f", 3.5 );
+    PRINTF_TEST( 1, "0", "%.0f", 0.5 );
+    PRINTF_TEST( 2, "1.", "%#.0f", 0.5000001 );
+    PRINTF_TEST( 4, "0.12", "%.2f", 0.125 );
+    PRINTF_TEST( 4, "0.38", "%.2f", 0.375 );
+    PRINTF_TEST( 5, "10.00", "%.2f", 9.999 );
+    PRINTF_TEST( 3, "0.0", "%.1f", 0.0001 );
+    PRINTF_TEST( 8, "+3.14159", "%+.5f", 3.14159265 );
+    PRINTF_TEST( 6, " 3.142", "% .3f", 3.14159265 );
+    PRINTF_TEST( 10, "     3.142", "%10.3f", 3.14159265 );
+    PRINTF_TEST( 10, "-00003.142", "%010.3f", -3.14159265 );
+    PRINTF_TEST( 10, "3.142     ", "%-10.3f", 3.14159265 );
+    PRINTF_TEST( 23, "10000000000000000000000", "%.0f", 1e22 );
+    PRINTF_TEST( 12, "1.000000e+00", "%e", 1.0 );
+    PRINTF_TEST( 12, "0.000000e+00", "%e", 0.0 );
+    PRINTF_TEST( 12, "1.234568e+03", "%e", 1234.5678 );
+    PRINTF_TEST( 12, "1.000000E-01", "%E", 0.1 );
+    PRINTF_TEST( 5, "1e+01", "%.0e", 9.5 );
+    PRINTF_TEST( 6, "1.e+00", "%#.0e", 1.0 );
+    PRINTF_TEST( 10, "1.0000e+22", "%.4e", 1e22 );
+    PRINTF_TEST( 13, "1.797693e+308", "%e", DBL_MAX );
+    PRINTF_TEST( 13, "2.225074e-308", "%e", DBL_MIN );
+    PRINTF_TEST( 13, "4.940656e-324", "%e", 0x0.0000000000001p-1022 );
+    PRINTF_TEST( 26, "2.2250738585072013831e-308", "%.19e", DBL_MIN );
+    PRINTF_TEST( 15, "-0001.50000e+10", "%015.5e", -1.5e10 );
+    PRINTF_TEST( 1, "0", "%g", 0.0 );
+    PRINTF_TEST( 1, "1", "%g", 1.0 );
+    PRINTF_TEST( 3, "0.1", "%g", 0.1 );
+    PRINTF_TEST( 7, "1234.57", "%g", 1234.5678 );
+    PRINTF_TEST( 6, "100000", "%g", 100000.0 );
+    PRINTF_TEST( 5, "1e+06", "%g", 1000000.0 );
+    PRINTF_TEST( 6, "0.0001", "%g", 0.0001 );
+    PRINTF_TEST( 11, "1.23457e-05", "%g", 0.0000123456789 );
+    PRINTF_TEST( 5, "1E+06", "%G", 999999.5 );
+    PRINTF_TEST( 7, "1.00000", "%#g", 1.0 );
+    PRINTF_TEST( 5, "1e+01", "%.0g", 9.5 );
+    PRINTF_TEST( 19, "0.10000000000000001", "%.17g", 0.1 );
+    PRINTF_TEST( 23, "1.7976931348623157e+308", "%.17g", DBL_MAX );
+    PRINTF_TEST( 10, "      0.25", "%10g", 0.25 );
+    PRINTF_TEST( 10, "0.25      ", "%-10g", 0.25 );
+    /* Decimal, long double */
+    PRINTF_TEST( 8, "0.000000", "%Lf", 0.0L );
+    PRINTF_TEST( 11, "1234.567800", "%Lf", 1234.5678L );
+    PRINTF_TEST( 12, "1.000000e-01", "%Le", 0.1L );
+    PRINTF_TEST( 3, "0.1", "%Lg", 0.1L );
+    PRINTF_TEST( 4, "-2.5", "%Lg", -2.5L );
+#if LDBL_MANT_DIG == 64
+    PRINTF_TEST( 22, "0.10000000000000000000", "%.20Lf", 0.1L );
+    PRINTF_TEST( 23, "0.100000000000000000001", "%.21Lf", 0.1L );
+    PRINTF_TEST( 14, "1.189731e+4932", "%Le", LDBL_MAX );
+    PRINTF_TEST( 14, "3.645200e-4951", "%Le", 0x1p-16445L );
+#endif
 
 /******************************************************************************
  * NOTE: The following test cases are imported from the Tyndur project. They  *